@@ -0,0 +1,120 @@
+/**
+ * @brief   Moteur d'alarmes (voir alarmes.h)
+ * @file    alarmes.cpp
+ * @author  cgil
+   @version	1.0
+ * @date    avril 2026
+ */
+
+#include "alarmes.h"
+
+
+void Alarmes::begin() {
+    pinMode(PIN_SEMAPHORE_ROUGE, OUTPUT);
+    pinMode(PIN_SEMAPHORE_JAUNE, OUTPUT);
+    pinMode(PIN_SEMAPHORE_VERT, OUTPUT);
+    piloterSemaphore(NIVEAU_AUCUN);
+}
+
+
+void Alarmes::piloterSemaphore(NiveauAlarme niveau) {
+    uint64_t valeur = niveau == NIVEAU_CRITIQUE ? BIT_GPIO(PIN_SEMAPHORE_ROUGE)
+                    : niveau == NIVEAU_AVERTISSEMENT ? BIT_GPIO(PIN_SEMAPHORE_JAUNE)
+                    : BIT_GPIO(PIN_SEMAPHORE_VERT);
+    Sorties::ecrire(MASQUE_SEMAPHORE, valeur);
+}
+
+
+bool Alarmes::evaluerRegle(int i, int v, time_t date) {
+    const Regle& r = REGLES[i];
+    EtatRegle& e = _etats[i];
+
+    switch (r.type) {
+    case REGLE_SEUIL_HAUT:
+        return e.active ? v > r.seuil - r.hysteresis : v > r.seuil;
+
+    case REGLE_SEUIL_BAS:
+        return e.active ? v < r.seuil + r.hysteresis : v < r.seuil;
+
+    case REGLE_PENTE: {
+        if (!e.init) {
+            e.valRef = e.valCand = v;
+            e.dateRef = e.dateCand = date;
+            e.init = true;
+            return false;
+        }
+        // La candidate devient la reference quand elle a l'age voulu
+        if (date - e.dateCand >= (time_t)r.dureeS) {
+            e.valRef = e.valCand; e.dateRef = e.dateCand;
+            e.valCand = v;        e.dateCand = date;
+        }
+        long dt = (long)(date - e.dateRef);
+        if (dt < (long)r.dureeS || dt <= 0) return e.active;     //! pas encore de recul
+        long pente = labs((long)(v - e.valRef)) * 60 / dt;
+        return e.active ? pente > r.seuil - r.hysteresis : pente > r.seuil;
+    }
+
+    case REGLE_FIGE:
+        if (!e.init || v != e.valRef) {
+            e.valRef = v;
+            e.dateRef = date;
+            e.init = true;
+            return false;
+        }
+        return date - e.dateRef >= (time_t)r.dureeS;
+    }
+    return false;
+}
+
+
+int Alarmes::evaluer(const LigneMesure& ligne, EvenementAlarme evts[NB_REGLES]) {
+    int nb = 0;
+    NiveauAlarme niveau = NIVEAU_AUCUN;
+
+    for (int i = 0; i < NB_REGLES; i++) {
+        int v = ligne.valeurs[REGLES[i].canal];
+        bool active = evaluerRegle(i, v, ligne.date);
+        if (active != _etats[i].active) {
+            _etats[i].active = active;
+            if (active) _etats[i].nbDeclenchements++;
+            evts[nb++] = { (uint8_t)i, active, v, ligne.date, (uint32_t)micros() };
+        }
+        if (active && REGLES[i].niveau > niveau) niveau = REGLES[i].niveau;
+    }
+
+    if (nb) {
+        _voyant = (niveau != NIVEAU_AUCUN);
+        if (niveau != _niveau) piloterSemaphore(niveau);
+        _niveau = niveau;
+    }
+    return nb;
+}
+
+
+void Alarmes::noterPush(const EvenementAlarme& e, bool ok) {
+    uint32_t latence = (uint32_t)micros() - e.detectionUs;
+    if (!ok) { _nbEchecsPush = _nbEchecsPush + 1; return; }
+    _nbPush = _nbPush + 1;
+    _derniereLatenceUs = latence;
+    if (latence > _maxLatenceUs) _maxLatenceUs = latence;
+}
+
+
+const char* Alarmes::nomType(TypeRegle t) {
+    switch (t) {
+    case REGLE_SEUIL_HAUT: return "seuil_haut";
+    case REGLE_SEUIL_BAS:  return "seuil_bas";
+    case REGLE_PENTE:      return "pente";
+    case REGLE_FIGE:       return "fige";
+    }
+    return "?";
+}
+
+const char* Alarmes::nomNiveau(NiveauAlarme n) {
+    switch (n) {
+    case NIVEAU_AUCUN:         return "aucun";
+    case NIVEAU_AVERTISSEMENT: return "avertissement";
+    case NIVEAU_CRITIQUE:      return "critique";
+    }
+    return "?";
+}
@@ -0,0 +1,129 @@
+/**
+ * @brief   Moteur d'alarmes evalue a chaque echantillon
+ * @file    alarmes.h
+ * @author  cgil
+   @version	1.0
+ * @date    avril 2026
+ *
+ * Regles declarees a la compilation (REGLES[], comme CANAUX[]), evaluees
+ * par la tache acquisition sur chaque ligne, avant le stockage :
+ *  - SEUIL_HAUT / SEUIL_BAS : depassement, retombee apres l'hysteresis
+ *  - PENTE  : variation en unites brutes par minute, mesuree par rapport a
+ *             une reference vieille de dureeS a 2 x dureeS (lisse le bruit)
+ *  - FIGE   : valeur inchangee depuis dureeS secondes (capteur bloque)
+ *
+ * Chaque changement d'etat d'une regle :
+ *  - recalcule le voyant (envoye avec chaque mesure cloud) et le semaphore
+ *    GPIO 40 rouge (critique), 41 jaune (avertissement), 42 vert (rien),
+ *    ecrit en une fois (Sorties::ecrire, voir sorties.h)
+ *  - produit un EvenementAlarme depose dans la file "alertes" : la tache
+ *    alerte le pousse aussitot vers le cloud, hors de la cadence des mesures
+ *    (latence detection -> POST termine sur /api/alarmes)
+ *
+ * GUIDE AJOUT REGLE : une ligne dans REGLES[] (seuils en unites brutes du canal)
+ */
+
+#ifndef ALARMES_H
+#define ALARMES_H
+
+#include <Arduino.h>
+#include "canaux.h"
+#include "sorties.h"
+
+enum TypeRegle {
+    REGLE_SEUIL_HAUT,
+    REGLE_SEUIL_BAS,
+    REGLE_PENTE,
+    REGLE_FIGE
+};
+
+enum NiveauAlarme {
+    NIVEAU_AUCUN = 0,
+    NIVEAU_AVERTISSEMENT,
+    NIVEAU_CRITIQUE
+};
+
+struct Regle {
+    const char* nom;
+    int canal;
+    TypeRegle type;
+    int seuil;          //! seuil (unites brutes) ; PENTE : unites brutes par minute
+    int hysteresis;     //! ecart de retombee (SEUIL_*, PENTE)
+    uint32_t dureeS;    //! PENTE : age de la reference ; FIGE : duree sans changement
+    NiveauAlarme niveau;
+};
+
+static const Regle REGLES[] = {
+    { "temp_haute",   CANAL_TEMP,   REGLE_SEUIL_HAUT, 300, 10,   0,   NIVEAU_CRITIQUE },       //! > 30.0 °C
+    { "temp_basse",   CANAL_TEMP,   REGLE_SEUIL_BAS,   50, 10,   0,   NIVEAU_AVERTISSEMENT },  //! < 5.0 °C (gel)
+    { "temp_pente",   CANAL_TEMP,   REGLE_PENTE,      100, 20,   60,  NIVEAU_AVERTISSEMENT },  //! > 10 °C/min
+    { "temp_figee",   CANAL_TEMP,   REGLE_FIGE,         0,  0,   600, NIVEAU_AVERTISSEMENT },  //! 10 min identique
+    { "hum_haute",    CANAL_HUM,    REGLE_SEUIL_HAUT, 800, 30,   0,   NIVEAU_AVERTISSEMENT },  //! > 80.0 %
+    { "alarme_tor",   CANAL_ALARME, REGLE_SEUIL_HAUT,   0,  0,   0,   NIVEAU_CRITIQUE },       //! entree active
+};
+#define NB_REGLES (int)(sizeof(REGLES) / sizeof(REGLES[0]))
+
+//! Un changement d'etat d'une regle (element de la file "alertes", voir taches.h)
+struct EvenementAlarme {
+    uint8_t regle;
+    bool active;
+    int valeur;
+    time_t date;
+    uint32_t detectionUs;   //! micros() a la detection
+};
+
+//! Etat d'une regle (ecrit par la tache acquisition seule)
+struct EtatRegle {
+    bool active;
+    uint32_t nbDeclenchements;
+    //! PENTE : reference et candidate ; FIGE : derniere valeur et date du changement
+    int valRef, valCand;
+    time_t dateRef, dateCand;
+    bool init;
+};
+
+class Alarmes {
+private:
+    EtatRegle _etats[NB_REGLES] = {};
+    volatile bool _voyant = false;
+    volatile NiveauAlarme _niveau = NIVEAU_AUCUN;
+
+    //! Push cloud (ecrit par la tache alerte)
+    volatile uint32_t _nbPush = 0;
+    volatile uint32_t _nbEchecsPush = 0;
+    volatile uint32_t _derniereLatenceUs = 0;
+    volatile uint32_t _maxLatenceUs = 0;
+
+    //! Nouvel etat de la regle i pour la valeur v (etat courant si indecis)
+    bool evaluerRegle(int i, int v, time_t date);
+    void piloterSemaphore(NiveauAlarme niveau);
+
+public:
+    //! Sorties du semaphore, au vert
+    void begin();
+
+    /**
+     * @brief Evalue toutes les regles sur une ligne (tache acquisition)
+     * @param evts recoit les changements d'etat (NB_REGLES cases)
+     * @return nombre d'evenements
+     */
+    int evaluer(const LigneMesure& ligne, EvenementAlarme evts[NB_REGLES]);
+
+    //! Fin d'un push cloud (tache alerte)
+    void noterPush(const EvenementAlarme& e, bool ok);
+
+    // Lecture (envoi cloud, route /api/alarmes)
+    bool getVoyant() const { return _voyant; }
+    NiveauAlarme getNiveau() const { return _niveau; }
+    bool estActive(int i) const { return _etats[i].active; }
+    uint32_t getNbDeclenchements(int i) const { return _etats[i].nbDeclenchements; }
+    uint32_t getNbPush() const { return _nbPush; }
+    uint32_t getNbEchecsPush() const { return _nbEchecsPush; }
+    uint32_t getDerniereLatenceUs() const { return _derniereLatenceUs; }
+    uint32_t getMaxLatenceUs() const { return _maxLatenceUs; }
+
+    static const char* nomType(TypeRegle t);
+    static const char* nomNiveau(NiveauAlarme n);
+};
+
+#endif
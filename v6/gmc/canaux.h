@@ -0,0 +1,67 @@
+/**
+ * @brief   Declaration des canaux de mesure du module (a la compilation)
+ * @file    canaux.h
+ * @author  cgil
+   @version	1.0
+ * @date    mars 2026
+ *
+ * GUIDE AJOUT CANAL :
+ * 1. Ajouter une entree dans l'enum (avant NB_CANAUX)
+ * 2. Ajouter sa ligne dans CANAUX[] (meme ordre)
+ *    - prefixe : lettre des cles NVS "<prefixe><idx>" (unique, pas 't')
+ *    - echelle : diviseur pour l'affichage (10 = dixiemes)
+ *    - cloud   : envoye ou non vers le cloud
+ * 3. Fournir la valeur dans acquerirMesures() (gmc.ino)
+ */
+
+#ifndef CANAUX_H
+#define CANAUX_H
+
+#include <string.h>
+#include <time.h>
+
+enum IdCanal {
+    CANAL_TEMP = 0,     //! temperature en dixiemes de degre
+    CANAL_HUM,          //! humidite relative en dixiemes de %
+    CANAL_ALARME,       //! entree TOR d'alarme (0/1)
+    NB_CANAUX
+};
+
+struct Canal {
+    const char* nom;
+    char prefixe;
+    int echelle;
+    bool cloud;
+};
+
+//! 'v' pour la temperature : on relit l'historique des versions mono-canal
+static const Canal CANAUX[NB_CANAUX] = {
+    { "temp",   'v', 10, true },
+    { "hum",    'h', 10, true },
+    { "alarme", 'a',  1, true },
+};
+
+//! Une ligne de mesures : une valeur brute par canal, date du tick
+//! (element des files entre taches, voir taches.h)
+struct LigneMesure {
+    time_t date;
+    int valeurs[NB_CANAUX];
+};
+
+//! Entree TOR de l'alarme (active a l'etat bas)
+#define PIN_ALARME 4
+
+/**
+ * @brief Recherche un canal par son nom ("temp") ou son numero ("0")
+ * @return l'indice du canal, -1 si inconnu
+ */
+inline int chercherCanal(const char* nom) {
+    if (nom == nullptr || *nom == 0) return CANAL_TEMP;
+    if (nom[0] >= '0' && nom[0] <= '9' && nom[1] == 0)
+        return (nom[0] - '0' < NB_CANAUX) ? nom[0] - '0' : -1;
+    for (int i = 0; i < NB_CANAUX; i++)
+        if (strcmp(CANAUX[i].nom, nom) == 0) return i;
+    return -1;
+}
+
+#endif
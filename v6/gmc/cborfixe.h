@@ -0,0 +1,126 @@
+/**
+ * @brief   Ecriture CBOR (RFC 8949) dans un tampon fixe, sans allocation
+ * @file    cborfixe.h
+ * @author  cgil
+   @version	1.0
+ * @date    avril 2026
+ *
+ * Pendant binaire de JsonFixe pour /api/history et l'envoi cloud quand le
+ * client demande application/cbor : entiers sur 1 a 9 octets selon leur
+ * valeur, textes sans guillemets ni echappement. Meme principe de tampon :
+ * avec une fonction "vider", le tampon plein part en chunked et l'ecriture
+ * continue (memoire constante).
+ *
+ *   uint8_t tampon[64];
+ *   CborFixe c(tampon, sizeof(tampon));
+ *   c.map(2).champ("canal", "temp").cle("d").tableau();   // tableau de longueur inconnue
+ *   for (...) c.entier(v);
+ *   c.fin();                                              // fin du tableau
+ *
+ * Seuls les tableaux et maps ouverts sans longueur se ferment par fin().
+ */
+
+#ifndef CBORFIXE_H
+#define CBORFIXE_H
+
+#include <stdint.h>
+#include <string.h>
+
+//! Recoit un morceau quand le tampon est plein (et a la fin)
+typedef void (*ViderCbor)(void* ctx, const uint8_t* data, size_t n);
+
+//! Types majeurs CBOR
+#define CBOR_ENTIER     0
+#define CBOR_NEGATIF    1
+#define CBOR_TEXTE      3
+#define CBOR_TABLEAU    4
+#define CBOR_MAP        5
+#define CBOR_SIMPLE     7
+#define CBOR_INDEFINI   31
+#define CBOR_FIN        0xFF
+
+class CborFixe {
+private:
+    uint8_t* _tampon;
+    size_t _taille;
+    size_t _pos = 0;
+    size_t _total = 0;          //! octets deja passes a vider()
+    ViderCbor _vider;
+    void* _ctx;
+    bool _deborde = false;
+
+    void ecrire(const uint8_t* s, size_t n) {
+        while (n) {
+            if (_pos == _taille) {
+                if (!_vider) { _deborde = true; return; }
+                vider();
+            }
+            size_t c = (n < _taille - _pos) ? n : _taille - _pos;
+            memcpy(_tampon + _pos, s, c);
+            _pos += c; s += c; n -= c;
+        }
+    }
+    void ecrire(uint8_t o) { ecrire(&o, 1); }
+
+    //! Entete : type majeur + argument sur 0, 1, 2, 4 ou 8 octets (gros-boutiste)
+    void entete(uint8_t majeur, uint64_t v) {
+        uint8_t b[9];
+        size_t n;
+        if (v < 24)               { b[0] = (majeur << 5) | (uint8_t)v; n = 1; }
+        else if (v <= 0xFF)       { b[0] = (majeur << 5) | 24; n = 2; }
+        else if (v <= 0xFFFF)     { b[0] = (majeur << 5) | 25; n = 3; }
+        else if (v <= 0xFFFFFFFF) { b[0] = (majeur << 5) | 26; n = 5; }
+        else                      { b[0] = (majeur << 5) | 27; n = 9; }
+        for (size_t i = n - 1; i >= 1; i--) { b[i] = (uint8_t)v; v >>= 8; }
+        ecrire(b, n);
+    }
+
+public:
+    CborFixe(uint8_t* tampon, size_t taille, ViderCbor vider = nullptr, void* ctx = nullptr)
+        : _tampon(tampon), _taille(taille), _vider(vider), _ctx(ctx) {}
+
+    //! Tableau de n elements, ou de longueur inconnue (fermer par fin())
+    CborFixe& tableau(int n = -1) { if (n < 0) ecrire((CBOR_TABLEAU << 5) | CBOR_INDEFINI); else entete(CBOR_TABLEAU, n); return *this; }
+    //! Map de n paires, ou de longueur inconnue (fermer par fin())
+    CborFixe& map(int n = -1) { if (n < 0) ecrire((CBOR_MAP << 5) | CBOR_INDEFINI); else entete(CBOR_MAP, n); return *this; }
+    //! Ferme le dernier tableau ou la derniere map de longueur inconnue
+    CborFixe& fin() { ecrire(CBOR_FIN); return *this; }
+
+    CborFixe& entier(long long v) {
+        if (v >= 0) entete(CBOR_ENTIER, (uint64_t)v);
+        else entete(CBOR_NEGATIF, (uint64_t)(-1 - v));
+        return *this;
+    }
+    CborFixe& texte(const char* s) {
+        size_t n = s ? strlen(s) : 0;
+        entete(CBOR_TEXTE, n);
+        ecrire((const uint8_t*)s, n);
+        return *this;
+    }
+    CborFixe& booleen(bool b) { ecrire((CBOR_SIMPLE << 5) | (b ? 21 : 20)); return *this; }
+
+    // Membres de map : cle texte puis valeur
+    CborFixe& cle(const char* nom) { return texte(nom); }
+    CborFixe& champ(const char* nom, const char* s) { cle(nom); return texte(s); }
+    CborFixe& champ(const char* nom, bool b) { cle(nom); return booleen(b); }
+    CborFixe& champ(const char* nom, int v) { cle(nom); return entier(v); }
+    CborFixe& champ(const char* nom, long v) { cle(nom); return entier(v); }
+    CborFixe& champ(const char* nom, long long v) { cle(nom); return entier(v); }
+
+    //! Passe le contenu du tampon a la fonction vider (fin de reponse chunked)
+    void vider() {
+        if (_vider && _pos) {
+            _vider(_ctx, _tampon, _pos);
+            _total += _pos;
+            _pos = 0;
+        }
+    }
+
+    const uint8_t* donnees() const { return _tampon; }
+    size_t longueur() const { return _pos; }
+    size_t total() const { return _total + _pos; }
+    bool deborde() const { return _deborde; }
+    bool flux() const { return _total > 0; }
+};
+
+#endif
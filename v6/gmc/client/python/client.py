@@ -3,52 +3,139 @@
  * @brief   Programme client qui interroge un module gmc (ESP32)
  * @file   client.py
  * @author	cgil 
-   @version	1.0
- * @date    mars 2026
+   @version	1.1
+ * @date    avril 2026
  *
  * @details :
- *       le client interroge http://[IP_ESP32]/api/history_client  
+ *       le client interroge http://[IP_ESP32]/api/history?ch=temp
  *
- *  la reponse en JSON
+ *  la reponse en JSON (du plus recent au plus ancien)
     [
-      {"temp": 215, "date": "14:30"},
-      {"temp": 218, "date": "14:15"},
-      ... 118 autres mesures ...
+      {"v": 21.5, "t": "13/02/2026 12:34:52"},
+      {"v": 21.8, "t": "13/02/2026 12:34:22"},
+      ... autres mesures ...
     ]
+ *
+ *  ou en CBOR (en-tete Accept: application/cbor, ~4 octets par mesure) :
+    {"canal": "temp", "echelle": 10, "d": [t0, v0, t1-t0, v1-v0, ...]}
+ *  dates epoch et valeurs brutes, en deltas depuis la mesure precedente
  */
 """
 
 import requests
+import struct
 import time
+from datetime import datetime
 
 ESP32_IP = "192.168.1.16"
+CANAL = "temp"
+BINAIRE = True      # False : historique en JSON
+
+
+def lire_cbor(octets, pos=0):
+    """
+    Decodeur CBOR minimal (ce qu'envoie le module : entiers, textes,
+    booleens, tableaux et maps, de longueur connue ou non)
+    Retourne (valeur, position suivante)
+    """
+    b = octets[pos]
+    pos += 1
+    majeur, info = b >> 5, b & 0x1F
+    if b == 0xF4:
+        return False, pos
+    if b == 0xF5:
+        return True, pos
+    if b == 0xF6:
+        return None, pos
+
+    n = info
+    if info == 24:
+        n = octets[pos]; pos += 1
+    elif info == 25:
+        n = struct.unpack_from(">H", octets, pos)[0]; pos += 2
+    elif info == 26:
+        n = struct.unpack_from(">I", octets, pos)[0]; pos += 4
+    elif info == 27:
+        n = struct.unpack_from(">Q", octets, pos)[0]; pos += 8
+
+    if majeur == 0:
+        return n, pos
+    if majeur == 1:
+        return -1 - n, pos
+    if majeur == 3:
+        return octets[pos:pos + n].decode("utf-8"), pos + n
+    if majeur == 4:
+        liste = []
+        if info == 31:                      # longueur inconnue : jusqu'a 0xFF
+            while octets[pos] != 0xFF:
+                v, pos = lire_cbor(octets, pos)
+                liste.append(v)
+            return liste, pos + 1
+        for _ in range(n):
+            v, pos = lire_cbor(octets, pos)
+            liste.append(v)
+        return liste, pos
+    if majeur == 5:
+        dico = {}
+        if info == 31:
+            while octets[pos] != 0xFF:
+                k, pos = lire_cbor(octets, pos)
+                dico[k], pos = lire_cbor(octets, pos)
+            return dico, pos + 1
+        for _ in range(n):
+            k, pos = lire_cbor(octets, pos)
+            dico[k], pos = lire_cbor(octets, pos)
+        return dico, pos
+    raise ValueError(f"CBOR non supporte : octet {b:#04x}")
+
+
+def historique_cbor(octets):
+    """
+    Reconstruit les mesures d'une reponse CBOR de /api/history
+    Retourne [(date 'JJ/MM/AAAA HH:MM:SS', valeur), ...] comme le JSON
+    """
+    reponse, _ = lire_cbor(octets)
+    echelle = reponse["echelle"]
+    d = reponse["d"]
+    mesures = []
+    t = v = 0
+    for i in range(0, len(d), 2):
+        t = d[i] if i == 0 else t + d[i]
+        v = d[i + 1] if i == 0 else v + d[i + 1]
+        date = datetime.fromtimestamp(t).strftime("%d/%m/%Y %H:%M:%S")
+        mesures.append((date, v / echelle))
+    return mesures
 
- 
 
 def collecter_donnees():
     try:
         print("Récupération de l'historique, module GMC sur ESP32 S3...")
-        response = requests.get(f"http://{ESP32_IP}/api/history_client", timeout=5)
-        
+        entetes = {"Accept": "application/cbor"} if BINAIRE else {}
+        response = requests.get(f"http://{ESP32_IP}/api/history", params={"ch": CANAL},
+                                headers=entetes, timeout=5)
+
         if response.status_code == 200:
-            donnees = response.json()
+            if response.headers.get("Content-Type", "").startswith("application/cbor"):
+                donnees = historique_cbor(response.content)
+            else:
+                donnees = [(m["t"], m["v"]) for m in response.json()]
+
             if not donnees:
                 print("⚠️ L'ESP32 a répondu, mais l'historique est VIDE.")
             else:
-                print(f"\n✅ Reçu {len(donnees)} mesures.")
-                
+                print(f"\n✅ Reçu {len(donnees)} mesures ({len(response.content)} octets).")
+
                 # Affichage de la liste simplement
-                for mesure in donnees:
-                    # ON UTILISE LES CLÉS RÉELLES : 'temp' et 'date'
-                    valeur = mesure['temp'] / 10  # Conversion (ex: 215 -> 21.5)
-                    horodatage = mesure['date']
-                    print(f"Date: {horodatage} | Valeur: {valeur}°C")
-        
+                for horodatage, valeur in donnees:
+                    print(f"Date: {horodatage} | Valeur: {valeur}")
+
     except Exception as e:
         print(f"❌ Erreur de connexion : {e}")
 
-# Le programme interroge l'ESP toutes les 30 s
-while True:
-    collecter_donnees()
-    # time.sleep(1800) # 1800 secondes = 30 min
-    time.sleep(30)
+
+if __name__ == "__main__":
+    # Le programme interroge l'ESP toutes les 30 s
+    while True:
+        collecter_donnees()
+        # time.sleep(1800) # 1800 secondes = 30 min
+        time.sleep(30)
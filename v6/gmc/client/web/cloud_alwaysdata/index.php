@@ -6,6 +6,10 @@
 	
 	Ce script va recevoir le JSON de l'ESP32 
 	et l'écrire dans un fichier data.json
+
+	Format CBOR (config cloud_format=cbor, Content-Type application/cbor) :
+	une ligne complete {"t":epoch,"voyant":false,"temp":215,...}, redecoupee
+	ici en un enregistrement par canal, comme les envois JSON
 */
 
 // On autorise tout le monde à lire (CORS)
@@ -15,19 +19,70 @@ header("Content-Type: application/json");
 // On récupère le contenu brut du POST (le JSON de l'ESP32)
 $json_recu = file_get_contents('php://input');
 
-if (!empty($json_recu)) {
+// Un fichier par canal : data.json pour "temp" (compatibilite), data_<canal>.json sinon
+function fichierCanal($canal) {
+    $canal = preg_replace('/[^a-z0-9_]/', '', strtolower($canal));
+    return ($canal === '' || $canal === 'temp') ? 'data.json' : 'data_' . $canal . '.json';
+}
+
+// Decodeur CBOR minimal (entiers, textes, booleens, tableaux et maps)
+function cborLire($o, &$p) {
+    $b = ord($o[$p++]);
+    $majeur = $b >> 5;
+    $info = $b & 0x1f;
+    if ($b == 0xf4) return false;
+    if ($b == 0xf5) return true;
+    if ($b == 0xf6) return null;
+    $n = $info;
+    if ($info == 24) { $n = ord($o[$p]); $p += 1; }
+    elseif ($info == 25) { $n = unpack('n', substr($o, $p, 2))[1]; $p += 2; }
+    elseif ($info == 26) { $n = unpack('N', substr($o, $p, 4))[1]; $p += 4; }
+    elseif ($info == 27) { $n = unpack('J', substr($o, $p, 8))[1]; $p += 8; }
+    switch ($majeur) {
+        case 0: return $n;
+        case 1: return -1 - $n;
+        case 3: $t = substr($o, $p, $n); $p += $n; return $t;
+        case 4:
+            $r = [];
+            if ($info == 31) { while (ord($o[$p]) != 0xff) $r[] = cborLire($o, $p); $p++; }
+            else for ($i = 0; $i < $n; $i++) $r[] = cborLire($o, $p);
+            return $r;
+        case 5:
+            $r = [];
+            if ($info == 31) { while (ord($o[$p]) != 0xff) { $k = cborLire($o, $p); $r[$k] = cborLire($o, $p); } $p++; }
+            else for ($i = 0; $i < $n; $i++) { $k = cborLire($o, $p); $r[$k] = cborLire($o, $p); }
+            return $r;
+    }
+    return null;
+}
+
+$type = isset($_SERVER['CONTENT_TYPE']) ? $_SERVER['CONTENT_TYPE'] : '';
+if (!empty($json_recu) && strpos($type, 'application/cbor') !== false) {
+    $p = 0;
+    $ligne = cborLire($json_recu, $p);
+    foreach ($ligne as $canal => $valeur) {
+        if ($canal === 't' || $canal === 'voyant') continue;
+        $data = ['canal' => $canal, $canal => $valeur, 'voyant' => $ligne['voyant'],
+                 't' => $ligne['t'], 'server_time' => date('Y-m-d H:i:s')];
+        file_put_contents(fichierCanal($canal), json_encode($data));
+    }
+    echo json_encode(["status" => "success", "message" => "Donnée reçue"]);
+} elseif (!empty($json_recu)) {
     // On ajoute un timestamp pour savoir quand la donnée est arrivée
     $data = json_decode($json_recu, true);
     $data['server_time'] = date('Y-m-d H:i:s');
     
     // On sauvegarde dans un fichier local sur Alwaysdata
-    file_put_contents('data.json', json_encode($data));
+    $canal = isset($data['canal']) ? $data['canal'] : 'temp';
+    file_put_contents(fichierCanal($canal), json_encode($data));
     
     echo json_encode(["status" => "success", "message" => "Donnée reçue"]);
 } else {
     // Si on consulte la page via un navigateur, on affiche juste le contenu actuel
-    if (file_exists('data.json')) {
-        echo file_get_contents('data.json');
+    //   ex : index.php?canal=hum
+    $fichier = fichierCanal(isset($_GET['canal']) ? $_GET['canal'] : 'temp');
+    if (file_exists($fichier)) {
+        echo file_get_contents($fichier);
     } else {
         echo json_encode(["status" => "error", "message" => "Aucune donnée"]);
     }
@@ -10,104 +10,258 @@
 #include "conf.h"
 
 
-Conf::Conf() {}
+Conf::Conf() {
+    memset(_textes, 0, sizeof(_textes));
+    memset(_entiers, 0, sizeof(_entiers));
+    memset(_precedents, 0, sizeof(_precedents));
+}
 
-bool Conf::begin() {
-    this->prefs.begin("settings", true); // Mode lecture seule
+//! Les cles NVS sont limitees a 15 caracteres ("frequenceDesMesures" et
+//!   "modeSoloOuCluster" des versions precedentes etaient refusees)
+
+static const char* NS_SLOTS[2] = { "conf_a", "conf_b" };
+
+//! CRC32 (polynome 0xEDB88320), quelques centaines d'octets par commit
+static uint32_t crc32(const uint8_t* data, size_t n) {
+    uint32_t crc = 0xFFFFFFFF;
+    while (n--) {
+        crc ^= *data++;
+        for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+const char* Conf::nomParam(MasqueConf param) {
+    for (int i = 0; i < CONF_NB_PARAMS; i++)
+        if (param == ((MasqueConf)1 << i)) return PARAMS_CONF[i].nom;
+    return "?";
+}
+
+void Conf::affecter(int id, const char* valeur) {
+    strlcpy(_textes[id], valeur, CONF_TAILLE_TEXTE);
+    _entiers[id] = (PARAMS_CONF[id].type == PARAM_ENTIER) ? atoi(_textes[id]) : 0;
+}
 
+void Conf::charger(int id, const char* valeur) {
+    int32_t entier = (PARAMS_CONF[id].type == PARAM_ENTIER) ? atoi(valeur) : 0;
+    if (strlen(valeur) < CONF_TAILLE_TEXTE && PARAMS_CONF[id].validateur(valeur, entier))
+        affecter(id, valeur);
+}
+
+bool Conf::begin() {
     // 1. On récupère l'ID unique (MAC)
     //          par defaut : '1234XXXX'
     uint64_t chipId = ESP.getEfuseMac();
-    String uniqueId = String((uint32_t)(chipId >> 32), HEX);
-    uniqueId.toUpperCase();
-    //String chipIdStr = uniqueId.substring(uniqueId.length() - 4);
-    //String defaultSSID = "SSID_GMC_MC_" + uniqueId.substring(uniqueId.length() - 4);
-    String defaultApSSID = "";
-    defaultApSSID += "SSID_GMC_PASS_1234";
-    defaultApSSID += uniqueId;
-
-    
-    // 2. On charge le SSID depuis les préférences, 
-    // MAIS on passe notre identifiant unique comme valeur par défaut !
-     this->boxSsid = prefs.getString("boxSsid", "ssid_box_a_renseigner");
-    this->boxPwd = prefs.getString("boxPwd", "pwd_box_a_renseigner");
-
-    /**
-      @brief URL en mode client sur un Cloud (type alwaysdata ou autre)
-    */    
-    this->boxCloudUrl = prefs.getString("boxCloudUrl", "http://btscielinfo.alwaysdata.net/cloud/index.php");
-
-    this->apSsid = prefs.getString("apSsid", defaultApSSID);
-    this->apPwd = prefs.getString("apPwd", "1234" + uniqueId);
-   
-    this->frequenceDesMesures = prefs.getInt("frequenceDesMesures", 30);
-    this->modeSoloOuCluster = prefs.getString("modeSoloOuCluster", "modeSolo");
-
-
-    // Si pour une raison X ou Y (après un reset), les valeurs sont vides ou corrompues
-     if (this->boxSsid.length() < 8) 
-        this->boxSsid = "ssid_box_a_renseigner";
-    if (this->boxPwd.length() < 8 ) 
-        this->boxPwd = "pwd_box_a_renseigner";
-     if (this->boxCloudUrl.length() < 8 ) 
-        this->boxCloudUrl = "http://btscielinfo.alwaysdata.net/cloud/index.php";
-
-    if (this->apSsid.length() < 8) 
-        this->apSsid = defaultApSSID;
-    if (this->apPwd.length() < 8) 
-        this->apPwd = "1234" + uniqueId;
-   
-    
-    if (this->frequenceDesMesures == 0) 
-        this->frequenceDesMesures = 30;  //! Mesure ttes les 30 s
-    if (this->modeSoloOuCluster != "solo" && this->modeSoloOuCluster != "cluster") 
-        this->modeSoloOuCluster = "solo"; 
+    char uniqueId[9];
+    snprintf(uniqueId, sizeof(uniqueId), "%X", (uint32_t)(chipId >> 32));
+
+    // 2. Valeurs par defaut : restent en RAM tant que rien n'est modifie
+    //    (premier lancement, factoryReset : aucune ecriture flash)
+    for (int i = 0; i < CONF_NB_PARAMS; i++) {
+        char defaut[CONF_TAILLE_TEXTE];
+        snprintf(defaut, sizeof(defaut), PARAMS_CONF[i].defaut, uniqueId);
+        affecter(i, defaut);
+    }
+
+    // 3. Emplacement actif (une lecture), l'autre seulement s'il est illisible
+    this->prefs.begin("conf", true);
+    int actif = this->prefs.isKey("actif") ? this->prefs.getUChar("actif", 0) & 1 : -1;
+    this->prefs.end();
+
+    if (actif >= 0) {
+        if (lireSlot(actif) || lireSlot(1 - actif)) return true;
+        Serial.println("⚠️ Conf : emplacements A/B illisibles, valeurs par defaut");
+        return true;
+    }
+
+    // 4. Pas encore de schema 2 : reprise de l'ancien namespace
+    if (migrerSchema1()) {
+        commit();
+        this->prefs.begin("settings", false);
+        this->prefs.clear();
+        this->prefs.end();
+        Serial.printf("Conf : migration schema 1 -> %d ✅\n", CONF_VERSION_SCHEMA);
+    }
+    return true;
+}
+
+bool Conf::lireSlot(int slot) {
+    uint8_t blob[CONF_TAILLE_BLOB];
+    this->prefs.begin(NS_SLOTS[slot], true);
+    size_t lu = this->prefs.getBytes("params", blob, sizeof(blob));
     this->prefs.end();
 
-    //! on Resauve pour si on a modifie
-    this->save (this->boxSsid, this->boxPwd, this->boxCloudUrl, 
-                    this->apSsid, this->apPwd, 
-                    this->frequenceDesMesures, this->modeSoloOuCluster);
+    EnteteConf entete;
+    if (lu < sizeof(entete)) return false;
+    memcpy(&entete, blob, sizeof(entete));
+    if (entete.magic != CONF_MAGIC || entete.schema > CONF_VERSION_SCHEMA
+            || sizeof(entete) + entete.taille != lu
+            || crc32(blob + sizeof(entete), entete.taille) != entete.crc)
+        return false;
+
+    //! Couples [len cle][cle][len valeur][valeur] : une cle inconnue (parametre
+    //!   retire) est sautee, un parametre absent (ajoute depuis) garde son defaut
+    //!   Un futur schema 3 se traiterait ici selon entete.schema
+    const uint8_t* p = blob + sizeof(entete);
+    const uint8_t* fin = p + entete.taille;
+    for (int e = 0; e < entete.nbEntrees; e++) {
+        char cle[16], valeur[CONF_TAILLE_TEXTE];
+        if (p >= fin || *p >= sizeof(cle) || p + 1 + *p >= fin) return false;
+        memcpy(cle, p + 1, *p); cle[*p] = 0; p += 1 + *p;
+        if (*p >= sizeof(valeur) || p + 1 + *p > fin) return false;
+        memcpy(valeur, p + 1, *p); valeur[*p] = 0; p += 1 + *p;
 
+        for (int i = 0; i < CONF_NB_PARAMS; i++)
+            if (strcmp(PARAMS_CONF[i].cle, cle) == 0) { charger(i, valeur); break; }
+    }
+
+    _slotActif = slot;
+    _version = entete.version;
     return true;
 }
 
-void Conf::save(String box_ssid, String box_pwd, String box_cloud_url,
-        String ap_ssid, String ap_pwd, 
-        int frequence_mesures, String mode_ou_cluster) {
-    this->prefs.begin("settings", false); // Mode écriture
-    
-    this->prefs.putString("boxSsid", box_ssid);
-    this->prefs.putString("boxPwd", box_pwd);
-    this->prefs.putString("boxCloudUrl", box_cloud_url);
-
-    this->prefs.putString("apSsid", ap_ssid);
-    this->prefs.putString("apPwd", ap_pwd);
-  
-
-    this->prefs.putInt("frequenceDesMesures", frequence_mesures);
-    this->prefs.putString("modeSoloOuCluster", mode_ou_cluster);
-    
+bool Conf::migrerSchema1() {
+    this->prefs.begin("settings", true);
+    bool trouve = false;
+    for (int i = 0; i < CONF_NB_PARAMS; i++) {
+        const ParamDef& p = PARAMS_CONF[i];
+        if (!prefs.isKey(p.cle)) continue;
+        char valeur[CONF_TAILLE_TEXTE];
+        if (p.type == PARAM_ENTIER) snprintf(valeur, sizeof(valeur), "%d", (int)prefs.getInt(p.cle, 0));
+        else prefs.getString(p.cle, valeur, sizeof(valeur));
+        charger(i, valeur);
+        trouve = true;
+    }
     this->prefs.end();
-    
-    // On met à jour les variables locales pour éviter de redémarrer si pas nécessaire
-    this->boxSsid = box_ssid;
-    this->boxPwd = box_pwd;
-    this->boxCloudUrl = box_cloud_url;
-   
-    this->apSsid = ap_ssid;
-    this->apPwd = ap_pwd;
-  
-    this->frequenceDesMesures = frequence_mesures;
-    this->modeSoloOuCluster = mode_ou_cluster;
-
-    
+    return trouve;
+}
+
+bool Conf::commit() {
+    uint8_t blob[CONF_TAILLE_BLOB];
+    EnteteConf entete;
+    size_t n = sizeof(entete);
+
+    for (int i = 0; i < CONF_NB_PARAMS; i++) {
+        size_t lc = strlen(PARAMS_CONF[i].cle), lv = strlen(_textes[i]);
+        if (n + 2 + lc + lv > sizeof(blob)) return false;
+        blob[n++] = lc; memcpy(blob + n, PARAMS_CONF[i].cle, lc); n += lc;
+        blob[n++] = lv; memcpy(blob + n, _textes[i], lv); n += lv;
+    }
+
+    entete.magic = CONF_MAGIC;
+    entete.schema = CONF_VERSION_SCHEMA;
+    entete.nbEntrees = CONF_NB_PARAMS;
+    entete.version = _version + 1;
+    entete.taille = n - sizeof(entete);
+    entete.reserve = 0;
+    entete.crc = crc32(blob + sizeof(entete), entete.taille);
+    memcpy(blob, &entete, sizeof(entete));
+
+    // 1. Emplacement inactif, en entier
+    int slot = (_slotActif == 0) ? 1 : 0;
+    this->prefs.begin(NS_SLOTS[slot], false);
+    bool ok = this->prefs.putBytes("params", blob, n) == n;
+    this->prefs.end();
+    if (!ok) {
+        Serial.println("❌ Conf : ecriture emplacement impossible");
+        return false;
+    }
+
+    // 2. Bascule : une seule cle, ecriture atomique en NVS
+    this->prefs.begin("conf", false);
+    ok = this->prefs.putUChar("actif", slot) == 1;
+    this->prefs.end();
+    if (ok) {
+        _slotActif = slot;
+        _version = entete.version;
+    }
+    return ok;
+}
+
+bool Conf::modifier(int id, const char* valeur) {
+    if (id < 0 || id >= CONF_NB_PARAMS || valeur == nullptr) return false;
+    const ParamDef& p = PARAMS_CONF[id];
+
+    //! Valeurs invalides (memes regles que begin()) : on garde l'ancienne
+    //!   plutot que d'ecrire une valeur que le prochain boot corrigerait
+    int32_t entier = (p.type == PARAM_ENTIER) ? atoi(valeur) : 0;
+    if (strlen(valeur) >= CONF_TAILLE_TEXTE || !p.validateur(valeur, entier)) {
+        _refuses |= (MasqueConf)1 << id;
+        return false;
+    }
+
+    // Comparaison = dirty tracking
+    if (p.type == PARAM_ENTIER ? entier == _entiers[id] : strcmp(valeur, _textes[id]) == 0)
+        return false;
+
+    //! Premiere modification depuis valider() : on garde la valeur enregistree
+    if (!(_enAttente & ((MasqueConf)1 << id))) strcpy(_precedents[id], _textes[id]);
+    affecter(id, valeur);
+    _enAttente |= (MasqueConf)1 << id;
+    return true;
+}
+
+MasqueConf Conf::valider() {
+    MasqueConf modifies = _enAttente;
+    _enAttente = 0;
+    _echecEcriture = false;
+    _refusesValides = _refuses;
+    _refuses = 0;
+
+    if (modifies) {
+        //! Ecriture refusee : la RAM reprend les valeurs encore en NVS,
+        //!   sinon le prochain boot les contredirait
+        if (!this->commit()) {
+            for (int i = 0; i < CONF_NB_PARAMS; i++)
+                if (modifies & ((MasqueConf)1 << i)) affecter(i, _precedents[i]);
+            _echecEcriture = true;
+            return 0;
+        }
+
+        //! Publication aux abonnes concernes
+        for (int i = 0; i < _nbAbonnes; i++)
+            if (_abonnes[i].masque & modifies) _abonnes[i].fn(modifies);
+    }
+    return modifies;
+}
+
+MasqueConf Conf::importerJson(JsonObjectConst obj) {
+    for (int i = 0; i < CONF_NB_PARAMS; i++) {
+        JsonVariantConst v = obj[PARAMS_CONF[i].nom];
+        if (v.isNull()) continue;
+        if (v.is<const char*>()) {
+            modifier(i, v.as<const char*>());
+        } else {
+            char tmp[12];
+            snprintf(tmp, sizeof(tmp), "%d", v.as<int>());
+            modifier(i, tmp);
+        }
+    }
+    return valider();
+}
+
+void Conf::exporterJson(JsonFixe& j) const {
+    for (int i = 0; i < CONF_NB_PARAMS; i++) {
+        if (PARAMS_CONF[i].type == PARAM_ENTIER) j.champ(PARAMS_CONF[i].nom, (long)_entiers[i]);
+        else j.champ(PARAMS_CONF[i].nom, (const char*)_textes[i]);
+    }
+}
+
+bool Conf::abonner(MasqueConf masque, ObservateurConf fn) {
+    if (_nbAbonnes >= CONF_NB_ABONNES) return false;
+    _abonnes[_nbAbonnes].masque = masque;
+    _abonnes[_nbAbonnes].fn = fn;
+    _nbAbonnes++;
+    return true;
 }
 
 void Conf::factoryReset() {
-    prefs.begin("settings", false);
-    prefs.clear();
-    prefs.end();
+    const char* namespaces[] = { "conf", "conf_a", "conf_b", "settings" };
+    for (const char* ns : namespaces) {
+        prefs.begin(ns, false);
+        prefs.clear();
+        prefs.end();
+    }
     Serial.println("Config effacée. Redémarrage...");
     delay(1000);
     ESP.restart();
@@ -1,84 +1,268 @@
 /**
- * @brief   Classe de gestion de toute la partie 
+ * @brief   Classe de gestion de toute la partie
  *                    configuration de l ESP32
  * @file    	conf.h
- * @author	cgil 
+ * @author	cgil
    @version	1.0
  * @date    fev 2026
  */
- 
+
 #ifndef CONF_H
 #define CONF_H
 
 #include <Arduino.h>
 #include <Preferences.h>
+#include <ArduinoJson.h>
+#include "jsonfixe.h"
+#include <functional>
+#include <string.h>
+
+/**
+ * GUIDE AJOUT PARAMÈTRE :
+ * 1. Ajouter une entree dans l'enum IdParam (avant CONF_NB_PARAMS)
+ * 2. Ajouter sa ligne dans PARAMS_CONF[] (meme ordre) :
+ *    - cle     : cle NVS (15 caracteres maxi)
+ *    - nom     : nom dans /api/config (GET et POST)
+ *    - type    : PARAM_TEXTE ou PARAM_ENTIER
+ *    - defaut  : texte par defaut ("%s" = identifiant unique de la puce)
+ *    - validateur : refuse une valeur (begin() remet alors le defaut)
+ *    - redemarrage : la prise en compte demande un reboot
+ * 3. (optionnel) un getter nomme ci-dessous
+ * Chargement NVS, sauvegarde, JSON et masques sont generes depuis la table.
+ */
+enum IdParam {
+    PARAM_BOX_SSID = 0,
+    PARAM_BOX_PWD,
+    PARAM_BOX_CLOUD_URL,
+    PARAM_AP_SSID,
+    PARAM_AP_PWD,
+    PARAM_FREQ,
+    PARAM_MODE,
+    PARAM_CLOUD_FORMAT,
+    CONF_NB_PARAMS
+};
+
+/**
+ * @brief Un bit par parametre : sert a la fois de "dirty flag" (commit
+ *        a faire) et de compte-rendu des modifications pour /api/config.
+ */
+typedef uint32_t MasqueConf;
+enum ParamConf : MasqueConf {
+    CONF_BOX_SSID      = 1 << PARAM_BOX_SSID,
+    CONF_BOX_PWD       = 1 << PARAM_BOX_PWD,
+    CONF_BOX_CLOUD_URL = 1 << PARAM_BOX_CLOUD_URL,
+    CONF_AP_SSID       = 1 << PARAM_AP_SSID,
+    CONF_AP_PWD        = 1 << PARAM_AP_PWD,
+    CONF_FREQ          = 1 << PARAM_FREQ,
+    CONF_MODE          = 1 << PARAM_MODE,
+    CONF_CLOUD_FORMAT  = 1 << PARAM_CLOUD_FORMAT
+};
+
+//! Taille maxi d'une valeur texte, '\0' compris (URL cloud)
+#define CONF_TAILLE_TEXTE 100
+
+enum TypeParam { PARAM_TEXTE, PARAM_ENTIER };
+
+//! Recoit la valeur texte et, pour un entier, sa conversion
+typedef bool (*ValidateurParam)(const char* texte, int32_t entier);
+
+inline bool validerLongueur8(const char* texte, int32_t) { return strlen(texte) >= 8; }
+inline bool validerPositif(const char*, int32_t entier) { return entier > 0; }
+inline bool validerMode(const char* texte, int32_t) {
+    return strcmp(texte, "solo") == 0 || strcmp(texte, "cluster") == 0;
+}
+inline bool validerFormatCloud(const char* texte, int32_t) {
+    return strcmp(texte, "json") == 0 || strcmp(texte, "cbor") == 0;
+}
+
+struct ParamDef {
+    const char* cle;
+    const char* nom;
+    TypeParam type;
+    const char* defaut;
+    ValidateurParam validateur;
+    bool redemarrage;
+};
+
+/**
+  @brief : Parametres de connexion par Box en mode client (box_*),
+           URL en mode client sur un Cloud (type alwaysdata ou autre),
+           Parametres de connexion par AP en mode serveur (ap_*)
+   CONFIGURATION PREMIER LANCEMENT : voir le SSID du wifi et le Pwd est la fin du SSID
+    wifi : code SSID : "SSID_GMC_PASS_1234XXXX" , Pwd : "1234XXXX"
+   allez sur : http://192.168.4.1/config
+
+   Les identifiants Box, l'URL, la frequence et le format cloud sont appliques a chaud par les
+   abonnes (Conf::abonner) ; point d'acces et mode demandent un reboot.
+*/
+static constexpr ParamDef PARAMS_CONF[CONF_NB_PARAMS] = {
+    { "boxSsid",     "box_ssid",      PARAM_TEXTE,  "ssid_box_a_renseigner", validerLongueur8, false },
+    { "boxPwd",      "box_pwd",       PARAM_TEXTE,  "pwd_box_a_renseigner",  validerLongueur8, false },
+    { "boxCloudUrl", "box_cloud_url", PARAM_TEXTE,  "http://btscielinfo.alwaysdata.net/cloud/index.php", validerLongueur8, false },
+    { "apSsid",      "ap_ssid",       PARAM_TEXTE,  "SSID_GMC_PASS_1234%s",  validerLongueur8, true },
+    { "apPwd",       "ap_pwd",        PARAM_TEXTE,  "1234%s",                validerLongueur8, true },
+    { "freq",        "freq",          PARAM_ENTIER, "30",                    validerPositif,   false },  //! Mesure ttes les 30 s
+    { "mode",        "mode",          PARAM_TEXTE,  "solo",                  validerMode,      true },
+    { "cloudFmt",    "cloud_format",  PARAM_TEXTE,  "json",                  validerFormatCloud, false },  //! json | cbor
+};
+
+//! Masque des parametres dont la prise en compte demande un reboot
+constexpr MasqueConf masqueRedemarrage() {
+    MasqueConf m = 0;
+    for (int i = 0; i < CONF_NB_PARAMS; i++)
+        if (PARAMS_CONF[i].redemarrage) m |= (MasqueConf)1 << i;
+    return m;
+}
+#define CONF_PARAMS_REDEMARRAGE (masqueRedemarrage())
+
+/**
+ * @brief Stockage NVS en deux emplacements A/B ("conf_a", "conf_b") :
+ *        chaque valider() ecrit la config complete dans l'emplacement inactif
+ *        (un seul blob "params" : entete + couples cle/valeur), puis bascule
+ *        la cle "actif" du namespace "conf". Une coupure pendant l'ecriture
+ *        laisse l'ancien emplacement intact.
+ *  schema 1 : une cle par parametre dans "settings" (lu une fois puis migre)
+ *  schema 2 : blob A/B, couples cle/valeur en texte (ajout ou retrait de
+ *             parametre sans migration)
+ */
+#define CONF_VERSION_SCHEMA 2
+#define CONF_MAGIC          0x4347      //! "GC"
+#define CONF_TAILLE_BLOB    1024
+
+struct EnteteConf {
+    uint16_t magic;
+    uint8_t schema;
+    uint8_t nbEntrees;
+    uint32_t version;       //! compteur de commits
+    uint16_t taille;        //! octets de donnees apres l'entete
+    uint16_t reserve;
+    uint32_t crc;           //! CRC32 des donnees
+};
+
+//! Abonne aux changements de config : recoit le masque ParamConf modifie
+typedef std::function<void(MasqueConf modifies)> ObservateurConf;
+#define CONF_NB_ABONNES 6
 
 /**
  * @class conf
- * @brief Gère la configuration persistante du module (JSON sur LittleFS).
- * * GUIDE AJOUT PARAMÈTRE :
- * 1. Déclarer la variable : String _monParam;
- * 2. Créer le Getter : String getMonParam() { return _monParam; }
- * 3. Créer le Setter : void setMonParam(String v) { _monParam = v; }
- * 4. Mettre à jour load() : _monParam = doc["monParam"] | "defaut";
- * 5. Mettre à jour save() : doc["monParam"] = _monParam;
+ * @brief Gère la configuration persistante du module (Preferences / NVS),
+ *        decrite par la table PARAMS_CONF.
+ *        Les getters rendent un pointeur sur la valeur en RAM : pas de copie.
  */
 class Conf {
 private:
     Preferences prefs;
 
-    /**
-      @brief : Parametres de connexion par Box en mode client
-       CONFIGURATION PREMIER LANCEMENT : voir le SSID du wifi et le Pwd est la fin du SSID
-        wifi : code SSID : "SSID_GMC_PASS_1234XXXX" , Pwd : "1234XXXX"
-       allez sur : http://192.168.4.1/config
-    */
-    String boxSsid;
-    String boxPwd;
-
-    //! URL en mode client sur un Cloud (type alwaysdata ou autre)
-    //!   ex : ""http://btscielinfo.alwaysdata.net/cloud/index.php" 
-    String boxCloudUrl;
-
-
-     /**
-      @brief : Parametres de connexion par AP en mode serveur
-      CONFIGURATION PREMIER LANCEMENT : voir le SSID du wifi et le Pwd est la fin du SSID
-        wifi : code SSID : "SSID_GMC_PASS_1234XXXX" , Pwd : "1234XXXX"
-       allez sur : http://192.168.4.1/config
-    */
-    String apSsid;
-    String apPwd;
-
-    /** @brief : params autres
-    */
-    int frequenceDesMesures;
-    String modeSoloOuCluster;
+    //! Valeurs courantes (texte pour tous, conversion pour les entiers)
+    char _textes[CONF_NB_PARAMS][CONF_TAILLE_TEXTE];
+    int32_t _entiers[CONF_NB_PARAMS];
+
+    //! Modifications en attente de valider(), et les valeurs qu'elles
+    //!   remplacent (restaurees si l'ecriture echoue)
+    MasqueConf _enAttente = 0;
+    char _precedents[CONF_NB_PARAMS][CONF_TAILLE_TEXTE];
+    bool _echecEcriture = false;
+
+    //! Valeurs invalides recues depuis valider(), et celles du dernier valider()
+    MasqueConf _refuses = 0;
+    MasqueConf _refusesValides = 0;
+
+    //! Emplacement A/B actif (-1 : aucun, valeurs par defaut) et version
+    int _slotActif = -1;
+    uint32_t _version = 0;
+
+    //! Ecrit la config complete dans l'emplacement inactif puis bascule
+    bool commit();
+    //! Lit et verifie un emplacement (entete, CRC), applique ses valeurs
+    bool lireSlot(int slot);
+    //! Migration du schema 1 (namespace "settings", une cle par parametre)
+    bool migrerSchema1();
+    //! Valeur lue en NVS : appliquee si le validateur l'accepte
+    void charger(int id, const char* valeur);
+
+    //! Affecte sans controle ni marquage (chargement, defauts)
+    void affecter(int id, const char* valeur);
+
+    //! Abonnes notifies apres un valider() qui modifie un parametre de leur masque
+    struct Abonne {
+        MasqueConf masque;
+        ObservateurConf fn;
+    };
+    Abonne _abonnes[CONF_NB_ABONNES];
+    int _nbAbonnes = 0;
 
 public:
     Conf();
-    
-    // Charge les données depuis la Flash (NVS)
+
+    // Charge les données depuis la Flash (NVS) : emplacement actif seul
     bool begin();
-    
-    // Sauvegarde les données
-    void save (String boxSsid, String boxPassword, String boxClourdUrl, 
-                String apSsid, String apPassword, int freq, String mode);
-    
+
+    /**
+     * @brief Prepare la modification d'un parametre (rien n'est écrit).
+     *        Une valeur invalide ou trop longue est ignorée et notée
+     *        (voir getRefuses).
+     * @return true si la valeur est acceptée et differente de l'actuelle
+     */
+    bool modifier(int id, const char* valeur);
+
+    /**
+     * @brief Sauvegarde les modifications en attente (commit atomique A/B,
+     *        rien n'est écrit si aucune valeur n'a changé), puis les abonnés
+     *        sont notifiés. Si l'écriture échoue, les valeurs précédentes
+     *        sont restaurées et personne n'est notifié (voir getEchecEcriture).
+     * @return masque ParamConf des paramètres réellement modifiés
+     *         (& CONF_PARAMS_REDEMARRAGE != 0 => reboot nécessaire), 0 si echec
+     */
+    MasqueConf valider();
+
+    //! true si le dernier valider() n'a pas pu ecrire (modifications annulees)
+    bool getEchecEcriture() const { return _echecEcriture; }
+
+    //! Masque des parametres dont la valeur a ete refusee avant le dernier valider()
+    MasqueConf getRefuses() const { return _refusesValides; }
+
+    //! Import des champs presents de l'objet (noms de /api/config) puis valider()
+    MasqueConf importerJson(JsonObjectConst obj);
+
+    //! Export de tous les parametres (noms de /api/config) dans l'objet ouvert
+    void exporterJson(JsonFixe& j) const;
+
+    //! Compteur de commits et emplacement actif (0 = A, 1 = B, -1 = aucun)
+    uint32_t getVersion() const { return _version; }
+    int getSlotActif() const { return _slotActif; }
+
+    // Accesseurs generiques
+    const char* texte(IdParam id) const { return _textes[id]; }
+    int32_t entier(IdParam id) const { return _entiers[id]; }
+
     // Connexions AP (serveur) et/ou Box (client)
-    
-    String getBoxSSID() const { return boxSsid; }
-    String getBoxPassword() const { return boxPwd; }
-    String getBoxCloudUrl() { return boxCloudUrl; }
 
-    String getApSSID() const { return apSsid; }
-    String getApPassword() const { return apPwd; }
+    const char* getBoxSSID() const { return _textes[PARAM_BOX_SSID]; }
+    const char* getBoxPassword() const { return _textes[PARAM_BOX_PWD]; }
+    const char* getBoxCloudUrl() const { return _textes[PARAM_BOX_CLOUD_URL]; }
+
+    const char* getApSSID() const { return _textes[PARAM_AP_SSID]; }
+    const char* getApPassword() const { return _textes[PARAM_AP_PWD]; }
+
+    int getFrequenceMesures() const { return _entiers[PARAM_FREQ]; }
+    const char* getMode() const { return _textes[PARAM_MODE]; }
+    bool estSolo() const { return strcmp(_textes[PARAM_MODE], "solo") == 0; }
+    bool cloudEnCbor() const { return strcmp(_textes[PARAM_CLOUD_FORMAT], "cbor") == 0; }
+
+    /**
+     * @brief Abonne une fonction aux parametres du masque : elle est appelee
+     *        (dans le contexte de valider(), donc la tache web, voir taches.h)
+     *        apres chaque modification, ce qui evite aux consommateurs de
+     *        relire les getters a chaque tour de boucle.
+     * @return false si la table des abonnes est pleine
+     */
+    bool abonner(MasqueConf masque, ObservateurConf fn);
+
+    //! Nom du parametre (celui de /api/config) pour un bit ParamConf
+    static const char* nomParam(MasqueConf param);
 
-    int getFrequenceMesures() const { return frequenceDesMesures; }
-    String getMode() const { return modeSoloOuCluster; }
-    
     // Réinitialisation d'usine
     void factoryReset();
 };
 
-#endif
\ No newline at end of file
+#endif
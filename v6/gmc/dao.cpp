@@ -11,6 +11,7 @@
 
 
 #include "dao.h"
+#include <LittleFS.h>
 #include <time.h> // Indispensable pour manipuler le temps
 
 // Le constructeur reste vide car Preferences ne gère pas de fichier physique 'path'
@@ -18,113 +19,374 @@ Dao::Dao(const char* path) {}
 
 bool Dao::begin() {
     // On teste si on arrive à ouvrir le namespace au démarrage
-    if (prefs.begin(_namespace, false)) {
-        prefs.end(); // On referme tout de suite, on ouvrira à la demande
-        return true;
+    if (!prefs.begin(_namespace, false)) return false;
+
+    // Chargement des colonnes en RAM (une seule fois)
+    char cle[8];
+    _idx = prefs.getInt("idx", 0) % DAO_NB_MESURES;
+    _count = prefs.getInt("count", 0);
+    if (_count > DAO_NB_MESURES) _count = DAO_NB_MESURES;
+
+    for (int i = 0; i < DAO_NB_MESURES; i++) {
+        snprintf(cle, sizeof(cle), "t%d", i);
+        _dates[i] = (i < _count) ? prefs.getLong(cle, 0) : 0;
+        for (int c = 0; c < NB_CANAUX; c++) {
+            snprintf(cle, sizeof(cle), "%c%d", CANAUX[c].prefixe, i);
+            _colonnes[c][i] = (i < _count) ? (int16_t)prefs.getInt(cle, 0) : 0;
+        }
     }
-    return false;
+
+    prefs.end(); // On referme tout de suite, on ouvrira à la demande
+
+    // Anneau etendu : optionnel, on continue sur la NVS s'il est absent
+    if (ouvrirEtendu()) {
+        Serial.printf("[PSRAM %d/%d] ", _countEtendu, DAO_NB_ETENDU);
+    }
+    ouvrirStats();
+    return true;
 }
 
 
 /**
- * \brief Extrait la valeur : soit depuis du SQL, soit depuis une String brute
+ * \brief Lie les fenetres au niveau de lecture puis y rejoue l'historique
+ *        (de la plus ancienne ligne a la plus recente)
  */
-int Dao::extractionValeur(String query) {
-    query.toUpperCase();
+void Dao::ouvrirStats() {
+    int32_t* dates = _datesEtendu ? _datesEtendu : _dates;
+    int16_t* colonnes[NB_CANAUX];
+    for (int c = 0; c < NB_CANAUX; c++) colonnes[c] = _datesEtendu ? _colEtendu[c] : _colonnes[c];
 
-    // Si c'est du SQL "VALUES (123)"
-    if (query.indexOf("VALUES") != -1) {
-        int start = query.lastIndexOf('(') + 1;
-        int end = query.lastIndexOf(')');
-        if (start > 0 && end > start) {
-            return query.substring(start, end).toInt();
+    Instantane s = instantane();
+    for (int f = 0; f < NB_FENETRES; f++) {
+        if (!_fenetres[f].lier(FENETRES_STATS[f].dureeS, dates, colonnes, capacite(), enPsram())) continue;
+        int16_t valeurs[NB_CANAUX];
+        for (int i = s.count - 1; i >= 0; i--) {
+            for (int c = 0; c < NB_CANAUX; c++) valeurs[c] = valeurLigne(s, i, c);
+            _fenetres[f].ajouter(indexLecture(s, i), dateLigne(s, i), valeurs);
         }
     }
-    
+    publierStats();
+}
+
+
+void Dao::publierStats() {
+    ResumeStats r[NB_FENETRES][NB_CANAUX];
+    for (int f = 0; f < NB_FENETRES; f++)
+        for (int c = 0; c < NB_CANAUX; c++) r[f][c] = _fenetres[f].resume(c);
+    portENTER_CRITICAL(&_mux);
+    memcpy(_resumes, r, sizeof(r));
+    portEXIT_CRITICAL(&_mux);
+}
+
+
+bool Dao::lireStats(int fenetre, int canal, ResumeStats& r) const {
+    if (fenetre < 0 || fenetre >= NB_FENETRES || canal < 0 || canal >= NB_CANAUX) return false;
+    portENTER_CRITICAL(&_mux);
+    r = _resumes[fenetre][canal];
+    portEXIT_CRITICAL(&_mux);
+    return true;
+}
+
+
+/**
+ * \brief Alloue l'anneau etendu en PSRAM (un seul bloc : dates puis colonnes),
+ *        recharge le fichier puis complete avec les lignes NVS ecrites apres
+ *        le dernier flush (celles qui n'etaient pas encore dans le fichier)
+ */
+bool Dao::ouvrirEtendu() {
+    if (!psramFound()) return false;
+    size_t taille = DAO_NB_ETENDU * (sizeof(int32_t) + NB_CANAUX * sizeof(int16_t));
+    uint8_t* bloc = (uint8_t*)ps_malloc(taille);
+    if (!bloc) return false;
+
+    _datesEtendu = (int32_t*)bloc;
+    int16_t* col = (int16_t*)(bloc + DAO_NB_ETENDU * sizeof(int32_t));
+    for (int c = 0; c < NB_CANAUX; c++) _colEtendu[c] = col + c * DAO_NB_ETENDU;
+    _idxEtendu = _countEtendu = _idxFlush = 0;
+
+    // Le FS est monte par Net::begin() ; begin() rend true s'il l'est deja
+    int idxNvs = -1;        //! reste -1 sans fichier : toutes les lignes NVS sont reprises
+    if (LittleFS.begin(true)) chargerFichierEtendu(idxNvs);
+
+    // Lignes NVS ecrites depuis le flush, de la plus ancienne a la plus recente
+    int aReprendre = (idxNvs < 0) ? _count : (_idx - idxNvs + DAO_NB_MESURES) % DAO_NB_MESURES;
+    if (aReprendre > _count) aReprendre = _count;
+    for (int i = aReprendre - 1; i >= 0; i--) {
+        int index = indexLigne(i);
+        int16_t valeurs[NB_CANAUX];
+        for (int c = 0; c < NB_CANAUX; c++) valeurs[c] = _colonnes[c][index];
+        ajouterEtendu(_dates[index], valeurs);
+    }
+    return true;
+}
+
+
+/**
+ * \brief Relit le fichier de l'anneau etendu (les lignes sont a leur place
+ *        dans l'anneau) ; un fichier d'un autre format est ignore
+ */
+bool Dao::chargerFichierEtendu(int& idxNvs) {
+    File f = LittleFS.open(DAO_FICHIER_ETENDU, "r");
+    if (!f) return false;
+
+    EnteteEtendu e;
+    if (f.read((uint8_t*)&e, sizeof(e)) != sizeof(e) || e.magic != DAO_MAGIC_ETENDU ||
+        e.nbCanaux != NB_CANAUX || e.tailleLigne != sizeof(LigneEtendu) ||
+        e.capacite != DAO_NB_ETENDU || e.idx >= DAO_NB_ETENDU || e.count > DAO_NB_ETENDU ||
+        e.idxNvs >= DAO_NB_MESURES) {
+        f.close();
+        return false;
+    }
+
+    // Lecture par paquets sur la pile, repartis dans les colonnes
+    LigneEtendu paquet[DAO_LIGNES_FLUSH];
+    uint32_t lues = 0;
+    while (lues < e.count) {
+        uint32_t n = e.count - lues;
+        if (n > DAO_LIGNES_FLUSH) n = DAO_LIGNES_FLUSH;
+        if (f.read((uint8_t*)paquet, n * sizeof(LigneEtendu)) != n * sizeof(LigneEtendu)) break;
+        for (uint32_t k = 0; k < n; k++) {
+            _datesEtendu[lues + k] = paquet[k].date;
+            for (int c = 0; c < NB_CANAUX; c++) _colEtendu[c][lues + k] = paquet[k].valeurs[c];
+        }
+        lues += n;
+    }
+    f.close();
+
+    // Fichier tronque : on garde ce qui a ete lu (anneau pas encore plein)
+    _countEtendu = (lues == e.count) ? e.count : lues;
+    _idxEtendu = (lues == e.count) ? e.idx : lues % DAO_NB_ETENDU;
+    _idxFlush = _idxEtendu;
+    idxNvs = (int)e.idxNvs;
+    return true;
+}
+
+
+/**
+ * \brief Ajoute une ligne a l'anneau etendu (RAM seule, voir flusher())
+ */
+void Dao::ajouterEtendu(int32_t date, const int16_t valeurs[NB_CANAUX]) {
+    _datesEtendu[_idxEtendu] = date;
+    for (int c = 0; c < NB_CANAUX; c++) _colEtendu[c][_idxEtendu] = valeurs[c];
+    // Publication pour les lecteurs (case remplie avant)
+    portENTER_CRITICAL(&_mux);
+    _idxEtendu = (_idxEtendu + 1) % DAO_NB_ETENDU;
+    if (_countEtendu < DAO_NB_ETENDU) _countEtendu++;
+    portEXIT_CRITICAL(&_mux);
+    // Plus d'un tour sans flush : le plus ancien non sauve est ecrase
+    if (_idxEtendu == _idxFlush && _countEtendu == DAO_NB_ETENDU) _idxFlush = (_idxFlush + 1) % DAO_NB_ETENDU;
+}
+
+
+/**
+ * \brief Ecrit les lignes non sauvees a leur place dans le fichier, puis
+ *        l'entete : une coupure avant l'entete laisse l'ancien etat valide
+ */
+bool Dao::flusher() {
+    if (!_datesEtendu || _idxFlush == _idxEtendu) return true;
+
+    EnteteEtendu e = { DAO_MAGIC_ETENDU, NB_CANAUX, sizeof(LigneEtendu), DAO_NB_ETENDU, 0, 0, 0 };
+    bool creation = !LittleFS.exists(DAO_FICHIER_ETENDU);
+    File f = LittleFS.open(DAO_FICHIER_ETENDU, creation ? "w" : "r+");
+    if (!f) return false;
+
+    // Nouveau fichier : entete vide d'abord, les lignes suivent sans trou
+    bool ok = !creation || f.write((const uint8_t*)&e, sizeof(e)) == sizeof(e);
+    LigneEtendu paquet[DAO_LIGNES_FLUSH];
+    while (ok && _idxFlush != _idxEtendu) {
+        // Paquet contigu dans le fichier : jusqu'a la tete ou la fin de l'anneau
+        int fin = (_idxEtendu > _idxFlush) ? _idxEtendu : DAO_NB_ETENDU;
+        int n = fin - _idxFlush;
+        if (n > DAO_LIGNES_FLUSH) n = DAO_LIGNES_FLUSH;
+        for (int k = 0; k < n; k++) {
+            paquet[k].date = _datesEtendu[_idxFlush + k];
+            for (int c = 0; c < NB_CANAUX; c++) paquet[k].valeurs[c] = _colEtendu[c][_idxFlush + k];
+        }
+        ok = f.seek(sizeof(EnteteEtendu) + _idxFlush * sizeof(LigneEtendu)) &&
+             f.write((const uint8_t*)paquet, n * sizeof(LigneEtendu)) == n * sizeof(LigneEtendu);
+        if (ok) _idxFlush = (_idxFlush + n) % DAO_NB_ETENDU;
+    }
+
+    // count : lignes valides jusqu'a _idxFlush (les suivantes ne sont pas ecrites)
+    e.idx = _idxFlush;
+    e.count = (_countEtendu < DAO_NB_ETENDU) ? _idxFlush : _countEtendu;
+    //! La NVS recoit chaque ligne avec l'anneau : la case NVS de _idxFlush est
+    //!   celle de la tete, moins les lignes pas encore ecrites
+    int nonEcrites = (_idxEtendu - _idxFlush + DAO_NB_ETENDU) % DAO_NB_ETENDU;
+    e.idxNvs = (_idx - nonEcrites % DAO_NB_MESURES + DAO_NB_MESURES) % DAO_NB_MESURES;
+    ok = ok && f.seek(0) && f.write((const uint8_t*)&e, sizeof(e)) == sizeof(e);
+    f.close();
+    return ok;
+}
+
+
+/**
+ * \brief Recherche sans tenir compte de la casse (la requete n'est pas recopiee)
+ */
+static const char* chercherMot(const char* texte, const char* mot) {
+    size_t n = strlen(mot);
+    for (; *texte; texte++)
+        if (strncasecmp(texte, mot, n) == 0) return texte;
+    return nullptr;
+}
+
+
+/**
+ * \brief Extrait la valeur : soit depuis du SQL, soit depuis une chaine brute
+ */
+int Dao::extractionValeur(const char* query) {
+    // Si c'est du SQL "VALUES (123)"
+    if (chercherMot(query, "VALUES")) {
+        const char* start = strrchr(query, '(');
+        const char* end = strrchr(query, ')');
+        if (start && end > start + 1) return (int)strtol(start + 1, nullptr, 10);
+    }
+
     // Sinon, on extrait juste les chiffres présents dans la chaîne
-    String numericPart = "";
-    for (size_t i = 0; i < query.length(); i++) {
-        if (isDigit(query[i])) numericPart += query[i];
+    long valeur = 0;
+    for (const char* p = query; *p; p++) {
+        if (isDigit(*p)) valeur = valeur * 10 + (*p - '0');
+    }
+    return (int)valeur;
+}
+
+
+/**
+ * \brief Extrait la liste "VALUES (a, b, c)" dans l'ordre des canaux
+ */
+int Dao::extractionValeurs(const char* query, int valeurs[], int nbMax) {
+    const char* start = strrchr(query, '(');
+    const char* end = strrchr(query, ')');
+    if (!chercherMot(query, "VALUES") || !start || !end || end <= start + 1) {
+        valeurs[0] = extractionValeur(query);
+        return 1;
     }
 
-    return (numericPart.length() > 0) ? numericPart.toInt() : 0;
+    int nb = 0;
+    const char* p = start + 1;
+    while (nb < nbMax && p < end) {
+        valeurs[nb++] = (int)strtol(p, nullptr, 10);   // espaces de tete ignores
+        const char* virgule = (const char*)memchr(p, ',', end - p);
+        if (!virgule) break;
+        p = virgule + 1;
+    }
+    return nb;
 }
     
 
 /**
  * \brief Intercepteur de requêtes SQL
- * On extrait la valeur numérique de la chaîne de caractères SQL
+ * On extrait les valeurs numériques de la chaîne de caractères SQL
  */
- bool Dao::execute(const char* sql) {
-    String query = String(sql);
-    query.toUpperCase();
-    
-    if (query.indexOf("INSERT INTO MESURES") != -1) {
-        // ... (extraction de la valeur comme avant) ...
-        int valeur = extractionValeur(query); 
+ bool Dao::execute(const char* sql, time_t date) {
+    if (chercherMot(sql, "INSERT INTO MESURES")) {
+        // Canaux absents de la requete : 0
+        int valeurs[NB_CANAUX] = {0};
+        extractionValeurs(sql, valeurs, NB_CANAUX);
+
+        // Date fournie par l'echantillonneur (au tick timer), sinon l'heure actuelle
+        time_t maintenant = (date != 0) ? date : time(NULL); 
 
-        // Capturer l'heure actuelle de l'horloge interne (calée au setup)
-        time_t maintenant = time(NULL); 
+        return stockerLigne(valeurs, maintenant);
+    }
+    return true;
+}
+
+
+/**
+ * \brief Ecrit une ligne : RAM (colonnes) puis NVS (une cle par cellule)
+ */
+bool Dao::stockerLigne(const int valeurs[NB_CANAUX], time_t date) {
+    char cle[8];
 
-        prefs.begin(_namespace, false);
-        int idx = prefs.getInt("idx", 0);
+    // Statistiques d'abord : la case ecrasee peut sortir d'une fenetre
+    int16_t ligne[NB_CANAUX];
+    for (int c = 0; c < NB_CANAUX; c++) ligne[c] = (int16_t)valeurs[c];
+    int pos = _datesEtendu ? _idxEtendu : _idx;
+    for (int f = 0; f < NB_FENETRES; f++) _fenetres[f].ajouter(pos, (int32_t)date, ligne);
 
-        // On stocke la valeur ET l'heure
-        prefs.putInt(("v" + String(idx)).c_str(), valeur);
-        prefs.putLong(("t" + String(idx)).c_str(), (long)maintenant); // Stockage du timestamp
+    _dates[_idx] = (int32_t)date;
+    for (int c = 0; c < NB_CANAUX; c++) _colonnes[c][_idx] = (int16_t)valeurs[c];
 
-        // On avance l'index (0 à 119 pour 1h de mesures)
-        prefs.putInt("idx", (idx + 1) % 120);
-        
-        int count = prefs.getInt("count", 0);
-        if (count < 120) prefs.putInt("count", count + 1);
+    prefs.begin(_namespace, false);
+
+    // On stocke les valeurs ET l'heure
+    for (int c = 0; c < NB_CANAUX; c++) {
+        snprintf(cle, sizeof(cle), "%c%d", CANAUX[c].prefixe, _idx);
+        prefs.putInt(cle, valeurs[c]);
+    }
+    snprintf(cle, sizeof(cle), "t%d", _idx);
+    prefs.putLong(cle, (long)date); // Stockage du timestamp
+
+    // On avance l'index (0 à 119 pour 1h de mesures), publie pour les lecteurs
+    bool plusUne = _count < DAO_NB_MESURES;
+    portENTER_CRITICAL(&_mux);
+    _idx = (_idx + 1) % DAO_NB_MESURES;
+    if (plusUne) _count++;
+    portEXIT_CRITICAL(&_mux);
+
+    prefs.putInt("idx", _idx);
+    if (plusUne) prefs.putInt("count", _count);
+
+    prefs.end();
 
-        prefs.end();
-        return true;
+    // Anneau etendu : RAM tout de suite, fichier par paquets
+    if (_datesEtendu) {
+        ajouterEtendu((int32_t)date, ligne);
+        int enAttente = (_idxEtendu - _idxFlush + DAO_NB_ETENDU) % DAO_NB_ETENDU;
+        if (enAttente >= DAO_LIGNES_FLUSH) flusher();
     }
+    publierStats();
     return true;
 }
 
  
 
 /**
- * \brief Méthode métier pour écrire
+ * \brief Méthode métier pour écrire (canal temperature seul)
  */
-bool Dao::accederTableMesure_ecrireUneMesure(int valeur_tdc) {
+bool Dao::accederTableMesure_ecrireUneMesure(int valeur_tdc, time_t date) {
     // On recrée la chaîne SQL que ton programme original attendait
-    String sql = "INSERT INTO mesures (valeur_tdc) VALUES (" + String(valeur_tdc) + ");";
-    return this->execute(sql.c_str());
+    char sql[64];
+    snprintf(sql, sizeof(sql), "INSERT INTO mesures (valeur_tdc) VALUES (%d);", valeur_tdc);
+    return this->execute(sql, date);
 }
 
 /**
- * \brief Méthode métier pour lire
+ * \brief Méthode métier pour écrire une ligne complete (tous les canaux)
+ */
+bool Dao::accederTableMesure_ecrireDesMesures(const int valeurs[NB_CANAUX], time_t date) {
+    // Requete sur la pile : 12 octets par valeur + le nom de chaque canal
+    char sql[48 + NB_CANAUX * 32];
+    size_t n = snprintf(sql, sizeof(sql), "INSERT INTO mesures (");
+    for (int c = 0; c < NB_CANAUX && n < sizeof(sql); c++)
+        n += snprintf(sql + n, sizeof(sql) - n, "%s%s", c ? ", " : "", CANAUX[c].nom);
+    if (n < sizeof(sql)) n += snprintf(sql + n, sizeof(sql) - n, ") VALUES (");
+    for (int c = 0; c < NB_CANAUX && n < sizeof(sql); c++)
+        n += snprintf(sql + n, sizeof(sql) - n, "%s%d", c ? ", " : "", valeurs[c]);
+    if (n < sizeof(sql)) snprintf(sql + n, sizeof(sql) - n, ");");
+    return this->execute(sql, date);
+}
+
+/**
+ * \brief Conversion d'un timestamp en "JJ/MM/AAAA HH:MM:SS"
+ */
+void Dao::formaterDate(time_t t, char* tampon, size_t taille) {
+    struct tm tm_info;
+    localtime_r(&t, &tm_info);
+    // %d/%m/%Y pour la date, %H:%M:%S pour l'heure
+    strftime(tampon, taille, "%d/%m/%Y %H:%M:%S", &tm_info);
+}
+
+/**
+ * \brief Méthode métier pour lire un canal
  * On retourne un vector pour rester compatible avec ton interface Web
+ * (Net passe par parcourirMesures(), sans allocation)
  */
- std::vector<Mesure> Dao::accederTableMesure_lireDesMesures(unsigned short int limit) {
+ std::vector<Mesure> Dao::accederTableMesure_lireDesMesures(unsigned short int limit, int canal) {
     std::vector<Mesure> liste;
-    prefs.begin(_namespace, true);
-    
-    int total = prefs.getInt("count", 0);
-    int idxActuel = prefs.getInt("idx", 0);
-    int aLire = (limit < total) ? limit : total;
-
-    for (int i = 0; i < aLire; i++) {
-        // On remonte le temps en partant de l'index actuel
-        int targetIdx = (idxActuel - 1 - i + 120) % 120;
-        
-        int val = prefs.getInt(("v" + String(targetIdx)).c_str());
-        time_t t = (time_t)prefs.getLong(("t" + String(targetIdx)).c_str());
-
-        // Conversion du timestamp en "HH:MM:SS"
-        struct tm * tm_info = localtime(&t);
-        char bufferDateCreation[30]; 
-        // 2. Change le format ( %d/%m/%Y pour la date, %H:%M:%S pour l'heure)
-        strftime(bufferDateCreation, 30, "%d/%m/%Y %H:%M:%S", tm_info);
-
-        liste.push_back(Mesure(targetIdx, String(bufferDateCreation), val));
-    }
-    
-    prefs.end();
+    liste.reserve((limit < nbMesures()) ? limit : nbMesures());
+    parcourirMesures(limit, canal, [&liste](const Mesure& m) { liste.push_back(m); });
     return liste;
 }
 
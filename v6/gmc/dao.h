@@ -7,6 +7,35 @@
  * \author : cgil
  *
  Note: on supprime Sqlite et ==> preferences
+
+ Stockage en colonnes : une colonne de dates partagee et un tableau
+ compact par canal (canaux.h). Les colonnes sont chargees en RAM au
+ begin() ; une lecture mono-canal ne touche que les dates et ce canal.
+ En NVS chaque cellule reste une cle "<prefixe><idx>" (ecriture d'une
+ ligne = quelques petites cles, pas de reecriture de gros blobs).
+
+ Anneau etendu (ESP32-S3 avec PSRAM) : les memes colonnes sur
+ DAO_NB_ETENDU lignes (7 jours a 30 s) allouees en PSRAM, qui deviennent
+ le niveau de lecture de l'historique. Il est ecrit par paquets de
+ DAO_LIGNES_FLUSH lignes dans un fichier LittleFS (lignes a leur place
+ dans l'anneau, puis entete) et recharge au begin(). Sans PSRAM (ou si
+ l'allocation echoue) on reste sur les 120 lignes de la NVS.
+ Les lignes pas encore flushees sont aussi dans la NVS : l'entete note la
+ case NVS qui suit la derniere ligne du fichier, et au begin() on reprend
+ les lignes NVS ecrites depuis. Reperage par position et non par date :
+ l'horloge repart de la date de compilation a chaque boot (gmc.ino).
+
+ Acces concurrents (voir taches.h) : une seule tache ecrit (stockage),
+ les routes Web lisent depuis l'autre coeur. L'ecrivain remplit la case
+ puis avance idx/count en section critique ; un lecteur prend un
+ instantane (idx, count) et ne lit que des cases deja publiees. Seul un
+ lecteur plus lent qu'un tour complet d'anneau pourrait voir une case
+ reecrite (2 min a 1 s pour la NVS, 5 h pour l'anneau PSRAM).
+
+ Statistiques glissantes (stats.h) : chaque fenetre est tenue a jour a
+ l'ecriture d'une ligne, sur l'anneau de lecture, et rejouee au begin().
+ Les fenetres sont datees par rapport a la derniere mesure. Les resumes
+ sont publies sous la meme section critique ; lireStats() les copie.
  
  */
 
@@ -15,30 +44,194 @@
 
 #include <Arduino.h>
 #include <Preferences.h>
+#include <freertos/FreeRTOS.h>
 #include <vector>
 #include "mesure.h"
+#include "canaux.h"
+#include "stats.h"
+
+//! Taille du buffer circulaire (120 mesures = 1 heure a 30 s)
+#define DAO_NB_MESURES 120
+
+//! Anneau etendu en PSRAM : 20160 mesures = 7 jours a 30 s (~200 Ko)
+#define DAO_NB_ETENDU       20160
+//! Lignes accumulees en PSRAM avant ecriture du fichier (10 min a 30 s)
+#define DAO_LIGNES_FLUSH    20
+#define DAO_FICHIER_ETENDU  "/mesures.bin"
+#define DAO_MAGIC_ETENDU    0x47444D32      //! "2MDG"
+
+//! Entete du fichier de l'anneau etendu, suivie de capacite lignes
+struct EnteteEtendu {
+    uint32_t magic;
+    uint16_t nbCanaux;
+    uint16_t tailleLigne;
+    uint32_t capacite;
+    uint32_t idx;           //! prochaine ligne a ecrire
+    uint32_t count;         //! lignes valides
+    uint32_t idxNvs;        //! case NVS qui suit la derniere ligne du fichier
+};
+
+//! Une ligne du fichier (en RAM l'anneau est en colonnes)
+struct LigneEtendu {
+    int32_t date;
+    int16_t valeurs[NB_CANAUX];
+};
 
 class Dao {
 private:
+    friend struct BancDao;      //! microbancs hote (host/microbench)
+
     Preferences prefs;
     const char* _namespace = "gmc_storage";
 
+    //! Colonnes en RAM : dates partagees + une colonne compacte par canal
+    int32_t _dates[DAO_NB_MESURES];
+    int16_t _colonnes[NB_CANAUX][DAO_NB_MESURES];
+    int _idx = 0;       //! prochaine case a ecrire
+    int _count = 0;     //! nombre de lignes valides
+
+    //! Anneau etendu en PSRAM (nullptr : pas de PSRAM, lecture sur la NVS)
+    int32_t* _datesEtendu = nullptr;
+    int16_t* _colEtendu[NB_CANAUX] = {};
+    int _idxEtendu = 0;
+    int _countEtendu = 0;
+    int _idxFlush = 0;      //! premiere ligne pas encore dans le fichier
+
+    //! Protege idx/count (publication d'une ligne, instantane des lecteurs)
+    mutable portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+    struct Instantane { int idx; int count; };
+    Instantane instantane() const {
+        portENTER_CRITICAL(&_mux);
+        Instantane s = _datesEtendu ? Instantane{ _idxEtendu, _countEtendu } : Instantane{ _idx, _count };
+        portEXIT_CRITICAL(&_mux);
+        return s;
+    }
+
     /**
-    @brief On extrait la valeur numérique de la chaîne de caractères SQL
+    @brief On extrait les valeurs numériques de la chaîne de caractères SQL
+           "VALUES (215, 480, 0)" ; retourne le nombre de valeurs lues
+           (lecture en place, sans copie de la requete)
     */
-    int extractionValeur (String query); 
+    int extractionValeurs (const char* query, int valeurs[], int nbMax);
+    int extractionValeur (const char* query); 
+
+    bool stockerLigne(const int valeurs[NB_CANAUX], time_t date);
+
+    //! Index de la i-eme ligne en remontant le temps (0 = la plus recente)
+    int indexLigne(int i) const { return (_idx - 1 - i + DAO_NB_MESURES) % DAO_NB_MESURES; }
+
+    //! Niveau de lecture : anneau etendu s'il existe, sinon colonnes NVS
+    //! (i-eme ligne en remontant le temps depuis l'instantane s)
+    int indexLecture(const Instantane& s, int i) const {
+        return (s.idx - 1 - i + capacite()) % capacite();
+    }
+    int32_t dateLigne(const Instantane& s, int i) const {
+        return _datesEtendu ? _datesEtendu[indexLecture(s, i)] : _dates[indexLecture(s, i)];
+    }
+    int16_t valeurLigne(const Instantane& s, int i, int canal) const {
+        return _datesEtendu ? _colEtendu[canal][indexLecture(s, i)] : _colonnes[canal][indexLecture(s, i)];
+    }
+
+    //! Date au format "JJ/MM/AAAA HH:MM:SS"
+    static void formaterDate(time_t t, char* tampon, size_t taille);
+
+    //! Allocation PSRAM, rechargement du fichier puis des lignes NVS ecrites depuis
+    bool ouvrirEtendu();
+    bool chargerFichierEtendu(int& idxNvs);
+    void ajouterEtendu(int32_t date, const int16_t valeurs[NB_CANAUX]);
+
+    //! Fenetres glissantes (tache stockage) et leurs resumes publies
+    FenetreStats _fenetres[NB_FENETRES];
+    ResumeStats _resumes[NB_FENETRES][NB_CANAUX] = {};
+    void ouvrirStats();
+    void publierStats();
 
 
 public:
     Dao(const char* path);
     bool begin();
     
-    // Intercepteur de requêtes SQL
-    bool execute(const char* sql);
+    // Intercepteur de requêtes SQL (date = 0 : heure courante)
+    bool execute(const char* sql, time_t date = 0);
 
     // Méthodes métier (signatures identiques à ton code d'origine)
-    bool accederTableMesure_ecrireUneMesure(int valeur_tdc);
-    std::vector<Mesure> accederTableMesure_lireDesMesures(unsigned short int limit);
+    bool accederTableMesure_ecrireUneMesure(int valeur_tdc, time_t date = 0);
+    bool accederTableMesure_ecrireDesMesures(const int valeurs[NB_CANAUX], time_t date = 0);
+    std::vector<Mesure> accederTableMesure_lireDesMesures(unsigned short int limit, int canal = CANAL_TEMP);
+
+    /**
+     * @brief Lecture sans allocation : fn(const Mesure&) est appelee pour les
+     *        limit dernieres mesures du canal, de la plus recente a la plus
+     *        ancienne (la Mesure est sur la pile). Pour les routes Web et
+     *        l'envoi cloud, qui n'ont pas besoin de garder la liste.
+     * @return nombre de mesures parcourues
+     */
+    template <typename F>
+    int parcourirMesures(unsigned short int limit, int canal, F fn) const {
+        return parcourirBrut(limit, canal, [&fn, canal](int i, int32_t t, int16_t v) {
+            char date[MESURE_TAILLE_DATE];
+            formaterDate((time_t)t, date, sizeof(date));
+            fn(Mesure(i, date, v, canal));
+        });
+    }
+
+    /**
+     * @brief Meme parcours, valeurs brutes : fn(i, date epoch, valeur)
+     *        (encodages binaires : la date n'est pas formatee)
+     */
+    template <typename F>
+    int parcourirBrut(int limit, int canal, F fn) const {
+        if (canal < 0 || canal >= NB_CANAUX) return 0;
+        Instantane s = instantane();
+        int aLire = (limit < s.count) ? limit : s.count;
+        for (int i = 0; i < aLire; i++) fn(i, dateLigne(s, i), valeurLigne(s, i, canal));
+        return aLire;
+    }
+
+    /**
+     * @brief Export : fn(date, valeurs[NB_CANAUX]) pour chaque ligne dont la
+     *        date est dans [depuis, jusqua], de la plus ancienne a la plus
+     *        recente (ordre d'ecriture), lecture en place : memoire constante.
+     *        Chaque ligne est testee : les dates ne sont pas croissantes dans
+     *        l'anneau, l'horloge repart de la date de compilation au boot.
+     * @return nombre de lignes parcourues
+     */
+    template <typename F>
+    int parcourirLignes(int32_t depuis, int32_t jusqua, F fn) const {
+        Instantane s = instantane();
+        int n = 0;
+        int16_t valeurs[NB_CANAUX];
+        for (int i = s.count - 1; i >= 0; i--) {
+            int32_t date = dateLigne(s, i);
+            if (date < depuis || date > jusqua) continue;
+            for (int c = 0; c < NB_CANAUX; c++) valeurs[c] = valeurLigne(s, i, c);
+            fn(date, valeurs);
+            n++;
+        }
+        return n;
+    }
+
+    //! Derniere valeur brute du canal (0 si aucune mesure)
+    int derniereValeur(int canal) const {
+        if (canal < 0 || canal >= NB_CANAUX) return 0;
+        Instantane s = instantane();
+        return s.count ? valeurLigne(s, 0, canal) : 0;
+    }
+
+    /**
+     * @brief Resume d'un canal sur la fenetre FENETRES_STATS[fenetre]
+     *        (copie du dernier resume publie, O(1))
+     * @return false si la fenetre ou le canal n'existe pas
+     */
+    bool lireStats(int fenetre, int canal, ResumeStats& r) const;
+
+    //! Ecrit dans le fichier les lignes de l'anneau etendu pas encore sauvees
+    bool flusher();
+
+    //! Profondeur d'historique disponible (anneau etendu ou NVS)
+    bool enPsram() const { return _datesEtendu != nullptr; }
+    int capacite() const { return _datesEtendu ? DAO_NB_ETENDU : DAO_NB_MESURES; }
+    int nbMesures() const { return instantane().count; }
     bool accederTableMesure_Creer();
 };
 
@@ -102,11 +102,14 @@ document.getElementById('uptimeBtn').addEventListener('click', () => {
 }
 */
 function triggerGPIO(statut) {
-    // On construit l'URL : /api/semaphore_on ou /api/semaphore_off
-    fetch('/api/piloter_gpio/semaphore_' + statut)
-        .then(response => response.text())
-        .then(txt => {
-            document.getElementById('responseField').innerText = "Etat : " + txt;
+    // Les 3 LEDs du semaphore (GPIO 40, 41, 42) en une seule ecriture :
+    // masque = broches concernees, valeur = niveau voulu pour chacune
+    const masque = '0x70000000000';
+    const valeur = (statut === 'on') ? masque : '0';
+    fetch(`/api/gpio?masque=${masque}&valeur=${valeur}`)
+        .then(response => response.json())
+        .then(data => {
+            document.getElementById('responseField').innerText = "Etat : " + data.niveaux;
         })
          .catch(err => console.error("Erreur pilotage :", err));
 }
@@ -0,0 +1,127 @@
+/**
+ * @brief   Code de la classe d'echantillonnage periodique (esp_timer)
+ * @file    echant.cpp
+ * @author  cgil
+   @version	1.0
+ * @date    mars 2026
+ */
+
+#include "echant.h"
+#include <sys/time.h>
+
+//! Derniere classe = tout ce qui depasse 100 ms
+const uint32_t Echantillonneur::BORNES_US[ECHANT_NB_CLASSES] =
+    {10, 50, 100, 500, 1000, 10000, 100000, UINT32_MAX};
+
+Echantillonneur::Echantillonneur() {
+    _file = xQueueCreate(ECHANT_TAILLE_FILE, sizeof(Echantillon));
+}
+
+Echantillonneur::~Echantillonneur() {
+    arreter();
+    if (_timer) esp_timer_delete(_timer);
+    if (_file) vQueueDelete(_file);
+}
+
+
+/**
+ * @brief Callback du timer : dater et deposer, rien d'autre
+ *     (tache esp_timer, prioritaire sur loop())
+ */
+void Echantillonneur::surTick(void* arg) {
+    Echantillonneur* self = static_cast<Echantillonneur*>(arg);
+
+    Echantillon e;
+    e.tickUs = esp_timer_get_time();
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    e.date = tv.tv_sec;
+    e.numero = self->_numero;
+    self->_numero = e.numero + 1;
+
+    //! File pleine : la tache principale est bloquee, on compte la perte
+    if (xQueueSend(self->_file, &e, 0) != pdTRUE) {
+        portENTER_CRITICAL(&self->_mux);
+        self->_pertes = self->_pertes + 1;
+        portEXIT_CRITICAL(&self->_mux);
+    }
+}
+
+
+/**
+ * @brief (Re)lance le timer periodique, la premiere mesure tombe a +periodeS
+ */
+bool Echantillonneur::demarrer(int periodeS) {
+    if (!_file || periodeS <= 0) return false;
+
+    if (!_timer) {
+        esp_timer_create_args_t args = {};
+        args.callback = &Echantillonneur::surTick;
+        args.arg = this;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = "echant";
+        if (esp_timer_create(&args, &_timer) != ESP_OK) return false;
+    }
+
+    arreter();
+    xQueueReset(_file);
+    portENTER_CRITICAL(&_mux);
+    _periodeS = periodeS;
+    _dernierTickUs = 0;
+    portEXIT_CRITICAL(&_mux);
+    return esp_timer_start_periodic(_timer, (uint64_t)periodeS * 1000000ULL) == ESP_OK;
+}
+
+void Echantillonneur::arreter() {
+    if (_timer) esp_timer_stop(_timer);
+}
+
+
+bool Echantillonneur::lire(Echantillon& e, TickType_t attente) {
+    if (!_file || xQueueReceive(_file, &e, attente) != pdTRUE) return false;
+
+    int64_t maintenant = esp_timer_get_time();
+
+    //! Quelques comparaisons : la section critique reste tres courte
+    portENTER_CRITICAL(&_mux);
+    if (maintenant - e.tickUs > _latenceMaxUs) _latenceMaxUs = maintenant - e.tickUs;
+
+    //! Jitter periode a periode sur les dates capturees au tick
+    if (_dernierTickUs != 0) {
+        int64_t ecart = (e.tickUs - _dernierTickUs) - (int64_t)_periodeS * 1000000LL;
+        if (ecart < 0) ecart = -ecart;
+        if (ecart > _jitterMaxUs) _jitterMaxUs = ecart;
+
+        int classe = 0;
+        while (classe < ECHANT_NB_CLASSES - 1 && (uint64_t)ecart >= BORNES_US[classe]) classe++;
+        _histo[classe]++;
+    }
+    _dernierTickUs = e.tickUs;
+    _nbEchantillons++;
+    portEXIT_CRITICAL(&_mux);
+    return true;
+}
+
+void Echantillonneur::razStats() {
+    portENTER_CRITICAL(&_mux);
+    for (int i = 0; i < ECHANT_NB_CLASSES; i++) _histo[i] = 0;
+    _jitterMaxUs = 0;
+    _latenceMaxUs = 0;
+    _nbEchantillons = 0;
+    _pertes = 0;
+    portEXIT_CRITICAL(&_mux);
+}
+
+int64_t Echantillonneur::getJitterMaxUs() {
+    portENTER_CRITICAL(&_mux);
+    int64_t v = _jitterMaxUs;
+    portEXIT_CRITICAL(&_mux);
+    return v;
+}
+
+int64_t Echantillonneur::getLatenceMaxUs() {
+    portENTER_CRITICAL(&_mux);
+    int64_t v = _latenceMaxUs;
+    portEXIT_CRITICAL(&_mux);
+    return v;
+}
@@ -0,0 +1,83 @@
+/**
+ * @brief   Classe d'echantillonnage periodique cadence par esp_timer
+ * @file    echant.h
+ * @author  cgil
+   @version	1.0
+ * @date    mars 2026
+ *
+ * Le callback du timer ne fait que dater l'echantillon (esp_timer_get_time()
+ * et heure murale) et le deposer dans une file FreeRTOS : la date ne depend
+ * plus de la duree de la boucle loop(). Le jitter est calcule a la lecture
+ * a partir des dates capturees, sans partage de donnees avec le callback.
+ *
+ * Les statistiques sont mises a jour par lire() (tache acquisition, coeur 1)
+ * et remises a zero par razStats() (tache web, coeur 0) : les deux passent
+ * par une section critique (_mux), comme la lecture des maxima 64 bits.
+ */
+
+#ifndef ECHANT_H
+#define ECHANT_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+//! Profondeur de la file timer -> tache principale
+#define ECHANT_TAILLE_FILE  8
+
+//! Histogramme du jitter periode a periode (bornes hautes en µs)
+#define ECHANT_NB_CLASSES   8
+
+/**
+ * @brief Echantillon date au moment du tick timer
+ */
+struct Echantillon {
+    int64_t tickUs;     //! esp_timer_get_time() au tick
+    time_t date;        //! heure murale au tick (calee par /api/sync_time)
+    uint32_t numero;    //! numero de tick depuis demarrer()
+};
+
+class Echantillonneur {
+private:
+    esp_timer_handle_t _timer = nullptr;
+    QueueHandle_t _file = nullptr;
+    int _periodeS = 0;
+
+    //! Ecrits par le callback timer (_pertes aussi par razStats(), sous _mux)
+    volatile uint32_t _numero = 0;
+    volatile uint32_t _pertes = 0;
+
+    //! Statistiques : lire() (acquisition, voir taches.h) et razStats() (web)
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+    int64_t _dernierTickUs = 0;
+    uint32_t _nbEchantillons = 0;
+    uint32_t _histo[ECHANT_NB_CLASSES] = {0};
+    int64_t _jitterMaxUs = 0;
+    int64_t _latenceMaxUs = 0;
+
+    static void surTick(void* arg);
+
+public:
+    static const uint32_t BORNES_US[ECHANT_NB_CLASSES];
+
+    Echantillonneur();
+    ~Echantillonneur();
+
+    bool demarrer(int periodeS);
+    void arreter();
+    int getPeriodeS() const { return _periodeS; }
+
+    //! Recupere un echantillon (attente en ticks, 0 = non bloquant) et met a jour le jitter
+    bool lire(Echantillon& e, TickType_t attente = 0);
+
+    uint32_t getNbEchantillons() const { return _nbEchantillons; }
+    uint32_t getPertes() const { return _pertes; }
+    //! 64 bits : lus sous _mux (pas d'ecriture a moitie vue de l'autre coeur)
+    int64_t getJitterMaxUs();
+    int64_t getLatenceMaxUs();
+    const uint32_t* getHistogramme() const { return _histo; }
+    void razStats();
+};
+
+#endif
@@ -26,6 +26,53 @@
 
         - Release Pour Debug Wifi en mode Hybride
 
+        - Connexion WiFi en tache de fond (net->gererWifi()) : reconnexion avec backoff,
+          retour en mode hybride AP+STA quand la Box revient, metriques sur /api/wifi
+
+        - Echantillonnage cadence par esp_timer (echant.h/cpp) : date prise au tick,
+          histogramme du jitter sur /api/echant
+
+        - Multi-canaux (canaux.h) : temperature, humidite, alarme TOR stockes en colonnes,
+          /api/history?ch=hum et un envoi cloud par canal
+
+        - Telemetrie (telem.h/cpp) : histogramme de loop(), latence max par route,
+          tas/fragmentation et marges de pile sur /api/telemetrie
+
+        - Config : seules les cles modifiees sont ecrites, les abonnes (Conf::abonner)
+          appliquent freq, URL cloud et identifiants Box sans reboot.
+          Parametres decrits par la table PARAMS_CONF (conf.h)
+
+        - JSON des routes et de l'envoi cloud ecrit dans un tampon fixe (jsonfixe.h),
+          sans JsonDocument ni String ; chunked au-dela de NET_TAMPON_JSON
+
+        - Memoire : plus de String dans Dao, Mesure, Net et setup (tampons fixes sur
+          la pile), lecture des mesures sans vector (Dao::parcourirMesures) ;
+          endurance du tas verifiee sur hote (host/soak, make soak)
+
+        - Historique etendu en PSRAM (ESP32-S3) : 7 jours en colonnes, ecrit par paquets
+          dans /mesures.bin (LittleFS) ; /api/history?n= ; sans PSRAM : 120 lignes NVS
+
+        - Taches FreeRTOS (taches.h/cpp) : acquisition et stockage sur le coeur 1, web et
+          uplink sur le coeur 0, files bornees ; charge par tache sur /api/telemetrie
+
+        - Statistiques glissantes (stats.h/cpp) : min, max, moyenne, ecart-type par canal
+          sur 5 min, 1 h, 24 h, tenus a jour a chaque ligne ; /api/stats?ch= en O(1)
+
+        - Alarmes (alarmes.h/cpp) : seuils avec hysteresis, pente, capteur fige, evalues a
+          chaque echantillon ; voyant, semaphore GPIO 40/41/42 et push cloud immediat
+          (tache alerte) ; etat et latence sur /api/alarmes
+
+        - Export /api/export?format=csv|ndjson&from=&to= : tout l'historique stocke, en flux
+          chunked a memoire constante (debit mesure par host/bench/bench_export)
+
+        - CBOR (cborfixe.h) : /api/history en binaire (Accept: application/cbor ou
+          ?format=cbor, dates et valeurs en deltas, ~3 octets par mesure) et envoi cloud
+          d'une ligne en un seul POST (cloud_format=cbor) ; decodeur dans client.py
+
+        - Sorties GPIO (sorties.h/cpp) : /api/gpio?masque=&valeur= ecrit toutes les broches
+          en une fois (registres set/clear), ?seq=m:v:ms,...&rep= rejoue une sequence
+          temporisee par esp_timer ; remplace /api/piloter_gpio/semaphore_on|off
+
 *
 * 
 *
@@ -71,6 +118,14 @@ CONFIGURATION DU MODE RESEAU :
 	conf.h/cpp (Réglages JSON)
 	dao.h/cpp (Gestion des mesures)
 	net.h/cpp (Serveur Web & WiFi)
+	echant.h/cpp (Echantillonnage periodique par timer)
+	canaux.h (Canaux de mesure declares a la compilation)
+	telem.h/cpp (Telemetrie : boucle web, routes, tas, piles, charge par tache)
+	taches.h/cpp (Taches FreeRTOS : acquisition, stockage, web, uplink, alerte)
+	stats.h/cpp (Statistiques glissantes par canal et par fenetre)
+	alarmes.h/cpp (Regles d'alarme, voyant, semaphore)
+	sorties.h/cpp (Sorties GPIO : ecriture groupee set/clear, sequences temporisees)
+	jsonfixe.h, cborfixe.h (Ecriture JSON et CBOR en tampon fixe)
 	dbg.h/cpp (Mode hybride et outils de test)
 *
 */
@@ -83,6 +138,12 @@ CONFIGURATION DU MODE RESEAU :
 #include "net.h"
 #include "dao.h"
 #include "mesure.h"
+#include "echant.h"
+#include "telem.h"
+#include "taches.h"
+#include "alarmes.h"
+#include "sorties.h"
+#include "canaux.h"
 #include "dbg.h"
 
 //! Objets globaux via pointeurs
@@ -91,6 +152,11 @@ WebServer webServer(80);
 Conf* conf=nullptr; 
 Dao* dao = nullptr;
 Net* net = nullptr;
+Echantillonneur* echant = nullptr;
+Telemetrie* telem = nullptr;
+Taches* taches = nullptr;
+Alarmes* alarmes = nullptr;
+Sorties* sorties = nullptr;
 
 
 
@@ -98,10 +164,11 @@ Net* net = nullptr;
  * @brief : declaration des fonctions internes
  */
 void setLED(int, int, int); //! Simplication couleur LED
+void setLED(const char*);   //! Couleur par nom
 bool syncDateTime();        //! Synchro Date Time
 void detectResetConf();     //! Reset parametres conf
-void simulMesures();        //! Simule une mesure par freq
-void stopSetup(String);     //! Stopper setup si erreurs
+void acquerirMesures(int valeurs[NB_CANAUX]); //! Une valeur par canal
+void stopSetup(const char*); //! Stopper setup si erreurs
 
 
 void setup() {
@@ -110,6 +177,9 @@ void setup() {
     Serial.begin(115200);
     Serial.println("\n\n🚀 Demarrage Programme GMC-ESP32");
 
+    //! Telemetrie en premier : les routes s'y enregistrent
+    telem = new Telemetrie();
+
     //! conf : parametres
     Serial.print("conf ..."); 
     conf = new Conf();
@@ -153,8 +223,41 @@ void setup() {
         stopSetup("Erreur : Système Réseau & Web");
     }
 
-    //! Pilotage GPIO : test avec 3 leds semaphore
-    pinMode(40, OUTPUT); pinMode(41, OUTPUT); pinMode(42, OUTPUT);
+    //! Pilotage GPIO : sorties de SORTIES[] commandees en groupe par /api/gpio ;
+    //! le semaphore suit le moteur d'alarmes (une commande web force jusqu'au prochain changement)
+    sorties = new Sorties();
+    if (!sorties->begin()) stopSetup("Erreur : Sorties");
+    alarmes = new Alarmes();
+    alarmes->begin();
+
+    //! Entree TOR du canal alarme
+    pinMode(PIN_ALARME, INPUT_PULLUP);
+
+    //! Echantillonnage cadence par esp_timer (independant de la duree de loop())
+    //! demarre en dernier pour que le premier tick ne subisse pas les delais du setup
+    Serial.print("Echantillonneur ...");
+    echant = new Echantillonneur();
+    if (echant->demarrer(conf->getFrequenceMesures()))
+        Serial.println("✅");
+    else
+        stopSetup("Erreur : Echantillonneur");
+
+    //! Frequence changee dans la config : on recale le timer tout de suite
+    conf->abonner(CONF_FREQ, [](MasqueConf) {
+        echant->demarrer(conf->getFrequenceMesures());
+    });
+
+    //! Pile de la tache esp_timer (callbacks de l'echantillonneur)
+    TaskHandle_t tacheTimer = xTaskGetHandle("esp_timer");
+    if (tacheTimer) telem->surveillerTache(tacheTimer, "esp_timer");
+
+    //! Taches epinglees (voir taches.h) : loop() ne garde que le bouton BOOT
+    Serial.print("Taches ...");
+    taches = new Taches();
+    if (taches->demarrer())
+        Serial.println("✅");
+    else
+        stopSetup("Erreur : Taches");
 
     // --- Infos Reset Config ---
      Serial.println("\n⚠️ Appui long 5s bouton boot en clignotant rouge pour reset config ⚠️\n");
@@ -166,18 +269,14 @@ void setup() {
 
 
 
+/**
+ * @brief : Web, WiFi, mesures, stockage et cloud tournent dans leurs taches
+ *          (taches.h) ; la tache loop() ne surveille plus que le bouton
+ */
 void loop() {
-    // 1. Gérer les requêtes Web (Toujours en priorité)
-    webServer.handleClient();
-
-    // 2. Surveillance du bouton "boot" 5s pour reset conf (Non-bloquant)
+    // Surveillance du bouton "boot" 5s pour reset conf (Non-bloquant)
     detectResetConf();
-
-    // 3. Gestion de l'échantillonnage des mesures
-    simulMesures();
-
-    // 4. Gestion envoi data dans le cloud
-    net->gererEnvoiDataCloud();
+    vTaskDelay(pdMS_TO_TICKS(50));
 }
 
 
@@ -217,26 +316,13 @@ void detectResetConf() {
 }
 
 /**
- * @brief : Simule ou enregistre une mesure selon la fréquence définie en config
+ * @brief : Acquisition de tous les canaux declares dans canaux.h
+ *          (temperature et humidite simulees, alarme sur entree TOR)
  */
-void simulMesures() {
-    static unsigned long lastUpdate = 0;
-    
-    // On récupère dynamiquement la fréquence depuis la config
-    unsigned long intervalle = conf->getFrequenceMesures() * 1000;
-
-    if (millis() - lastUpdate >= intervalle) { 
-        lastUpdate = millis();
-        
-        // petit Flash vie
-        setLED("blanc");delay(100);setLED("orange");delay(200);setLED("vert");
-        
-        // Simulation de mesure
-        int val = random(180, 260);
-        if(dao->accederTableMesure_ecrireUneMesure(val)) {
-           Serial.printf("🌡️ Mesure simulee : %d\n", val);
-        }
-    }
+void acquerirMesures(int valeurs[NB_CANAUX]) {
+    valeurs[CANAL_TEMP]   = random(180, 260);
+    valeurs[CANAL_HUM]    = random(350, 650);
+    valeurs[CANAL_ALARME] = (digitalRead(PIN_ALARME) == LOW) ? 1 : 0;
 }
 
 /**
@@ -248,16 +334,16 @@ void setLED(int r, int g, int b) {
 /** @brief : Simplication couleur LED
     vert(0,128,0) vert bouteille( 9, 106, 9) 
 */
-void setLED(String color) {
-    if (!color.compareTo("")) neopixelWrite(RGB_BUILTIN, 255, 0, 0); // erreur rouge
-    else if (!color.compareTo("rouge")) neopixelWrite(RGB_BUILTIN, 255, 0, 0); 
-    else if (!color.compareTo("orange")) neopixelWrite(RGB_BUILTIN, 30, 5, 0); 
-    else if (!color.compareTo("vert")) neopixelWrite(RGB_BUILTIN, 9, 106, 9); 
-    else if (!color.compareTo("blanc")) neopixelWrite(RGB_BUILTIN, 0, 0, 0); 
-    else if (!color.compareTo("jaune")) neopixelWrite(RGB_BUILTIN, 255, 255, 0); 
-    else if (!color.compareTo("gris")) neopixelWrite(RGB_BUILTIN, 206, 206, 206); 
-    else if (!color.compareTo("violet")) neopixelWrite(RGB_BUILTIN, 128, 0, 128); 
-    else if (!color.compareTo("noir")) neopixelWrite(RGB_BUILTIN, 30, 5, 0); 
+void setLED(const char* color) {
+    if (!strcmp(color, "")) neopixelWrite(RGB_BUILTIN, 255, 0, 0); // erreur rouge
+    else if (!strcmp(color, "rouge")) neopixelWrite(RGB_BUILTIN, 255, 0, 0); 
+    else if (!strcmp(color, "orange")) neopixelWrite(RGB_BUILTIN, 30, 5, 0); 
+    else if (!strcmp(color, "vert")) neopixelWrite(RGB_BUILTIN, 9, 106, 9); 
+    else if (!strcmp(color, "blanc")) neopixelWrite(RGB_BUILTIN, 0, 0, 0); 
+    else if (!strcmp(color, "jaune")) neopixelWrite(RGB_BUILTIN, 255, 255, 0); 
+    else if (!strcmp(color, "gris")) neopixelWrite(RGB_BUILTIN, 206, 206, 206); 
+    else if (!strcmp(color, "violet")) neopixelWrite(RGB_BUILTIN, 128, 0, 128); 
+    else if (!strcmp(color, "noir")) neopixelWrite(RGB_BUILTIN, 30, 5, 0); 
     else neopixelWrite(RGB_BUILTIN, 255, 0, 0); // erreur rouge 
 }
 
@@ -266,7 +352,7 @@ void setLED(String color) {
 @brief fonction de sécurité dans le setup 
     allume la LED en rouge et bloque tout
 */
-void stopSetup(String message) {
+void stopSetup(const char* message) {
     setLED("rouge"); 
     Serial.println("\n!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!");
     Serial.print("❌ ERREUR CRITIQUE : ");
@@ -0,0 +1,127 @@
+/**
+ * @brief   Banc hote : taille et debit JSON contre CBOR (history et cloud)
+ * @file    bench_cbor.cpp
+ * @author  cgil
+ * @date    avril 2026
+ *
+ * Memes encodages que Net :
+ *   - history : {"v":21.5,"t":"jj/mm/aaaa hh:mm:ss"} par mesure (JSON)
+ *               contre {"canal","echelle","d":[t0,v0,dt,dv,...]} (CBOR, deltas)
+ *               pour 120 mesures (NVS) et 20160 (anneau PSRAM), a 30 s
+ *   - cloud   : une ligne de NB_CANAUX canaux, un POST JSON par canal
+ *               contre un seul POST CBOR pour la ligne
+ * Pour chacun : octets, octets par mesure et temps d'encodage.
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#include "jsonfixe.h"
+#include "cborfixe.h"
+#include "dao.h"
+
+#define PERIODE_S 30
+
+static volatile size_t puits = 0;       //! empeche l'optimiseur de tout supprimer
+static size_t compterJson(void*, const char*, size_t n) { puits += n; return n; }
+static void viderJson(void* ctx, const char* d, size_t n) { compterJson(ctx, d, n); }
+static void viderCbor(void*, const uint8_t*, size_t n) { puits += n; }
+
+static int valeur(int i) { return 180 + (i * 7) % 80; }
+
+static size_t historyJson(int nb) {
+    char tampon[512];
+    JsonFixe j(tampon, sizeof(tampon), viderJson, nullptr);
+    j.tableau();
+    time_t t0 = 1790000000;
+    for (int i = 0; i < nb; i++) {
+        char date[20];
+        time_t t = t0 - i * PERIODE_S;
+        struct tm tm_info;
+        localtime_r(&t, &tm_info);
+        strftime(date, sizeof(date), "%d/%m/%Y %H:%M:%S", &tm_info);
+        j.objet();
+        j.cle("v").fixe(valeur(i), 10);
+        j.champ("t", date);
+        j.fin();
+    }
+    j.fin();
+    j.vider();
+    return j.total();
+}
+
+static size_t historyCbor(int nb) {
+    uint8_t tampon[512];
+    CborFixe c(tampon, sizeof(tampon), viderCbor, nullptr);
+    c.map(3).champ("canal", "temp").champ("echelle", 10);
+    c.cle("d").tableau();
+    int32_t t0 = 1790000000, tPrec = 0;
+    int vPrec = 0;
+    for (int i = 0; i < nb; i++) {
+        int32_t t = t0 - i * PERIODE_S;
+        int v = valeur(i);
+        c.entier(i ? (long long)t - tPrec : t);
+        c.entier(i ? v - vPrec : v);
+        tPrec = t;
+        vPrec = v;
+    }
+    c.fin();
+    c.vider();
+    return c.total();
+}
+
+static size_t cloudJson() {
+    size_t total = 0;
+    int valeurs[NB_CANAUX] = { 215, 480, 0 };
+    for (int c = 0; c < NB_CANAUX; c++) {
+        char corps[96];
+        JsonFixe json(corps, sizeof(corps));
+        json.objet().champ("canal", CANAUX[c].nom).champ(CANAUX[c].nom, valeurs[c]).champ("voyant", false).fin();
+        total += json.longueur();
+        puits += json.c_str()[0];
+    }
+    return total;
+}
+
+static size_t cloudCbor() {
+    int valeurs[NB_CANAUX] = { 215, 480, 0 };
+    uint8_t corps[32 + NB_CANAUX * 24];
+    CborFixe cbor(corps, sizeof(corps));
+    cbor.map(2 + NB_CANAUX).champ("t", (long long)1790000000).champ("voyant", false);
+    for (int c = 0; c < NB_CANAUX; c++) cbor.champ(CANAUX[c].nom, valeurs[c]);
+    puits += corps[0];
+    return cbor.longueur();
+}
+
+template <typename F>
+static double nsPar(F fn, int repetitions) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; r++) fn();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / repetitions;
+}
+
+static void ligne(const char* nom, int nbMesures, size_t oJson, double nsJson, size_t oCbor, double nsCbor) {
+    printf("%-14s | %9zu o %6.1f o/m %10.0f ns | %9zu o %6.1f o/m %10.0f ns | taille /%.1f  %s x%.1f\n",
+           nom, oJson, (double)oJson / nbMesures, nsJson, oCbor, (double)oCbor / nbMesures, nsCbor,
+           (double)oJson / oCbor, nsCbor < nsJson ? "vitesse" : "lenteur",
+           nsCbor < nsJson ? nsJson / nsCbor : nsCbor / nsJson);
+}
+
+int main() {
+    setenv("TZ", "Europe/Paris", 1);
+    tzset();
+
+    printf("charge         | JSON                                   | CBOR                                   |\n");
+    for (int nb : { DAO_NB_MESURES, DAO_NB_ETENDU }) {
+        int rep = nb > 1000 ? 20 : 2000;
+        size_t oj = historyJson(nb), oc = historyCbor(nb);
+        double nj = nsPar([nb] { historyJson(nb); }, rep);
+        double nc = nsPar([nb] { historyCbor(nb); }, rep);
+        char nom[32];
+        snprintf(nom, sizeof(nom), "history %d", nb);
+        ligne(nom, nb, oj, nj, oc, nc);
+    }
+    size_t oj = cloudJson(), oc = cloudCbor();
+    ligne("cloud (ligne)", NB_CANAUX, oj, nsPar(cloudJson, 100000), oc, nsPar(cloudCbor, 100000));
+    printf("cloud : %d POST JSON par ligne contre 1 POST CBOR (en-tetes HTTP en plus a chaque POST)\n", NB_CANAUX);
+    return 0;
+}
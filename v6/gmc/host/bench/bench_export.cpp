@@ -0,0 +1,114 @@
+/**
+ * @brief   Banc hote : debit de /api/export (CSV et NDJSON)
+ * @file    bench_export.cpp
+ * @author  cgil
+ * @date    avril 2026
+ *
+ * Lance le module complet (setup()), arrete l'echantillonneur puis remplit
+ * l'anneau etendu du Dao (DAO_NB_ETENDU lignes a 30 s, 7 jours) et
+ * telecharge l'export par HTTP sur localhost, comme un technicien sur le
+ * softAP. Pour chaque format :
+ *   - octets, lignes et duree d'un export complet, debit en octets/s
+ *   - allocations du tas pour 100 lignes et pour tout l'anneau : egales si
+ *     la memoire est constante (seul le serveur web alloue)
+ *   - projection pour un mois de mesures a 30 s
+ *
+ * Rapport sur stderr, traces du module dans build/bench/bench_export.log.
+ * Le debit hote est un plafond cote module : sur la cible, le lien WiFi
+ * du softAP limite avant la generation des lignes.
+ */
+
+#include <Arduino.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include "dao.h"
+#include "echant.h"
+
+extern Dao* dao;
+extern Echantillonneur* echant;
+void setup();
+
+#define PERIODE_S      30
+#define LIGNES_MOIS    (31L * 24 * 3600 / PERIODE_S)
+
+static int port = 0;
+
+//! GET complet (lecture jusqu'a la fermeture) ; retourne les octets recus
+static size_t telecharger(const char* uri) {
+    int s = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in a{};
+    a.sin_family = AF_INET;
+    a.sin_port = htons(port);
+    a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(s, (sockaddr*)&a, sizeof(a)) < 0) { close(s); return 0; }
+
+    char req[256];
+    int n = snprintf(req, sizeof(req), "GET %s HTTP/1.1\r\nHost: gmc\r\nConnection: close\r\n\r\n", uri);
+    send(s, req, n, 0);
+
+    static char buf[16384];
+    size_t total = 0;
+    ssize_t lu;
+    while ((lu = recv(s, buf, sizeof(buf), 0)) > 0) total += lu;
+    close(s);
+    return total;
+}
+
+static void mesurer(const char* format, int32_t debut, int32_t fin) {
+    char uri[128];
+
+    // Memoire : 100 lignes puis tout l'anneau
+    snprintf(uri, sizeof(uri), "/api/export?format=%s&from=%ld&to=%ld", format, (long)(fin - 99 * PERIODE_S), (long)fin);
+    unsigned long a0 = tasHoteNbAllocations();
+    telecharger(uri);
+    unsigned long allocsPetit = tasHoteNbAllocations() - a0;
+
+    snprintf(uri, sizeof(uri), "/api/export?format=%s&from=%ld&to=%ld", format, (long)debut, (long)fin);
+    uint32_t blocAvant = tasHotePlusGrandBloc();
+    a0 = tasHoteNbAllocations();
+    auto t0 = std::chrono::steady_clock::now();
+    size_t octets = telecharger(uri);
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    unsigned long allocsTout = tasHoteNbAllocations() - a0;
+
+    int lignes = dao->nbMesures();
+    double parLigne = (double)octets / lignes;
+    fprintf(stderr, "%-7s %8d lignes %9zu octets %6.1f o/ligne %8.3f s %8.2f Mo/s | allocs 100 l. %lu, %d l. %lu | bloc max %u -> %u\n",
+           format, lignes, octets, parLigne, s, octets / s / 1e6, allocsPetit, lignes, allocsTout,
+           blocAvant, tasHotePlusGrandBloc());
+    fprintf(stderr, "        mois a %d s (%ld lignes) : %.1f Mo, %.1f s au debit hote\n",
+           PERIODE_S, LIGNES_MOIS, parLigne * LIGNES_MOIS / 1e6, parLigne * LIGNES_MOIS / (octets / s));
+}
+
+int main() {
+    setenv("GMC_DELAI_ECHELLE", "0", 0);
+    //! le WebServer global lit GMC_HTTP_PORT avant main() : fixe par make bench
+    const char* envPort = getenv("GMC_HTTP_PORT");
+    port = envPort ? atoi(envPort) : 8080;
+
+    //! traces du module dans un journal, le rapport sort sur stderr
+    freopen("build/bench/bench_export.log", "w", stdout);
+    setup();
+    echant->arreter();          //! le banc est seul ecrivain du Dao
+    delay(100);
+
+    // Anneau plein : DAO_NB_ETENDU lignes espacees de 30 s, finissant maintenant
+    int32_t fin = (int32_t)time(NULL);
+    int32_t debut = fin - (int32_t)(dao->capacite() - 1) * PERIODE_S;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < dao->capacite(); i++) {
+        int valeurs[NB_CANAUX] = { 180 + i % 80, 350 + i % 300, (i % 500) == 0 };
+        dao->accederTableMesure_ecrireDesMesures(valeurs, debut + i * PERIODE_S);
+    }
+    double remplissage = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    fprintf(stderr, "\nremplissage : %d lignes en %.1f s (%s)\n", dao->nbMesures(), remplissage,
+            dao->enPsram() ? "anneau PSRAM" : "NVS seule");
+
+    mesurer("csv", debut, fin);
+    mesurer("ndjson", debut, fin);
+    fflush(stdout);
+    _exit(0);
+}
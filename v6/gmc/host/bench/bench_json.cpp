@@ -0,0 +1,150 @@
+/**
+ * @brief   Banc hote : JsonDocument + String contre JsonFixe (tampon fixe)
+ * @file    bench_json.cpp
+ * @author  cgil
+ * @date    avril 2026
+ *
+ * Trois charges representatives de Net :
+ *   - cloud   : {"canal":"temp","temp":215,"voyant":false} (sendToCloud ;
+ *               l'ancienne methode envoyait "temp":215.00)
+ *   - status  : /api/status (derniere mesure + canaux + uptime)
+ *   - history : /api/history, 120 mesures {"v":21.5,"t":"jj/mm/aaaa hh:mm:ss"}
+ * Pour chacune : temps par serialisation et allocations par serialisation
+ * (compteur du tas simule, shims/tas_host.cpp), ancienne methode puis JsonFixe.
+ *
+ * La colonne ArduinoJson n'est mesuree qu'avec la vraie bibliotheque
+ * (make bench ARDUINOJSON_DIR=...) : le stand-in de shims/ n'a pas son
+ * cout, sans elle seule la colonne JsonFixe est affichee.
+ */
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <chrono>
+#include "jsonfixe.h"
+
+#define NB_MESURES 120
+
+//! Comparaison seulement contre la vraie ArduinoJson (elle definit sa version)
+#ifdef ARDUINOJSON_VERSION
+#define BENCH_ANCIEN 1
+#else
+#define BENCH_ANCIEN 0
+#endif
+
+static const char* DATE = "19/10/2026 14:03:27";
+static int valeurs[NB_MESURES];
+static volatile size_t puits = 0;       //! empeche l'optimiseur de tout supprimer
+
+//! ---- Ancienne methode (telle que dans net.cpp avant JsonFixe) ----
+
+static void cloudString() {
+    float valeur = 215;
+    bool etatVoyant = false;
+    const char* nom = "temp";
+    String json = "{";
+    json += "\"canal\":\"" + String(nom) + "\",";
+    json += "\"" + String(nom) + "\":" + String(valeur) + ",";
+    json += "\"voyant\":" + String(etatVoyant ? "true" : "false");
+    json += "}";
+    puits += json.length();
+}
+
+static void statusDoc() {
+    JsonDocument doc;
+    doc["temp"] = valeurs[0];
+    doc["date"] = String(DATE);
+    JsonObject canaux = doc["canaux"].to<JsonObject>();
+    canaux["temp"] = valeurs[0];
+    canaux["hum"] = valeurs[1];
+    canaux["alarme"] = 0;
+    doc["uptime"] = 12345UL;
+    String response;
+    serializeJson(doc, response);
+    puits += response.length();
+}
+
+static void historyDoc() {
+    JsonDocument doc;
+    JsonArray history = doc.to<JsonArray>();
+    for (int i = 0; i < NB_MESURES; i++) {
+        JsonObject obj = history.add<JsonObject>();
+        obj["v"] = valeurs[i] / (float)10;
+        obj["t"] = String(DATE);
+    }
+    String response;
+    serializeJson(doc, response);
+    puits += response.length();
+}
+
+//! ---- JsonFixe (tampon de la pile, envoi par morceaux pour history) ----
+
+static void versSocket(void*, const char* data, size_t n) { puits += n + (data[0] != 0); }
+
+static void cloudFixe() {
+    char corps[96];
+    JsonFixe json(corps, sizeof(corps));
+    json.objet().champ("canal", "temp").champ("temp", 215).champ("voyant", false).fin();
+    puits += json.longueur();
+}
+
+static void statusFixe() {
+    char tampon[512];
+    JsonFixe j(tampon, sizeof(tampon));
+    j.objet();
+    j.champ("temp", valeurs[0]);
+    j.champ("date", DATE);
+    j.objet("canaux").champ("temp", valeurs[0]).champ("hum", valeurs[1]).champ("alarme", 0).fin();
+    j.champ("uptime", 12345UL);
+    j.fin();
+    puits += j.longueur();
+}
+
+static void historyFixe() {
+    char tampon[512];
+    JsonFixe j(tampon, sizeof(tampon), versSocket, nullptr);
+    j.tableau();
+    for (int i = 0; i < NB_MESURES; i++) {
+        j.objet();
+        j.cle("v").fixe(valeurs[i], 10);
+        j.champ("t", DATE);
+        j.fin();
+    }
+    j.fin();
+    j.vider();
+    puits += j.total();
+}
+
+static void mesurer(const char* nom, void (*ancien)(), void (*fixe)(), int iterations) {
+    void (*fns[2])() = { ancien, fixe };
+    double ns[2];
+    double allocs[2];
+    for (int k = BENCH_ANCIEN ? 0 : 1; k < 2; k++) {
+        fns[k]();                                   // chauffe
+        unsigned long a0 = tasHoteNbAllocations();
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) fns[k]();
+        auto t1 = std::chrono::steady_clock::now();
+        ns[k] = std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+        allocs[k] = (double)(tasHoteNbAllocations() - a0) / iterations;
+    }
+    if (BENCH_ANCIEN)
+        printf("%-8s | %10.0f ns %8.1f allocs | %10.0f ns %8.1f allocs | x%.1f\n",
+               nom, ns[0], allocs[0], ns[1], allocs[1], ns[0] / ns[1]);
+    else
+        printf("%-8s | %-30s | %10.0f ns %8.1f allocs |\n", nom, "-", ns[1], allocs[1]);
+}
+
+int main() {
+    for (int i = 0; i < NB_MESURES; i++) valeurs[i] = 180 + (i * 37) % 80;
+
+#ifdef ARDUINOJSON_VERSION
+    printf("ArduinoJson %s\n", ARDUINOJSON_VERSION);
+#else
+    printf("ArduinoJson : ARDUINOJSON_DIR non defini, comparaison sautee (make bench ARDUINOJSON_DIR=...)\n");
+#endif
+    printf("%-8s | %-30s | %-30s |\n", "charge", "JsonDocument + String", "JsonFixe");
+    mesurer("cloud",   cloudString, cloudFixe,   200000);
+    mesurer("status",  statusDoc,   statusFixe,  200000);
+    mesurer("history", historyDoc,  historyFixe, 5000);
+    return puits == 0;
+}
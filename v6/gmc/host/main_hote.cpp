@@ -0,0 +1,21 @@
+/**
+ * @brief   Point d'entree hote : setup() puis loop() comme le coeur Arduino
+ * @file    main_hote.cpp
+ * @author  cgil
+ * @date    2026
+ */
+
+#include <Arduino.h>
+
+void setup();
+void loop();
+
+int main() {
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+    setup();
+    for (;;) {
+        loop();
+        // Sur l'ESP32 la tache loop() cede la main au watchdog ; ici on evite 100 % CPU
+        delayMicroseconds(200);
+    }
+}
@@ -0,0 +1,174 @@
+/**
+ * @brief   Microbancs hote (Google Benchmark) des fonctions chaudes du module
+ * @file    micro_gmc.cpp
+ * @author  cgil
+ * @date    avril 2026
+ *
+ * Chaque banc appelle directement le code gmc, contre les stand-ins de
+ * shims/ (Preferences en memoire, LittleFS dans un repertoire de build,
+ * WebServer servi en memoire par appeler()) :
+ *   - Dao    : extractionValeur, extractionValeurs, execute (INSERT complet),
+ *              accederTableMesure_lireDesMesures(1) et (120)
+ *   - Net    : /api/status, /api/history JSON et CBOR (route complete,
+ *              en-tetes HTTP compris)
+ *   - Conf   : begin() (relecture de l'emplacement actif) et
+ *              modifier() + valider() (commit A/B complet)
+ * Compteur "allocs" : allocations du tas simule par iteration
+ * (shims/tas_host.cpp), 0 attendu sur les chemins sans String ni vector.
+ *
+ *   make microbench                          (console)
+ *   make microbench MICROBENCH_ARGS="--benchmark_format=json --benchmark_out=avant.json"
+ * puis comparer deux JSON avec compare.py de Google Benchmark.
+ */
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+#include "conf.h"
+#include "dao.h"
+#include "net.h"
+#include "telem.h"
+
+extern WebServer webServer;
+extern Conf* conf;
+extern Dao* dao;
+extern Net* net;
+extern Telemetrie* telem;
+
+#define PERIODE_S 30
+
+/**
+ * @brief Acces aux methodes privees de Dao (ami declare dans dao.h)
+ */
+struct BancDao {
+    static int extractionValeur(Dao& d, const char* q) { return d.extractionValeur(q); }
+    static int extractionValeurs(Dao& d, const char* q, int v[], int n) { return d.extractionValeurs(q, v, n); }
+};
+
+//! Allocations du tas simule pendant l'iteration, en moyenne
+static void compterAllocs(benchmark::State& state, unsigned long depart) {
+    state.counters["allocs"] = benchmark::Counter((double)(tasHoteNbAllocations() - depart),
+                                                  benchmark::Counter::kAvgIterations);
+}
+
+// ---- Dao ----
+
+static void BM_Dao_extractionValeur(benchmark::State& state) {
+    unsigned long a0 = tasHoteNbAllocations();
+    for (auto _ : state) benchmark::DoNotOptimize(BancDao::extractionValeur(*dao, "INSERT INTO MESURES VALUES (215)"));
+    compterAllocs(state, a0);
+}
+BENCHMARK(BM_Dao_extractionValeur);
+
+static void BM_Dao_extractionValeurs(benchmark::State& state) {
+    int valeurs[NB_CANAUX];
+    unsigned long a0 = tasHoteNbAllocations();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BancDao::extractionValeurs(*dao, "INSERT INTO MESURES VALUES (215, 480, 0)", valeurs, NB_CANAUX));
+        benchmark::ClobberMemory();
+    }
+    compterAllocs(state, a0);
+}
+BENCHMARK(BM_Dao_extractionValeurs);
+
+//! Ligne complete : analyse, stats glissantes, colonnes NVS et anneau PSRAM
+static void BM_Dao_execute(benchmark::State& state) {
+    time_t t = time(NULL);
+    unsigned long a0 = tasHoteNbAllocations();
+    for (auto _ : state) benchmark::DoNotOptimize(dao->execute("INSERT INTO MESURES VALUES (215, 480, 0)", t += PERIODE_S));
+    compterAllocs(state, a0);
+}
+BENCHMARK(BM_Dao_execute);
+
+static void BM_Dao_lireDesMesures(benchmark::State& state) {
+    unsigned short n = (unsigned short)state.range(0);
+    unsigned long a0 = tasHoteNbAllocations();
+    for (auto _ : state) benchmark::DoNotOptimize(dao->accederTableMesure_lireDesMesures(n, CANAL_TEMP));
+    compterAllocs(state, a0);
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Dao_lireDesMesures)->Arg(1)->Arg(DAO_NB_MESURES);
+
+// ---- Net (route complete servie en memoire) ----
+
+static void routeNet(benchmark::State& state, const char* uri, const char* requete) {
+    size_t octets = 0;
+    unsigned long a0 = tasHoteNbAllocations();
+    for (auto _ : state) octets = webServer.appeler(HTTP_GET, uri, requete);
+    compterAllocs(state, a0);
+    state.counters["octets"] = (double)octets;
+    state.SetBytesProcessed(state.iterations() * octets);
+}
+
+static void BM_Net_status(benchmark::State& state) { routeNet(state, "/api/status", nullptr); }
+BENCHMARK(BM_Net_status);
+
+static void BM_Net_history(benchmark::State& state) { routeNet(state, "/api/history", "ch=temp"); }
+BENCHMARK(BM_Net_history);
+
+static void BM_Net_history_cbor(benchmark::State& state) { routeNet(state, "/api/history", "ch=temp&format=cbor"); }
+BENCHMARK(BM_Net_history_cbor);
+
+// ---- Conf ----
+
+static void BM_Conf_begin(benchmark::State& state) {
+    Conf c;
+    unsigned long a0 = tasHoteNbAllocations();
+    for (auto _ : state) benchmark::DoNotOptimize(c.begin());
+    compterAllocs(state, a0);
+}
+BENCHMARK(BM_Conf_begin);
+
+//! Une valeur modifiee a chaque tour : chaque valider() ecrit un emplacement
+static void BM_Conf_valider(benchmark::State& state) {
+    Conf c;
+    c.begin();
+    bool bascule = false;
+    unsigned long a0 = tasHoteNbAllocations();
+    for (auto _ : state) {
+        c.modifier(PARAM_FREQ, (bascule = !bascule) ? "31" : "30");
+        benchmark::DoNotOptimize(c.valider());
+    }
+    compterAllocs(state, a0);
+}
+BENCHMARK(BM_Conf_valider);
+
+
+/**
+ * @brief Module monte sans setup() : ni taches, ni timers, ni socket ;
+ *        seuls les objets des bancs et les routes existent
+ */
+int main(int argc, char** argv) {
+    setenv("GMC_DELAI_ECHELLE", "0", 0);
+
+    //! traces du montage dans un journal, stdout rendu au rapport ensuite
+    fflush(stdout);
+    int console = dup(STDOUT_FILENO);
+    freopen("build/microbench/micro_gmc.log", "w", stdout);
+
+    telem = new Telemetrie();
+    conf = new Conf();
+    conf->begin();
+    dao = new Dao("/littlefs/gmc.db");
+    dao->begin();
+    net = new Net(webServer, conf);
+    net->setupRoutes();
+
+    // Historique plein : une heure de lignes a 30 s
+    time_t t = time(NULL) - DAO_NB_MESURES * PERIODE_S;
+    for (int i = 0; i < DAO_NB_MESURES; i++) {
+        int valeurs[NB_CANAUX] = { 180 + i % 80, 350 + i % 300, 0 };
+        dao->accederTableMesure_ecrireDesMesures(valeurs, t += PERIODE_S);
+    }
+    fflush(stdout);
+    dup2(console, STDOUT_FILENO);
+    close(console);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    fflush(stdout);
+    _exit(0);
+}
@@ -0,0 +1,137 @@
+/**
+ * @brief   Stand-in hote du coeur Arduino/ESP32 pour compiler gmc sous Linux
+ * @file    Arduino.h
+ * @author  cgil
+ * @date    2026
+ *
+ * Seul ce qu'utilise le module gmc est fourni : temps, GPIO simules,
+ * Serial vers stdout, objet ESP et LED RGB.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdarg>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <sys/time.h>
+#include <algorithm>
+
+#include "WString.h"
+
+#define HIGH 1
+#define LOW  0
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+#define RGB_BUILTIN  48
+
+typedef uint8_t byte;
+
+// --- Temps ---
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// --- Aleatoire ---
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+// --- GPIO simules (etat lisible par les outils hote) ---
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void neopixelWrite(uint8_t pin, uint8_t r, uint8_t g, uint8_t b);
+
+//! newlib (ESP32) fournit strlcpy / strlcat, pas la glibc < 2.38
+#if !defined(__GLIBC__) || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38)
+inline size_t strlcpy(char* dst, const char* src, size_t taille) {
+    size_t n = strlen(src);
+    if (taille) {
+        size_t c = (n >= taille) ? taille - 1 : n;
+        memcpy(dst, src, c);
+        dst[c] = 0;
+    }
+    return n;
+}
+inline size_t strlcat(char* dst, const char* src, size_t taille) {
+    size_t d = strnlen(dst, taille);
+    if (d == taille) return taille + strlen(src);
+    return d + strlcpy(dst + d, src, taille - d);
+}
+#endif
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+// --- Adresse IP ---
+class IPAddress {
+private:
+    uint8_t o[4];
+public:
+    IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : o{a, b, c, d} {}
+    String toString() const {
+        char buf[16]; snprintf(buf, sizeof(buf), "%u.%u.%u.%u", o[0], o[1], o[2], o[3]);
+        return String(buf);
+    }
+};
+
+// --- Serial vers stdout ---
+class HostSerial {
+public:
+    void begin(unsigned long) {}
+    size_t print(const String& s) { return fwrite(s.c_str(), 1, s.length(), stdout); }
+    size_t print(const char* s) { return fputs(s, stdout) >= 0 ? strlen(s) : 0; }
+    size_t print(char c) { return fputc(c, stdout) != EOF; }
+    size_t print(int v) { return printf("%d", v); }
+    size_t print(unsigned int v) { return printf("%u", v); }
+    size_t print(long v) { return printf("%ld", v); }
+    size_t print(unsigned long v) { return printf("%lu", v); }
+    size_t print(unsigned long long v) { return printf("%llu", v); }
+    size_t print(double v) { return printf("%.2f", v); }
+    size_t print(const IPAddress& ip) { return print(ip.toString()); }
+    template <typename T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+    size_t println() { fputc('\n', stdout); fflush(stdout); return 1; }
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        va_list ap; va_start(ap, fmt); int n = vprintf(fmt, ap); va_end(ap);
+        return n < 0 ? 0 : (size_t)n;
+    }
+    operator bool() const { return true; }
+};
+extern HostSerial Serial;
+
+// --- Objet ESP ---
+class EspClass {
+public:
+    uint64_t getEfuseMac() { return 0x0000A1B2C3D4E5F6ULL; }
+    void restart();
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getHeapSize();
+    uint32_t getMaxAllocHeap();
+    uint32_t getPsramSize();
+    uint32_t getFreePsram();
+};
+extern EspClass ESP;
+
+// --- PSRAM (esp32-hal-psram) : GMC_PSRAM_KO (defaut 8192, 0 = carte sans PSRAM) ---
+bool psramFound();
+void* ps_malloc(size_t taille);
+
+// --- Tas simule (tas_host.cpp) : operator new/delete sur une arene de 320 Ko ---
+uint32_t tasHoteTaille();
+uint32_t tasHoteLibre();
+uint32_t tasHoteMinLibre();
+uint32_t tasHotePlusGrandBloc();
+unsigned long tasHoteNbAllocations();
+unsigned long tasHoteNbLiberations();
+unsigned long tasHoteNbEchecs();      //! arene pleine (repli sur malloc)
+//! Portee dont les allocations ne sont pas dans le tas de la cible (flash simulee)
+struct HorsTasHote { HorsTasHote(); ~HorsTasHote(); };
+
+#endif
@@ -0,0 +1,290 @@
+/**
+ * @brief   Stand-in hote minimal d'ArduinoJson 7 (sous-ensemble utilise par gmc)
+ * @file    ArduinoJson.h
+ * @author  cgil
+ * @date    2026
+ *
+ * Pour compiler contre la vraie bibliotheque : make ARDUINOJSON_DIR=.../ArduinoJson/src
+ * (le Makefile place alors ce repertoire avant les shims).
+ */
+
+#ifndef HOST_ARDUINOJSON_H
+#define HOST_ARDUINOJSON_H
+
+#include <Arduino.h>
+#include <memory>
+#include <vector>
+#include <string>
+
+namespace hostjson {
+
+struct Noeud {
+    enum Type { NUL, BOOL, ENTIER, REEL, TEXTE, OBJET, TABLEAU } type = NUL;
+    bool b = false;
+    bool simple = false;    // reel stocke en float (7 chiffres significatifs)
+    long long i = 0;
+    double d = 0;
+    std::string s;
+    std::vector<std::pair<std::string, std::unique_ptr<Noeud>>> membres;
+    std::vector<std::unique_ptr<Noeud>> elements;
+
+    Noeud* membre(const char* cle) {
+        if (type != OBJET) { *this = Noeud(); type = OBJET; }
+        for (auto& m : membres) if (m.first == cle) return m.second.get();
+        membres.emplace_back(cle, std::unique_ptr<Noeud>(new Noeud()));
+        return membres.back().second.get();
+    }
+    Noeud* ajouter() {
+        if (type != TABLEAU) { *this = Noeud(); type = TABLEAU; }
+        elements.emplace_back(new Noeud());
+        return elements.back().get();
+    }
+    const Noeud* chercher(const char* cle) const {
+        if (type != OBJET) return nullptr;
+        for (auto& m : membres) if (m.first == cle) return m.second.get();
+        return nullptr;
+    }
+    Noeud& operator=(Noeud&& o) = default;
+
+    void ecrire(std::string& out) const;
+    bool lire(const char*& p);
+};
+
+}  // namespace hostjson
+
+class JsonObject;
+class JsonArray;
+
+//! Lecture seule (resultat de deserializeJson)
+class JsonVariantConst {
+protected:
+    const hostjson::Noeud* _n;
+public:
+    explicit JsonVariantConst(const hostjson::Noeud* n = nullptr) : _n(n) {}
+    JsonVariantConst operator[](const char* cle) const { return JsonVariantConst(_n ? _n->chercher(cle) : nullptr); }
+    bool isNull() const { return _n == nullptr || _n->type == hostjson::Noeud::NUL; }
+    template <typename T> bool is() const;
+    template <typename T> T as() const;
+};
+
+class JsonObjectConst : public JsonVariantConst {
+public:
+    explicit JsonObjectConst(const hostjson::Noeud* n = nullptr) : JsonVariantConst(n) {}
+};
+
+template <> inline bool JsonVariantConst::is<const char*>() const { return _n && _n->type == hostjson::Noeud::TEXTE; }
+template <> inline bool JsonVariantConst::is<int>() const { return _n && _n->type == hostjson::Noeud::ENTIER; }
+template <> inline bool JsonVariantConst::is<JsonObjectConst>() const { return _n && _n->type == hostjson::Noeud::OBJET; }
+template <> inline const char* JsonVariantConst::as<const char*>() const { return is<const char*>() ? _n->s.c_str() : nullptr; }
+template <> inline long long JsonVariantConst::as<long long>() const {
+    if (!_n) return 0;
+    switch (_n->type) {
+        case hostjson::Noeud::ENTIER: return _n->i;
+        case hostjson::Noeud::REEL: return (long long)_n->d;
+        case hostjson::Noeud::BOOL: return _n->b;
+        case hostjson::Noeud::TEXTE: return atoll(_n->s.c_str());
+        default: return 0;
+    }
+}
+template <> inline int JsonVariantConst::as<int>() const { return (int)as<long long>(); }
+template <> inline long JsonVariantConst::as<long>() const { return (long)as<long long>(); }
+template <> inline JsonObjectConst JsonVariantConst::as<JsonObjectConst>() const { return JsonObjectConst(is<JsonObjectConst>() ? _n : nullptr); }
+
+class JsonVariant {
+protected:
+    hostjson::Noeud* _n;
+public:
+    explicit JsonVariant(hostjson::Noeud* n = nullptr) : _n(n) {}
+    JsonVariant operator[](const char* cle) { return JsonVariant(_n->membre(cle)); }
+    JsonVariant operator[](const String& cle) { return (*this)[cle.c_str()]; }
+
+    JsonVariant& operator=(bool v) { reset(); _n->type = hostjson::Noeud::BOOL; _n->b = v; return *this; }
+    JsonVariant& operator=(int v) { return entier(v); }
+    JsonVariant& operator=(unsigned int v) { return entier(v); }
+    JsonVariant& operator=(long v) { return entier(v); }
+    JsonVariant& operator=(unsigned long v) { return entier((long long)v); }
+    JsonVariant& operator=(long long v) { return entier(v); }
+    JsonVariant& operator=(unsigned long long v) { return entier((long long)v); }
+    JsonVariant& operator=(float v) { reel(v); _n->simple = true; return *this; }
+    JsonVariant& operator=(double v) { return reel(v); }
+    JsonVariant& operator=(const char* v) {
+        reset();
+        if (v) { _n->type = hostjson::Noeud::TEXTE; _n->s = v; }
+        return *this;
+    }
+    JsonVariant& operator=(const String& v) { return (*this = v.c_str()); }
+
+    template <typename T> T to();
+    template <typename T> T add();
+    template <typename T> T as() const { return JsonVariantConst(_n).as<T>(); }
+    operator JsonVariantConst() const { return JsonVariantConst(_n); }
+
+private:
+    void reset() { *_n = hostjson::Noeud(); }
+    JsonVariant& entier(long long v) { reset(); _n->type = hostjson::Noeud::ENTIER; _n->i = v; return *this; }
+    JsonVariant& reel(double v) { reset(); _n->type = hostjson::Noeud::REEL; _n->d = v; return *this; }
+    friend class JsonDocument;
+};
+
+class JsonObject : public JsonVariant {
+public:
+    explicit JsonObject(hostjson::Noeud* n = nullptr) : JsonVariant(n) {}
+    operator JsonObjectConst() const { return JsonObjectConst(_n); }
+};
+
+class JsonArray : public JsonVariant {
+public:
+    explicit JsonArray(hostjson::Noeud* n = nullptr) : JsonVariant(n) {}
+    template <typename T> T add() { return T(_n->ajouter()); }
+    template <typename T> bool add(const T& v) { JsonVariant e(_n->ajouter()); e = v; return true; }
+    size_t size() const { return _n->elements.size(); }
+};
+
+template <> inline JsonArray JsonVariant::to<JsonArray>() { reset(); _n->type = hostjson::Noeud::TABLEAU; return JsonArray(_n); }
+template <> inline JsonObject JsonVariant::to<JsonObject>() { reset(); _n->type = hostjson::Noeud::OBJET; return JsonObject(_n); }
+template <> inline JsonObject JsonVariant::add<JsonObject>() { return JsonObject(_n->ajouter()); }
+
+class JsonDocument : public JsonVariant {
+private:
+    std::unique_ptr<hostjson::Noeud> _racine;
+public:
+    JsonDocument() : JsonVariant(nullptr), _racine(new hostjson::Noeud()) { _n = _racine.get(); }
+    hostjson::Noeud* racine() const { return _racine.get(); }
+};
+
+inline size_t serializeJson(const JsonDocument& doc, String& out) {
+    std::string s;
+    doc.racine()->ecrire(s);
+    out = String(s);
+    return s.size();
+}
+
+inline size_t measureJson(const JsonDocument& doc) {
+    std::string s;
+    doc.racine()->ecrire(s);
+    return s.size();
+}
+
+class DeserializationError {
+public:
+    enum Code { Ok, InvalidInput, EmptyInput };
+    DeserializationError(Code c = Ok) : _c(c) {}
+    explicit operator bool() const { return _c != Ok; }
+    const char* c_str() const { return _c == Ok ? "Ok" : (_c == EmptyInput ? "EmptyInput" : "InvalidInput"); }
+private:
+    Code _c;
+};
+
+inline DeserializationError deserializeJson(JsonDocument& doc, const char* texte) {
+    if (texte == nullptr || *texte == 0) return DeserializationError::EmptyInput;
+    const char* p = texte;
+    *doc.racine() = hostjson::Noeud();
+    return doc.racine()->lire(p) ? DeserializationError::Ok : DeserializationError::InvalidInput;
+}
+inline DeserializationError deserializeJson(JsonDocument& doc, const String& texte) { return deserializeJson(doc, texte.c_str()); }
+
+//! Analyse recursive simple (echappements unicode limites a l'ASCII)
+inline bool hostjson::Noeud::lire(const char*& p) {
+    auto blancs = [&p]() { while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++; };
+    auto chaine = [&p](std::string& out) {
+        if (*p != '"') return false;
+        p++;
+        while (*p && *p != '"') {
+            if (*p == '\\' && p[1]) {
+                p++;
+                switch (*p) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'r': out += '\r'; break;
+                    case 'u': out += (char)strtol(std::string(p + 1, 4).c_str(), nullptr, 16); p += 4; break;
+                    default: out += *p;
+                }
+                p++;
+            } else out += *p++;
+        }
+        if (*p != '"') return false;
+        p++;
+        return true;
+    };
+    blancs();
+    if (*p == '{') {
+        p++; type = OBJET; blancs();
+        if (*p == '}') { p++; return true; }
+        while (true) {
+            std::string cle;
+            blancs();
+            if (!chaine(cle)) return false;
+            blancs();
+            if (*p++ != ':') return false;
+            membres.emplace_back(cle, std::unique_ptr<Noeud>(new Noeud()));
+            if (!membres.back().second->lire(p)) return false;
+            blancs();
+            if (*p == ',') { p++; continue; }
+            if (*p == '}') { p++; return true; }
+            return false;
+        }
+    }
+    if (*p == '[') {
+        p++; type = TABLEAU; blancs();
+        if (*p == ']') { p++; return true; }
+        while (true) {
+            elements.emplace_back(new Noeud());
+            if (!elements.back()->lire(p)) return false;
+            blancs();
+            if (*p == ',') { p++; continue; }
+            if (*p == ']') { p++; return true; }
+            return false;
+        }
+    }
+    if (*p == '"') { type = TEXTE; return chaine(s); }
+    if (strncmp(p, "true", 4) == 0) { type = BOOL; b = true; p += 4; return true; }
+    if (strncmp(p, "false", 5) == 0) { type = BOOL; b = false; p += 5; return true; }
+    if (strncmp(p, "null", 4) == 0) { type = NUL; p += 4; return true; }
+    char* fin;
+    double v = strtod(p, &fin);
+    if (fin == p) return false;
+    bool reelLu = false;
+    for (const char* c = p; c < fin; c++) if (*c == '.' || *c == 'e' || *c == 'E') reelLu = true;
+    if (reelLu) { type = REEL; d = v; } else { type = ENTIER; i = strtoll(p, nullptr, 10); }
+    p = fin;
+    return true;
+}
+
+inline void hostjson::Noeud::ecrire(std::string& out) const {
+    char buf[40];
+    switch (type) {
+        case NUL: out += "null"; break;
+        case BOOL: out += b ? "true" : "false"; break;
+        case ENTIER: out += std::to_string(i); break;
+        case REEL: snprintf(buf, sizeof(buf), simple ? "%.7g" : "%.15g", d); out += buf; break;
+        case TEXTE:
+            out += '"';
+            for (char c : s) {
+                if (c == '"' || c == '\\') { out += '\\'; out += c; }
+                else if (c == '\n') out += "\\n";
+                else if ((unsigned char)c < 0x20) { snprintf(buf, sizeof(buf), "\\u%04x", c); out += buf; }
+                else out += c;
+            }
+            out += '"';
+            break;
+        case OBJET:
+            out += '{';
+            for (size_t k = 0; k < membres.size(); k++) {
+                if (k) out += ',';
+                out += '"'; out += membres[k].first; out += "\":";
+                membres[k].second->ecrire(out);
+            }
+            out += '}';
+            break;
+        case TABLEAU:
+            out += '[';
+            for (size_t k = 0; k < elements.size(); k++) {
+                if (k) out += ',';
+                elements[k]->ecrire(out);
+            }
+            out += ']';
+            break;
+    }
+}
+
+#endif
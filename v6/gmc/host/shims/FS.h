@@ -0,0 +1,77 @@
+/**
+ * @brief   Stand-in hote de fs::FS / fs::File sur un repertoire Linux
+ * @file    FS.h
+ * @author  cgil
+ * @date    2026
+ */
+
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include <Arduino.h>
+#include <memory>
+#include <vector>
+#include <string>
+
+namespace fs {
+
+class File {
+private:
+    struct Etat;
+    std::shared_ptr<Etat> _e;
+
+public:
+    File() {}
+    explicit File(std::shared_ptr<Etat> e) : _e(e) {}
+
+    operator bool() const;
+    const char* name() const;
+    const char* path() const;
+    size_t size() const;
+    bool isDirectory() const;
+    int available();
+    int read();
+    size_t read(uint8_t* buf, size_t size);
+    size_t readBytes(char* buf, size_t size) { return read((uint8_t*)buf, size); }
+    size_t write(const uint8_t* buf, size_t size);
+    size_t print(const String& s) { return write((const uint8_t*)s.c_str(), s.length()); }
+    bool seek(uint32_t pos);
+    size_t position() const;
+    void flush();
+    void close();
+    File openNextFile();
+
+    friend class FS;
+};
+
+class FS {
+protected:
+    std::string _racine;
+
+public:
+    explicit FS(const char* racine = "data") : _racine(racine) {}
+    void setRacine(const char* racine) { _racine = racine; }
+    const std::string& racine() const { return _racine; }
+
+    File open(const char* path, const char* mode = "r", bool create = false);
+    File open(const String& path, const char* mode = "r", bool create = false) {
+        return open(path.c_str(), mode, create);
+    }
+    bool exists(const char* path);
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path);
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* from, const char* to);
+    bool mkdir(const char* path);
+};
+
+}  // namespace fs
+
+using fs::FS;
+using fs::File;
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+#endif
@@ -0,0 +1,41 @@
+/**
+ * @brief   Stand-in hote de HTTPClient : le cloud est simule en memoire
+ * @file    HTTPClient.h
+ * @author  cgil
+ * @date    2026
+ *
+ * Chaque POST est compte et le dernier corps est conserve, ce qui permet
+ * aux outils hote de verifier ce que le module enverrait.
+ */
+
+#ifndef HOST_HTTPCLIENT_H
+#define HOST_HTTPCLIENT_H
+
+#include <Arduino.h>
+#include <vector>
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+
+class HTTPClient {
+private:
+    String _url;
+    String _reponse;
+
+public:
+    bool begin(const String& url) { _url = url; return url.startsWith("http"); }
+    void addHeader(const String&, const String&) {}
+    void setTimeout(uint16_t) {}
+    void setReuse(bool) {}
+    int GET();
+    int POST(const String& payload) { return POST((const uint8_t*)payload.c_str(), payload.length()); }
+    int POST(const uint8_t* payload, size_t size);
+    String getString() { return _reponse; }
+    void end() {}
+
+    // --- Outils hote ---
+    static unsigned long nbRequetes();
+    static unsigned long nbOctetsEnvoyes();
+    static std::vector<uint8_t> dernierCorps();
+};
+
+#endif
@@ -0,0 +1,25 @@
+/**
+ * @brief   Stand-in hote de LittleFS : un repertoire Linux (GMC_DATA_DIR, defaut "data")
+ * @file    LittleFS.h
+ * @author  cgil
+ * @date    2026
+ */
+
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+#include "FS.h"
+
+class LittleFSFS : public fs::FS {
+public:
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs",
+               uint8_t maxOpenFiles = 10, const char* partitionLabel = "spiffs");
+    void end() {}
+    bool format();
+    size_t totalBytes();
+    size_t usedBytes();
+};
+
+extern LittleFSFS LittleFS;
+
+#endif
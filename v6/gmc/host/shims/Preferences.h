@@ -0,0 +1,58 @@
+/**
+ * @brief   Stand-in hote de Preferences (NVS) : namespaces en memoire
+ * @file    Preferences.h
+ * @author  cgil
+ * @date    2026
+ *
+ * Si la variable d'environnement GMC_NVS_FICHIER est definie, le contenu
+ * est recharge au demarrage et reecrit a chaque end() en ecriture
+ * (survit donc a ESP.restart()).
+ * Les compteurs d'ecritures permettent de mesurer l'usure flash.
+ */
+
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include <Arduino.h>
+#include <vector>
+
+class Preferences {
+private:
+    String _ns;
+    bool _ouvert = false;
+    bool _lectureSeule = true;
+
+public:
+    bool begin(const char* name, bool readOnly = false, const char* partition = nullptr);
+    void end();
+
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+
+    size_t putInt(const char* key, int32_t value);
+    size_t putUInt(const char* key, uint32_t value);
+    size_t putLong(const char* key, int32_t value);
+    size_t putULong(const char* key, uint32_t value);
+    size_t putUChar(const char* key, uint8_t value);
+    size_t putString(const char* key, const char* value);
+    size_t putString(const char* key, const String& value);
+    size_t putBytes(const char* key, const void* value, size_t len);
+
+    int32_t getInt(const char* key, int32_t defaultValue = 0);
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
+    int32_t getLong(const char* key, int32_t defaultValue = 0);
+    uint32_t getULong(const char* key, uint32_t defaultValue = 0);
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0);
+    String getString(const char* key, const String& defaultValue = String());
+    size_t getString(const char* key, char* value, size_t maxLen);
+    size_t getBytesLength(const char* key);
+    size_t getBytes(const char* key, void* buf, size_t maxLen);
+
+    // --- Outils hote ---
+    static unsigned long nbEcritures();     //! put* effectifs depuis le lancement
+    static unsigned long nbLectures();      //! get* depuis le lancement
+    static void effacerTout();
+};
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * @brief   Stand-in hote de la classe String Arduino (au-dessus de std::string)
+ * @file    WString.h
+ * @author  cgil
+ * @date    2026
+ */
+
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cctype>
+#include <ostream>
+
+#define HEX 16
+#define DEC 10
+
+class String {
+private:
+    std::string s;
+
+public:
+    String() {}
+    String(const char* c) : s(c ? c : "") {}
+    String(const std::string& v) : s(v) {}
+    String(char c) : s(1, c) {}
+    String(int v, unsigned char base = DEC) { fromLong(v, base); }
+    String(unsigned int v, unsigned char base = DEC) { fromULong(v, base); }
+    String(long v, unsigned char base = DEC) { fromLong(v, base); }
+    String(unsigned long v, unsigned char base = DEC) { fromULong(v, base); }
+    String(long long v, unsigned char base = DEC) { fromLong(v, base); }
+    String(unsigned long long v, unsigned char base = DEC) { fromULong(v, base); }
+    String(float v, unsigned int decimals = 2) { fromDouble(v, decimals); }
+    String(double v, unsigned int decimals = 2) { fromDouble(v, decimals); }
+
+    const char* c_str() const { return s.c_str(); }
+    unsigned int length() const { return (unsigned int)s.length(); }
+    bool isEmpty() const { return s.empty(); }
+    bool reserve(unsigned int n) { s.reserve(n); return true; }
+    const std::string& str() const { return s; }
+
+    char operator[](unsigned int i) const { return i < s.size() ? s[i] : 0; }
+    char& operator[](unsigned int i) { return s[i]; }
+    char charAt(unsigned int i) const { return (*this)[i]; }
+
+    String& operator+=(const String& o) { s += o.s; return *this; }
+    String& operator+=(const char* o) { if (o) s += o; return *this; }
+    String& operator+=(char c) { s += c; return *this; }
+    String& operator+=(int v) { s += String(v).s; return *this; }
+    String& operator+=(unsigned int v) { s += String(v).s; return *this; }
+    String& operator+=(long v) { s += String(v).s; return *this; }
+    String& operator+=(unsigned long v) { s += String(v).s; return *this; }
+    bool concat(const String& o) { s += o.s; return true; }
+    bool concat(const char* o) { if (o) s += o; return true; }
+    bool concat(char c) { s += c; return true; }
+
+    bool operator==(const String& o) const { return s == o.s; }
+    bool operator==(const char* o) const { return s == (o ? o : ""); }
+    bool operator!=(const String& o) const { return s != o.s; }
+    bool operator!=(const char* o) const { return !(*this == o); }
+    bool operator<(const String& o) const { return s < o.s; }
+    bool equals(const String& o) const { return s == o.s; }
+    int compareTo(const String& o) const { return s.compare(o.s); }
+
+    bool startsWith(const String& p) const { return s.compare(0, p.s.size(), p.s) == 0; }
+    bool endsWith(const String& p) const {
+        return s.size() >= p.s.size() && s.compare(s.size() - p.s.size(), p.s.size(), p.s) == 0;
+    }
+    int indexOf(char c, unsigned int from = 0) const { return pos(s.find(c, from)); }
+    int indexOf(const String& p, unsigned int from = 0) const { return pos(s.find(p.s, from)); }
+    int lastIndexOf(char c) const { return pos(s.rfind(c)); }
+    int lastIndexOf(const String& p) const { return pos(s.rfind(p.s)); }
+    String substring(unsigned int from) const { return from < s.size() ? String(s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (to > s.size()) to = (unsigned int)s.size();
+        return from < to ? String(s.substr(from, to - from)) : String();
+    }
+
+    void toUpperCase() { for (auto& c : s) c = (char)toupper((unsigned char)c); }
+    void toLowerCase() { for (auto& c : s) c = (char)tolower((unsigned char)c); }
+    void trim() {
+        size_t a = s.find_first_not_of(" \t\r\n"), b = s.find_last_not_of(" \t\r\n");
+        s = (a == std::string::npos) ? std::string() : s.substr(a, b - a + 1);
+    }
+    void replace(const String& a, const String& b) {
+        if (a.s.empty()) return;
+        for (size_t p = s.find(a.s); p != std::string::npos; p = s.find(a.s, p + b.s.size()))
+            s.replace(p, a.s.size(), b.s);
+    }
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return (float)atof(s.c_str()); }
+
+    friend String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+    friend String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+    friend String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+    friend String operator+(const String& a, char b) { String r(a); r += b; return r; }
+    friend std::ostream& operator<<(std::ostream& o, const String& v) { return o << v.s; }
+
+private:
+    static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+    void fromLong(long long v, unsigned char base) {
+        if (base == DEC) { s = std::to_string(v); return; }
+        fromULong((unsigned long long)v, base);
+    }
+    void fromULong(unsigned long long v, unsigned char base) {
+        char buf[72]; int i = 71; buf[i] = 0;
+        do { int d = (int)(v % base); buf[--i] = (char)(d < 10 ? '0' + d : 'a' + d - 10); v /= base; } while (v);
+        s = &buf[i];
+    }
+    void fromDouble(double v, unsigned int decimals) {
+        char buf[64]; snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v); s = buf;
+    }
+};
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * @brief   Stand-in hote de WebServer : vrai serveur HTTP/1.1 sur localhost
+ * @file    WebServer.h
+ * @author  cgil
+ * @date    2026
+ *
+ * Comme sur l'ESP32, un seul client est servi a la fois dans handleClient().
+ * Le port 80 demande par le firmware devient GMC_HTTP_PORT (defaut 8080).
+ */
+
+#ifndef HOST_WEBSERVER_H
+#define HOST_WEBSERVER_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include <utility>
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+#define CONTENT_LENGTH_NOT_SET ((size_t)-2)
+
+class WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    WebServer(int port = 80);
+    ~WebServer();
+
+    void begin();
+    void close();
+    void handleClient();
+
+    void on(const String& uri, THandlerFunction fn) { on(uri, HTTP_ANY, fn); }
+    void on(const String& uri, HTTPMethod method, THandlerFunction fn);
+    void onNotFound(THandlerFunction fn) { _notFound = fn; }
+
+    String uri() const { return _uri; }
+    HTTPMethod method() const { return _method; }
+    String arg(const String& name) const;
+    String arg(int i) const;
+    String argName(int i) const;
+    int args() const { return (int)_args.size(); }
+    bool hasArg(const String& name) const;
+    String header(const String& name) const;
+    bool hasHeader(const String& name) const;
+    void collectHeaders(const char* headerKeys[], size_t count) {}
+
+    void send(int code, const char* contentType = nullptr, const String& content = String());
+    void send(int code, const String& contentType, const String& content) {
+        send(code, contentType.c_str(), content);
+    }
+    void send(int code, const char* contentType, const char* content, size_t len);
+    void send_P(int code, const char* contentType, const char* content, size_t len) {
+        send(code, contentType, content, len);
+    }
+    void sendHeader(const String& name, const String& value, bool first = false);
+    void setContentLength(size_t len) { _contentLength = len; }
+    void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+    void sendContent(const char* content, size_t len);
+    size_t streamFile(File& file, const String& contentType, int code = 200);
+
+    // --- Outils hote ---
+    int port() const { return _port; }
+    unsigned long nbRequetes() const { return _nbRequetes; }
+
+    /**
+     * @brief Sert une requete en memoire, sans socket (microbancs) : meme
+     *        aiguillage que handleClient(), la reponse complete (en-tetes
+     *        compris) est gardee dans sortie()
+     * @param requete arguments "a=1&b=2" (nullptr : aucun)
+     * @return octets de la reponse
+     */
+    size_t appeler(HTTPMethod method, const char* uri, const char* requete = nullptr);
+    const std::string& sortie() const { return _sortie; }
+
+private:
+    struct Route { String uri; HTTPMethod method; THandlerFunction fn; };
+
+    int _port;
+    int _ecoute = -1;
+    int _client = -1;
+    std::vector<Route> _routes;
+    THandlerFunction _notFound;
+
+    String _uri;
+    HTTPMethod _method = HTTP_GET;
+    std::vector<std::pair<String, String>> _args;
+    std::vector<std::pair<String, String>> _headers;
+    std::vector<std::pair<String, String>> _enTetesReponse;
+    size_t _contentLength = CONTENT_LENGTH_NOT_SET;
+    bool _enTetesEnvoyes = false;
+    bool _chunked = false;
+    unsigned long _nbRequetes = 0;
+    std::string _sortie;            //! reponse d'appeler()
+
+    bool lireRequete();
+    void traiter();
+    void ecrire(const char* data, size_t len);
+    void envoyerEnTetes(int code, const char* contentType, size_t len);
+};
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * @brief   Stand-in hote de WiFi (ESP32 Arduino 3.x) : radio simulee
+ * @file    WiFi.h
+ * @author  cgil
+ * @date    2026
+ *
+ * L'association reussit GMC_WIFI_DELAI_MS apres begin() (defaut 300 ms),
+ * sauf si la Box est declaree absente (GMC_WIFI_BOX=0 ou wifiHoteBoxPresente(false)).
+ * Les evenements sont emis depuis un thread, comme la tache WiFi de l'ESP32.
+ */
+
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include <Arduino.h>
+#include <functional>
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+
+typedef enum {
+    WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL = 1, WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4, WL_CONNECTION_LOST = 5, WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum { WIFI_AUTH_OPEN = 0, WIFI_AUTH_WPA_PSK = 2, WIFI_AUTH_WPA2_PSK = 3 } wifi_auth_mode_t;
+
+typedef enum {
+    ARDUINO_EVENT_WIFI_STA_START = 2,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED = 4,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED = 5,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP = 7,
+    ARDUINO_EVENT_WIFI_STA_LOST_IP = 8
+} arduino_event_id_t;
+
+typedef union { uint8_t brut[32]; } arduino_event_info_t;
+
+typedef arduino_event_id_t WiFiEvent_t;
+typedef arduino_event_info_t WiFiEventInfo_t;
+typedef std::function<void(arduino_event_id_t, arduino_event_info_t)> WiFiEventFuncCb;
+
+class WiFiClass {
+public:
+    bool mode(wifi_mode_t m);
+    wifi_mode_t getMode();
+    wl_status_t begin(const char* ssid, const char* passphrase = nullptr);
+    bool disconnect(bool wifioff = false);
+    wl_status_t status();
+    bool setSleep(bool) { return true; }
+    void setMinSecurity(wifi_auth_mode_t) {}
+    bool setAutoReconnect(bool) { return true; }
+    int8_t RSSI();
+    IPAddress localIP();
+    String macAddress() { return String("F6:E5:D4:C3:B2:A1"); }
+    String SSID();
+
+    bool softAP(const char* ssid, const char* passphrase = nullptr);
+    bool softAPdisconnect(bool wifioff = false);
+    IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+    String softAPmacAddress() { return String("F6:E5:D4:C3:B2:A2"); }
+
+    int onEvent(WiFiEventFuncCb cb);
+};
+
+extern WiFiClass WiFi;
+
+// --- Outils hote : simuler la disparition / le retour de la Box ---
+void wifiHoteBoxPresente(bool presente);
+
+#endif
@@ -0,0 +1,110 @@
+/**
+ * @brief   Implementation hote du coeur Arduino (temps, GPIO, ESP)
+ * @file    arduino_host.cpp
+ * @author  cgil
+ * @date    2026
+ */
+
+#include "Arduino.h"
+#include "soc/gpio_struct.h"
+
+#include <chrono>
+#include <thread>
+#include <random>
+#include <unistd.h>
+#include <climits>
+#include <atomic>
+
+HostSerial Serial;
+EspClass ESP;
+
+static const auto debutProcessus = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - debutProcessus).count();
+}
+
+unsigned long micros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - debutProcessus).count();
+}
+
+/**
+ * @brief delay() reel, mis a l'echelle par GMC_DELAI_ECHELLE
+ *        (0 = aucun delai, pratique pour les bancs de test)
+ */
+void delay(unsigned long ms) {
+    static double echelle = getenv("GMC_DELAI_ECHELLE") ? atof(getenv("GMC_DELAI_ECHELLE")) : 1.0;
+    if (echelle > 0) std::this_thread::sleep_for(std::chrono::microseconds((long)(ms * 1000 * echelle)));
+}
+
+void delayMicroseconds(unsigned int us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+void yield() { std::this_thread::yield(); }
+
+static std::mt19937 generateur(42);
+void randomSeed(unsigned long seed) { generateur.seed(seed); }
+long random(long max) { return max <= 0 ? 0 : (long)(generateur() % (unsigned long)max); }
+long random(long min, long max) { return max <= min ? min : min + random(max - min); }
+
+static uint8_t niveauxGpio[64];
+void pinMode(uint8_t pin, uint8_t mode) {
+    // Entree avec pull-up : niveau haut au repos
+    if (pin < 64 && mode == INPUT_PULLUP) niveauxGpio[pin] = HIGH;
+}
+void digitalWrite(uint8_t pin, uint8_t val) { if (pin < 64) niveauxGpio[pin] = val ? HIGH : LOW; }
+int digitalRead(uint8_t pin) {
+    // Le bouton BOOT (GPIO 0) est au repos a l'etat haut (pull-up)
+    if (pin == 0) return HIGH;
+    return pin < 64 ? niveauxGpio[pin] : LOW;
+}
+//! Registres set/clear : un bit par GPIO de la banque (0 : GPIO 0..31, 1 : 32..53)
+gpio_dev_t GPIO;
+static std::atomic<unsigned long> nbEcrituresGpio{0};
+void gpioHoteEcrireRegistre(int banque, bool haut, uint32_t masque) {
+    for (int b = 0; b < 32; b++) {
+        int pin = banque * 32 + b;
+        if ((masque >> b) & 1 && pin < 64) niveauxGpio[pin] = haut ? HIGH : LOW;
+    }
+    nbEcrituresGpio++;
+}
+unsigned long gpioHoteNbEcritures() { return nbEcrituresGpio; }
+
+void neopixelWrite(uint8_t, uint8_t, uint8_t, uint8_t) {}
+
+/**
+ * @brief Redemarrage : on relance le meme executable (la NVS persiste si GMC_NVS_FICHIER)
+ */
+void EspClass::restart() {
+    fflush(stdout);
+    char chemin[PATH_MAX];
+    ssize_t n = readlink("/proc/self/exe", chemin, sizeof(chemin) - 1);
+    if (n > 0) {
+        chemin[n] = 0;
+        char* argv[] = {chemin, nullptr};
+        execv(chemin, argv);
+    }
+    exit(0);
+}
+
+//! Tas simule d'un ESP32-S3 (~320 Ko), voir tas_host.cpp
+uint32_t EspClass::getHeapSize() { return tasHoteTaille(); }
+uint32_t EspClass::getFreeHeap() { return tasHoteLibre(); }
+uint32_t EspClass::getMinFreeHeap() { return tasHoteMinLibre(); }
+uint32_t EspClass::getMaxAllocHeap() { return tasHotePlusGrandBloc(); }
+
+//! PSRAM simulee : hors du tas interne (malloc), taille par GMC_PSRAM_KO
+static size_t psramUtilisee = 0;
+static uint32_t psramTaille() {
+    const char* env = getenv("GMC_PSRAM_KO");
+    return (env ? (uint32_t)atoi(env) : 8192) * 1024;
+}
+bool psramFound() { return psramTaille() > 0; }
+void* ps_malloc(size_t taille) {
+    if (psramUtilisee + taille > psramTaille()) return nullptr;
+    void* p = malloc(taille);
+    if (p) psramUtilisee += taille;
+    return p;
+}
+uint32_t EspClass::getPsramSize() { return psramTaille(); }
+uint32_t EspClass::getFreePsram() { return psramTaille() - psramUtilisee; }
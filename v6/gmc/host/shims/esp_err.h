@@ -0,0 +1,19 @@
+/**
+ * @brief   Stand-in hote des codes d'erreur ESP-IDF
+ * @file    esp_err.h
+ * @author  cgil
+ * @date    2026
+ */
+
+#ifndef HOST_ESP_ERR_H
+#define HOST_ESP_ERR_H
+
+typedef int esp_err_t;
+
+#define ESP_OK                 0
+#define ESP_FAIL              -1
+#define ESP_ERR_NO_MEM         0x101
+#define ESP_ERR_INVALID_ARG    0x102
+#define ESP_ERR_INVALID_STATE  0x103
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @brief   Implementation hote d'esp_timer
+ * @file    esp_timer_host.cpp
+ * @author  cgil
+ * @date    2026
+ */
+
+#include "esp_timer.h"
+#include "freertos/task.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+struct esp_timer {
+    esp_timer_create_args_t args;
+    int64_t echeanceUs = 0;
+    uint64_t periodeUs = 0;
+    bool actif = false;
+};
+
+namespace {
+std::mutex verrou;
+std::condition_variable reveil;
+std::set<esp_timer*> timers;
+bool tacheLancee = false;
+
+const auto origine = std::chrono::steady_clock::now();
+
+//! Tache "esp_timer" : appelle les callbacks a echeance, un a la fois
+void tacheTimers(void*) {
+    std::unique_lock<std::mutex> l(verrou);
+    for (;;) {
+        int64_t prochain = INT64_MAX;
+        esp_timer* aLancer = nullptr;
+        for (auto t : timers)
+            if (t->actif && t->echeanceUs < prochain) { prochain = t->echeanceUs; aLancer = t; }
+
+        if (!aLancer) { reveil.wait(l); continue; }
+        int64_t maintenant = esp_timer_get_time();
+        if (prochain > maintenant) {
+            reveil.wait_for(l, std::chrono::microseconds(prochain - maintenant));
+            continue;
+        }
+        if (aLancer->periodeUs) aLancer->echeanceUs += aLancer->periodeUs;
+        else aLancer->actif = false;
+        esp_timer_cb_t cb = aLancer->args.callback;
+        void* arg = aLancer->args.arg;
+        l.unlock();
+        cb(arg);
+        l.lock();
+    }
+}
+
+esp_err_t armer(esp_timer_handle_t t, uint64_t delaiUs, uint64_t periodeUs) {
+    std::lock_guard<std::mutex> l(verrou);
+    if (!t || t->actif) return ESP_ERR_INVALID_STATE;
+    t->echeanceUs = esp_timer_get_time() + (int64_t)delaiUs;
+    t->periodeUs = periodeUs;
+    t->actif = true;
+    if (!tacheLancee) {
+        xTaskCreatePinnedToCore(tacheTimers, "esp_timer", 4096, nullptr, 22, nullptr, 0);
+        tacheLancee = true;
+    }
+    reveil.notify_all();
+    return ESP_OK;
+}
+}  // namespace
+
+int64_t esp_timer_get_time() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - origine).count();
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* out) {
+    if (!args || !args->callback || !out) return ESP_ERR_INVALID_ARG;
+    std::lock_guard<std::mutex> l(verrou);
+    esp_timer* t = new esp_timer();
+    t->args = *args;
+    timers.insert(t);
+    *out = t;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t t, uint64_t periodUs) { return armer(t, periodUs, periodUs); }
+esp_err_t esp_timer_start_once(esp_timer_handle_t t, uint64_t timeoutUs) { return armer(t, timeoutUs, 0); }
+
+esp_err_t esp_timer_stop(esp_timer_handle_t t) {
+    std::lock_guard<std::mutex> l(verrou);
+    if (!t || !t->actif) return ESP_ERR_INVALID_STATE;
+    t->actif = false;
+    reveil.notify_all();
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t t) {
+    std::lock_guard<std::mutex> l(verrou);
+    if (!t) return ESP_ERR_INVALID_ARG;
+    timers.erase(t);
+    delete t;
+    return ESP_OK;
+}
@@ -0,0 +1,45 @@
+/**
+ * @brief   Stand-in hote des types de base FreeRTOS
+ * @file    FreeRTOS.h
+ * @author  cgil
+ * @date    2026
+ */
+
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE  0
+#define pdTRUE   1
+#define pdPASS   pdTRUE
+#define pdFAIL   pdFALSE
+#define errQUEUE_FULL 0
+
+//! Tick a 1 kHz comme la configuration Arduino-ESP32
+#define configTICK_RATE_HZ   1000
+#define portTICK_PERIOD_MS   1
+#define portMAX_DELAY        ((TickType_t)0xffffffffUL)
+#define pdMS_TO_TICKS(ms)    ((TickType_t)(ms))
+
+//! Section critique multi-coeur (spinlock portMUX de l'IDF)
+struct portMUX_TYPE {
+    std::atomic<bool> pris{false};
+};
+#define portMUX_INITIALIZER_UNLOCKED {}
+inline void portENTER_CRITICAL(portMUX_TYPE* m) {
+    while (m->pris.exchange(true, std::memory_order_acquire)) {}
+}
+inline void portEXIT_CRITICAL(portMUX_TYPE* m) { m->pris.store(false, std::memory_order_release); }
+
+//! Coeurs de l'ESP32-S3 (PRO : pile WiFi, APP : Arduino)
+#define PRO_CPU_NUM 0
+#define APP_CPU_NUM 1
+
+#endif
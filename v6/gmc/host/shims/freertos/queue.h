@@ -0,0 +1,30 @@
+/**
+ * @brief   Stand-in hote des files FreeRTOS (copie d'elements de taille fixe)
+ * @file    queue.h
+ * @author  cgil
+ * @date    2026
+ */
+
+#ifndef HOST_FREERTOS_QUEUE_H
+#define HOST_FREERTOS_QUEUE_H
+
+#include "FreeRTOS.h"
+
+typedef struct QueueHote* QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t longueur, UBaseType_t tailleElement);
+void vQueueDelete(QueueHandle_t q);
+BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t attente);
+BaseType_t xQueueSendToFront(QueueHandle_t q, const void* item, TickType_t attente);
+BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t attente);
+BaseType_t xQueuePeek(QueueHandle_t q, void* item, TickType_t attente);
+BaseType_t xQueueReset(QueueHandle_t q);
+BaseType_t xQueueOverwrite(QueueHandle_t q, const void* item);   //! file de longueur 1
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q);
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q);
+
+#define xQueueSendToBack(q, i, t) xQueueSend(q, i, t)
+#define xQueueSendFromISR(q, i, w) xQueueSend(q, i, 0)
+#define xQueueReceiveFromISR(q, i, w) xQueueReceive(q, i, 0)
+
+#endif
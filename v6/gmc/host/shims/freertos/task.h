@@ -0,0 +1,40 @@
+/**
+ * @brief   Stand-in hote des taches FreeRTOS (std::thread)
+ * @file    task.h
+ * @author  cgil
+ * @date    2026
+ *
+ * Les taches sont des threads ; coeur et priorite sont memorises mais
+ * non appliques. La marge de pile n'est pas mesurable sur l'hote :
+ * uxTaskGetStackHighWaterMark() rend la moitie de la pile declaree.
+ */
+
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef struct TacheHote* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define tskIDLE_PRIORITY 0
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* nom, uint32_t pileOctets,
+                                   void* param, UBaseType_t priorite, TaskHandle_t* tache, BaseType_t coeur);
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* nom, uint32_t pileOctets,
+                       void* param, UBaseType_t priorite, TaskHandle_t* tache);
+void vTaskDelete(TaskHandle_t tache);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* precedent, TickType_t increment);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+TaskHandle_t xTaskGetHandle(const char* nom);
+const char* pcTaskGetName(TaskHandle_t tache);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t tache);
+BaseType_t xPortGetCoreID();
+
+#define xTaskDelayUntil(p, i) (vTaskDelayUntil(p, i), pdTRUE)
+#define taskYIELD() vTaskDelay(0)
+
+#endif
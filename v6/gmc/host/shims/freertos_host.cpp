@@ -0,0 +1,91 @@
+/**
+ * @brief   Implementation hote des primitives FreeRTOS (files)
+ * @file    freertos_host.cpp
+ * @author  cgil
+ * @date    2026
+ */
+
+#include "freertos/queue.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+struct QueueHote {
+    std::mutex m;
+    std::condition_variable nonVide, nonPleine;
+    std::deque<std::vector<uint8_t>> elements;
+    UBaseType_t longueur, taille;
+};
+
+template <typename Pred>
+static bool attendre(std::condition_variable& cv, std::unique_lock<std::mutex>& l, TickType_t t, Pred p) {
+    if (t == portMAX_DELAY) { cv.wait(l, p); return true; }
+    return cv.wait_for(l, std::chrono::milliseconds(t), p);
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t longueur, UBaseType_t taille) {
+    QueueHote* q = new QueueHote();
+    q->longueur = longueur;
+    q->taille = taille;
+    return q;
+}
+
+void vQueueDelete(QueueHandle_t q) { delete q; }
+
+static BaseType_t envoyer(QueueHandle_t q, const void* item, TickType_t t, bool devant) {
+    std::unique_lock<std::mutex> l(q->m);
+    if (!attendre(q->nonPleine, l, t, [q] { return q->elements.size() < q->longueur; })) return errQUEUE_FULL;
+    std::vector<uint8_t> e((const uint8_t*)item, (const uint8_t*)item + q->taille);
+    if (devant) q->elements.push_front(std::move(e));
+    else q->elements.push_back(std::move(e));
+    q->nonVide.notify_one();
+    return pdTRUE;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t t) { return envoyer(q, item, t, false); }
+BaseType_t xQueueSendToFront(QueueHandle_t q, const void* item, TickType_t t) { return envoyer(q, item, t, true); }
+
+BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t t) {
+    std::unique_lock<std::mutex> l(q->m);
+    if (!attendre(q->nonVide, l, t, [q] { return !q->elements.empty(); })) return pdFALSE;
+    memcpy(item, q->elements.front().data(), q->taille);
+    q->elements.pop_front();
+    q->nonPleine.notify_one();
+    return pdTRUE;
+}
+
+BaseType_t xQueuePeek(QueueHandle_t q, void* item, TickType_t t) {
+    std::unique_lock<std::mutex> l(q->m);
+    if (!attendre(q->nonVide, l, t, [q] { return !q->elements.empty(); })) return pdFALSE;
+    memcpy(item, q->elements.front().data(), q->taille);
+    return pdTRUE;
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t q, const void* item) {
+    std::lock_guard<std::mutex> l(q->m);
+    q->elements.clear();
+    q->elements.emplace_back((const uint8_t*)item, (const uint8_t*)item + q->taille);
+    q->nonVide.notify_one();
+    return pdPASS;
+}
+
+BaseType_t xQueueReset(QueueHandle_t q) {
+    std::lock_guard<std::mutex> l(q->m);
+    q->elements.clear();
+    q->nonPleine.notify_all();
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+    std::lock_guard<std::mutex> l(q->m);
+    return (UBaseType_t)q->elements.size();
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q) {
+    std::lock_guard<std::mutex> l(q->m);
+    return q->longueur - (UBaseType_t)q->elements.size();
+}
@@ -0,0 +1,115 @@
+/**
+ * @brief   Implementation hote de FS/File/LittleFS
+ * @file    fs_host.cpp
+ * @author  cgil
+ * @date    2026
+ */
+
+#include "LittleFS.h"
+
+#include <cstdio>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs {
+
+struct File::Etat {
+    std::string chemin;     // chemin dans le FS ("/index.html")
+    std::string nom;        // dernier segment
+    std::string reel;       // chemin Linux
+    FILE* f = nullptr;
+    DIR* d = nullptr;
+    bool repertoire = false;
+    ~Etat() { if (f) fclose(f); if (d) closedir(d); }
+};
+
+File::operator bool() const { return _e && (_e->f || _e->d); }
+const char* File::name() const { return _e ? _e->nom.c_str() : ""; }
+const char* File::path() const { return _e ? _e->chemin.c_str() : ""; }
+bool File::isDirectory() const { return _e && _e->repertoire; }
+
+size_t File::size() const {
+    struct stat st;
+    return (_e && stat(_e->reel.c_str(), &st) == 0) ? (size_t)st.st_size : 0;
+}
+
+size_t File::position() const { return (_e && _e->f) ? (size_t)ftell(_e->f) : 0; }
+int File::available() { return (_e && _e->f) ? (int)(size() - position()) : 0; }
+int File::read() { return (_e && _e->f) ? fgetc(_e->f) : -1; }
+size_t File::read(uint8_t* buf, size_t n) { return (_e && _e->f) ? fread(buf, 1, n, _e->f) : 0; }
+size_t File::write(const uint8_t* buf, size_t n) { return (_e && _e->f) ? fwrite(buf, 1, n, _e->f) : 0; }
+bool File::seek(uint32_t pos) { return _e && _e->f && fseek(_e->f, pos, SEEK_SET) == 0; }
+void File::flush() { if (_e && _e->f) fflush(_e->f); }
+void File::close() { _e.reset(); }
+
+File File::openNextFile() {
+    if (!_e || !_e->d) return File();
+    struct dirent* ent;
+    while ((ent = readdir(_e->d)) != nullptr) {
+        if (ent->d_name[0] == '.') continue;
+        std::string base = _e->chemin == "/" ? "" : _e->chemin;
+        auto e = std::make_shared<Etat>();
+        e->chemin = base + "/" + ent->d_name;
+        e->nom = ent->d_name;
+        e->reel = _e->reel + "/" + ent->d_name;
+        struct stat st;
+        stat(e->reel.c_str(), &st);
+        e->repertoire = S_ISDIR(st.st_mode);
+        if (e->repertoire) e->d = opendir(e->reel.c_str());
+        else e->f = fopen(e->reel.c_str(), "rb");
+        return File(e);
+    }
+    return File();
+}
+
+File FS::open(const char* path, const char* mode, bool) {
+    auto e = std::make_shared<File::Etat>();
+    e->chemin = path;
+    e->reel = _racine + path;
+    size_t p = e->chemin.find_last_of('/');
+    e->nom = (p == std::string::npos) ? e->chemin : e->chemin.substr(p + 1);
+    struct stat st;
+    if (stat(e->reel.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        e->repertoire = true;
+        e->d = opendir(e->reel.c_str());
+    } else {
+        std::string m = std::string(mode) + "b";
+        e->f = fopen(e->reel.c_str(), m.c_str());
+    }
+    return (e->f || e->d) ? File(e) : File();
+}
+
+bool FS::exists(const char* path) {
+    struct stat st;
+    return stat((_racine + path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char* path) { return ::remove((_racine + path).c_str()) == 0; }
+bool FS::rename(const char* from, const char* to) {
+    return ::rename((_racine + from).c_str(), (_racine + to).c_str()) == 0;
+}
+bool FS::mkdir(const char* path) { return ::mkdir((_racine + path).c_str(), 0755) == 0; }
+
+}  // namespace fs
+
+
+LittleFSFS LittleFS;
+
+bool LittleFSFS::begin(bool, const char*, uint8_t, const char*) {
+    if (getenv("GMC_DATA_DIR")) _racine = getenv("GMC_DATA_DIR");
+    struct stat st;
+    return stat(_racine.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+bool LittleFSFS::format() { return false; }
+
+//! Partition LittleFS d'un ESP32-S3 en schema par defaut (1,5 Mo)
+size_t LittleFSFS::totalBytes() { return 1536 * 1024; }
+
+size_t LittleFSFS::usedBytes() {
+    size_t total = 0;
+    File racine = open("/");
+    for (File f = racine.openNextFile(); f; f = racine.openNextFile()) total += f.size();
+    return total;
+}
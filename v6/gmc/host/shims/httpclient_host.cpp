@@ -0,0 +1,38 @@
+/**
+ * @brief   Implementation hote de HTTPClient
+ * @file    httpclient_host.cpp
+ * @author  cgil
+ * @date    2026
+ */
+
+#include "HTTPClient.h"
+
+#include <mutex>
+
+namespace {
+std::mutex verrou;
+unsigned long compteur = 0;
+unsigned long octets = 0;
+std::vector<uint8_t> dernier;
+}  // namespace
+
+int HTTPClient::GET() {
+    std::lock_guard<std::mutex> l(verrou);
+    compteur++;
+    _reponse = "{\"status\":\"success\"}";
+    return 200;
+}
+
+int HTTPClient::POST(const uint8_t* payload, size_t size) {
+    std::lock_guard<std::mutex> l(verrou);
+    if (!_url.startsWith("http")) return HTTPC_ERROR_CONNECTION_REFUSED;
+    compteur++;
+    octets += size;
+    dernier.assign(payload, payload + size);
+    _reponse = "{\"status\":\"success\",\"message\":\"Donnée reçue\"}";
+    return 200;
+}
+
+unsigned long HTTPClient::nbRequetes() { std::lock_guard<std::mutex> l(verrou); return compteur; }
+unsigned long HTTPClient::nbOctetsEnvoyes() { std::lock_guard<std::mutex> l(verrou); return octets; }
+std::vector<uint8_t> HTTPClient::dernierCorps() { std::lock_guard<std::mutex> l(verrou); return dernier; }
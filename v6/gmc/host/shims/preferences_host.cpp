@@ -0,0 +1,177 @@
+/**
+ * @brief   Implementation hote de Preferences
+ * @file    preferences_host.cpp
+ * @author  cgil
+ * @date    2026
+ */
+
+#include "Preferences.h"
+
+#include <map>
+#include <string>
+#include <mutex>
+#include <fstream>
+
+namespace {
+
+typedef std::map<std::string, std::string> Espace;   // cle -> octets bruts
+
+std::map<std::string, Espace>& nvs() {
+    static std::map<std::string, Espace> m;
+    return m;
+}
+std::recursive_mutex verrouNvs;
+
+//! Verrou + allocations hors tas simule : la NVS est en flash sur la cible
+struct VerrouNvs {
+    HorsTasHote horsTas;
+    std::lock_guard<std::recursive_mutex> l{verrouNvs};
+};
+unsigned long compteurEcritures = 0;
+unsigned long compteurLectures = 0;
+
+const char* fichierNvs() { return getenv("GMC_NVS_FICHIER"); }
+
+//! Format : ns \0 cle \0 taille(4) octets ...
+void charger() {
+    static bool fait = false;
+    if (fait || !fichierNvs()) { fait = true; return; }
+    fait = true;
+    std::ifstream in(fichierNvs(), std::ios::binary);
+    std::string ns, cle;
+    while (std::getline(in, ns, '\0') && std::getline(in, cle, '\0')) {
+        uint32_t n = 0;
+        in.read((char*)&n, 4);
+        std::string v(n, '\0');
+        in.read(&v[0], n);
+        nvs()[ns][cle] = v;
+    }
+}
+
+//! Ecriture dans un fichier temporaire puis rename : un kill ne laisse jamais un fichier tronque
+void sauver() {
+    if (!fichierNvs()) return;
+    std::string tmp = std::string(fichierNvs()) + ".tmp";
+    {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    for (auto& e : nvs())
+        for (auto& kv : e.second) {
+            out.write(e.first.c_str(), e.first.size() + 1);
+            out.write(kv.first.c_str(), kv.first.size() + 1);
+            uint32_t n = (uint32_t)kv.second.size();
+            out.write((const char*)&n, 4);
+            out.write(kv.second.data(), n);
+        }
+    }
+    rename(tmp.c_str(), fichierNvs());
+}
+
+}  // namespace
+
+
+bool Preferences::begin(const char* name, bool readOnly, const char*) {
+    VerrouNvs l;
+    charger();
+    if (!name || strlen(name) > 15) return false;
+    _ns = name;
+    _lectureSeule = readOnly;
+    _ouvert = true;
+    if (!readOnly) nvs()[name];
+    return true;
+}
+
+void Preferences::end() {
+    VerrouNvs l;
+    if (_ouvert && !_lectureSeule) sauver();
+    _ouvert = false;
+}
+
+bool Preferences::clear() {
+    VerrouNvs l;
+    if (!_ouvert || _lectureSeule) return false;
+    nvs()[_ns.c_str()].clear();
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    VerrouNvs l;
+    if (!_ouvert || _lectureSeule) return false;
+    return nvs()[_ns.c_str()].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char* key) {
+    VerrouNvs l;
+    auto e = nvs().find(_ns.c_str());
+    return _ouvert && e != nvs().end() && e->second.count(key);
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t len) {
+    VerrouNvs l;
+    // Comme la NVS : 15 caracteres max par cle
+    if (!_ouvert || _lectureSeule || !key || strlen(key) > 15) return 0;
+    nvs()[_ns.c_str()][key] = std::string((const char*)value, len);
+    compteurEcritures++;
+    return len;
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen) {
+    VerrouNvs l;
+    compteurLectures++;
+    auto e = nvs().find(_ns.c_str());
+    if (!_ouvert || e == nvs().end()) return 0;
+    auto kv = e->second.find(key);
+    if (kv == e->second.end() || kv->second.size() > maxLen) return 0;
+    memcpy(buf, kv->second.data(), kv->second.size());
+    return kv->second.size();
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    VerrouNvs l;
+    auto e = nvs().find(_ns.c_str());
+    if (!_ouvert || e == nvs().end()) return 0;
+    auto kv = e->second.find(key);
+    return kv == e->second.end() ? 0 : kv->second.size();
+}
+
+template <typename T>
+static T lireScalaire(Preferences& p, const char* key, T defaut) {
+    T v;
+    return p.getBytes(key, &v, sizeof(T)) == sizeof(T) ? v : defaut;
+}
+
+size_t Preferences::putInt(const char* key, int32_t value) { return putBytes(key, &value, sizeof(value)); }
+size_t Preferences::putUInt(const char* key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+size_t Preferences::putLong(const char* key, int32_t value) { return putBytes(key, &value, sizeof(value)); }
+size_t Preferences::putULong(const char* key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+size_t Preferences::putUChar(const char* key, uint8_t value) { return putBytes(key, &value, sizeof(value)); }
+size_t Preferences::putString(const char* key, const char* value) {
+    return value ? putBytes(key, value, strlen(value) + 1) : 0;
+}
+size_t Preferences::putString(const char* key, const String& value) { return putString(key, value.c_str()); }
+
+int32_t Preferences::getInt(const char* key, int32_t d) { return lireScalaire(*this, key, d); }
+uint32_t Preferences::getUInt(const char* key, uint32_t d) { return lireScalaire(*this, key, d); }
+int32_t Preferences::getLong(const char* key, int32_t d) { return lireScalaire(*this, key, d); }
+uint32_t Preferences::getULong(const char* key, uint32_t d) { return lireScalaire(*this, key, d); }
+uint8_t Preferences::getUChar(const char* key, uint8_t d) { return lireScalaire(*this, key, d); }
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+    size_t n = getBytesLength(key);
+    if (n == 0) return defaultValue;
+    std::string v(n, '\0');
+    getBytes(key, &v[0], n);
+    return String(v.c_str());
+}
+
+size_t Preferences::getString(const char* key, char* value, size_t maxLen) {
+    size_t n = getBytesLength(key);
+    if (n == 0 || n > maxLen) return 0;
+    return getBytes(key, value, maxLen);
+}
+
+unsigned long Preferences::nbEcritures() { return compteurEcritures; }
+unsigned long Preferences::nbLectures() { return compteurLectures; }
+void Preferences::effacerTout() {
+    VerrouNvs l;
+    nvs().clear();
+}
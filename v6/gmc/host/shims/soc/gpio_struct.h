@@ -0,0 +1,41 @@
+/**
+ * @brief   Stand-in hote des registres GPIO de l'ESP32-S3 (set/clear)
+ * @file    gpio_struct.h
+ * @author  cgil
+ * @date    2026
+ *
+ * Seuls les registres "write 1 to set / clear" des sorties sont fournis :
+ * une affectation met a jour les niveaux lus par digitalRead() et compte
+ * une ecriture registre (gpioHoteNbEcritures, pour les outils hote).
+ *   banque 0 : GPIO 0..31  (out_w1ts / out_w1tc)
+ *   banque 1 : GPIO 32..53 (out1_w1ts.val / out1_w1tc.val)
+ */
+
+#ifndef HOST_SOC_GPIO_STRUCT_H
+#define HOST_SOC_GPIO_STRUCT_H
+
+#include <cstdint>
+
+void gpioHoteEcrireRegistre(int banque, bool haut, uint32_t masque);
+unsigned long gpioHoteNbEcritures();
+
+struct RegistreW1Hote {
+    int banque;
+    bool haut;
+    RegistreW1Hote& operator=(uint32_t masque) { gpioHoteEcrireRegistre(banque, haut, masque); return *this; }
+};
+
+struct RegistreW1BanqueHote {
+    RegistreW1Hote val;
+};
+
+typedef struct gpio_dev_s {
+    RegistreW1Hote out_w1ts { 0, true };
+    RegistreW1Hote out_w1tc { 0, false };
+    RegistreW1BanqueHote out1_w1ts { { 1, true } };
+    RegistreW1BanqueHote out1_w1tc { { 1, false } };
+} gpio_dev_t;
+
+extern gpio_dev_t GPIO;
+
+#endif
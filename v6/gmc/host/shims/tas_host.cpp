@@ -0,0 +1,164 @@
+/**
+ * @brief   Tas simule de l'ESP32 pour la construction hote
+ * @file    tas_host.cpp
+ * @author  cgil
+ * @date    avril 2026
+ *
+ * operator new / delete sont servis par une arene statique de la taille
+ * de la DRAM libre d'un ESP32-S3 (320 Ko), en first-fit avec fusion des
+ * blocs libres voisins, comme le tas de l'IDF. ESP.getFreeHeap() et
+ * ESP.getMaxAllocHeap() mesurent donc vraiment la fragmentation produite
+ * par le code gmc, et les compteurs d'allocations permettent de compter
+ * les allocations par requete (host/soak).
+ * Arene pleine : repli sur malloc(), compte dans echecs.
+ * Les shims qui simulent la flash (NVS) allouent hors arene (HorsTasHote) :
+ * sur la cible ces octets ne sont pas dans le tas.
+ */
+
+#include <Arduino.h>
+#include <mutex>
+#include <new>
+
+#define TAS_OCTETS   (320 * 1024)
+#define TAS_ALIGN    16      //! alignement garanti par operator new sur x86_64
+
+namespace {
+
+//! Entete de bloc : taille totale (entete compris), libre ou non
+struct Bloc {
+    uint32_t taille;
+    uint32_t libre;
+    Bloc* suivantLibre;     //! valide seulement si libre
+};
+#define TAS_ENTETE TAS_ALIGN     //! taille + libre ; suivantLibre dans la charge utile
+
+alignas(16) uint8_t arene[TAS_OCTETS];
+Bloc* libres = nullptr;         //! blocs libres tries par adresse
+bool initialise = false;
+std::mutex verrou;
+
+uint32_t octetsLibres = 0, minLibres = TAS_OCTETS;
+unsigned long nbAllocs = 0, nbLiberations = 0, nbEchecs = 0;
+thread_local int horsTas = 0;
+
+void initialiser() {
+    libres = (Bloc*)arene;
+    libres->taille = TAS_OCTETS;
+    libres->libre = 1;
+    libres->suivantLibre = nullptr;
+    octetsLibres = minLibres = TAS_OCTETS;
+    initialise = true;
+}
+
+bool dansArene(void* p) { return p >= (void*)arene && p < (void*)(arene + TAS_OCTETS); }
+
+void* allouer(size_t n) {
+    std::lock_guard<std::mutex> l(verrou);
+    if (!initialise) initialiser();
+    nbAllocs++;
+
+    size_t besoin = (n + TAS_ENTETE + TAS_ALIGN - 1) & ~(size_t)(TAS_ALIGN - 1);
+    if (besoin < sizeof(Bloc)) besoin = (sizeof(Bloc) + TAS_ALIGN - 1) & ~(size_t)(TAS_ALIGN - 1);
+
+    Bloc** pp = &libres;
+    for (Bloc* b = libres; b; pp = &b->suivantLibre, b = b->suivantLibre) {
+        if (b->taille < besoin) continue;
+        if (b->taille - besoin >= 2 * sizeof(Bloc)) {
+            //! decoupe : le reste reste libre a la meme place dans la liste
+            Bloc* reste = (Bloc*)((uint8_t*)b + besoin);
+            reste->taille = b->taille - besoin;
+            reste->libre = 1;
+            reste->suivantLibre = b->suivantLibre;
+            *pp = reste;
+            b->taille = besoin;
+        } else {
+            *pp = b->suivantLibre;
+        }
+        b->libre = 0;
+        octetsLibres -= b->taille;
+        if (octetsLibres < minLibres) minLibres = octetsLibres;
+        return (uint8_t*)b + TAS_ENTETE;
+    }
+    nbEchecs++;
+    return nullptr;
+}
+
+void liberer(void* p) {
+    std::lock_guard<std::mutex> l(verrou);
+    nbLiberations++;
+    Bloc* b = (Bloc*)((uint8_t*)p - TAS_ENTETE);
+    b->libre = 1;
+    octetsLibres += b->taille;
+
+    //! insertion triee par adresse puis fusion avec les voisins
+    Bloc* prec = nullptr;
+    Bloc* cour = libres;
+    while (cour && cour < b) { prec = cour; cour = cour->suivantLibre; }
+    b->suivantLibre = cour;
+    if (prec) prec->suivantLibre = b; else libres = b;
+
+    if (cour && (uint8_t*)b + b->taille == (uint8_t*)cour) {
+        b->taille += cour->taille;
+        b->suivantLibre = cour->suivantLibre;
+    }
+    if (prec && (uint8_t*)prec + prec->taille == (uint8_t*)b) {
+        prec->taille += b->taille;
+        prec->suivantLibre = b->suivantLibre;
+    }
+}
+
+void* nouveau(size_t n) {
+    void* p = horsTas ? nullptr : allouer(n);
+    if (!p) p = malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void supprimer(void* p) {
+    if (!p) return;
+    if (dansArene(p)) liberer(p);
+    else free(p);
+}
+
+}  // namespace
+
+void* operator new(size_t n) { return nouveau(n); }
+void* operator new[](size_t n) { return nouveau(n); }
+void* operator new(size_t n, const std::nothrow_t&) noexcept { try { return nouveau(n); } catch (...) { return nullptr; } }
+void* operator new[](size_t n, const std::nothrow_t&) noexcept { try { return nouveau(n); } catch (...) { return nullptr; } }
+void operator delete(void* p) noexcept { supprimer(p); }
+void operator delete[](void* p) noexcept { supprimer(p); }
+void operator delete(void* p, size_t) noexcept { supprimer(p); }
+void operator delete[](void* p, size_t) noexcept { supprimer(p); }
+
+
+HorsTasHote::HorsTasHote() { horsTas++; }
+HorsTasHote::~HorsTasHote() { horsTas--; }
+
+
+// --- Lectures (ESP et outils hote) ---
+
+uint32_t tasHoteLibre() {
+    std::lock_guard<std::mutex> l(verrou);
+    return initialise ? octetsLibres : TAS_OCTETS;
+}
+
+uint32_t tasHoteMinLibre() {
+    std::lock_guard<std::mutex> l(verrou);
+    return initialise ? minLibres : TAS_OCTETS;
+}
+
+uint32_t tasHotePlusGrandBloc() {
+    std::lock_guard<std::mutex> l(verrou);
+    if (!initialise) return TAS_OCTETS - TAS_ENTETE;
+    uint32_t max = 0;
+    for (Bloc* b = libres; b; b = b->suivantLibre)
+        if (b->taille > max) max = b->taille;
+    return max > TAS_ENTETE ? max - TAS_ENTETE : 0;
+}
+
+uint32_t tasHoteTaille() { return TAS_OCTETS; }
+
+unsigned long tasHoteNbAllocations() { std::lock_guard<std::mutex> l(verrou); return nbAllocs; }
+unsigned long tasHoteNbLiberations() { std::lock_guard<std::mutex> l(verrou); return nbLiberations; }
+unsigned long tasHoteNbEchecs() { std::lock_guard<std::mutex> l(verrou); return nbEchecs; }
@@ -0,0 +1,103 @@
+/**
+ * @brief   Implementation hote des taches FreeRTOS
+ * @file    task_host.cpp
+ * @author  cgil
+ * @date    2026
+ */
+
+#include "freertos/task.h"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct TacheHote {
+    std::string nom;
+    uint32_t pile;
+    BaseType_t coeur;
+    std::thread::id id;
+};
+
+namespace {
+std::mutex verrou;
+std::vector<TacheHote*>& taches() {
+    //! La tache principale (setup/loop) existe d'office, comme loopTask
+    static std::vector<TacheHote*> v{new TacheHote{"loopTask", 8192, 1, std::this_thread::get_id()}};
+    return v;
+}
+thread_local TacheHote* tacheCourante = nullptr;
+const auto origine = std::chrono::steady_clock::now();
+}  // namespace
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* nom, uint32_t pile,
+                                   void* param, UBaseType_t, TaskHandle_t* out, BaseType_t coeur) {
+    TacheHote* t = new TacheHote{nom ? nom : "", pile, coeur, {}};
+    {
+        std::lock_guard<std::mutex> l(verrou);
+        taches().push_back(t);
+    }
+    std::thread th([t, fn, param]() {
+        tacheCourante = t;
+        fn(param);
+    });
+    t->id = th.get_id();
+    th.detach();
+    if (out) *out = t;
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* nom, uint32_t pile, void* param,
+                       UBaseType_t prio, TaskHandle_t* out) {
+    return xTaskCreatePinnedToCore(fn, nom, pile, param, prio, out, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t) {
+    // Une tache qui se supprime elle-meme sort de sa boucle : on attend indefiniment
+    for (;;) std::this_thread::sleep_for(std::chrono::hours(1));
+}
+
+void vTaskDelay(TickType_t ticks) {
+    if (ticks == 0) std::this_thread::yield();
+    else std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - origine).count();
+}
+
+void vTaskDelayUntil(TickType_t* precedent, TickType_t increment) {
+    *precedent += increment;
+    TickType_t maintenant = xTaskGetTickCount();
+    if ((int32_t)(*precedent - maintenant) > 0) vTaskDelay(*precedent - maintenant);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    if (tacheCourante) return tacheCourante;
+    std::lock_guard<std::mutex> l(verrou);
+    for (auto t : taches()) if (t->id == std::this_thread::get_id()) return t;
+    return taches()[0];
+}
+
+TaskHandle_t xTaskGetHandle(const char* nom) {
+    std::lock_guard<std::mutex> l(verrou);
+    for (auto t : taches()) if (t->nom == nom) return t;
+    return nullptr;
+}
+
+const char* pcTaskGetName(TaskHandle_t t) {
+    if (!t) t = xTaskGetCurrentTaskHandle();
+    return t->nom.c_str();
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t t) {
+    if (!t) t = xTaskGetCurrentTaskHandle();
+    return t->pile / 2;
+}
+
+BaseType_t xPortGetCoreID() {
+    TaskHandle_t t = xTaskGetCurrentTaskHandle();
+    return t->coeur == tskNO_AFFINITY ? 0 : t->coeur;
+}
@@ -0,0 +1,281 @@
+/**
+ * @brief   Implementation hote de WebServer (sockets POSIX)
+ * @file    webserver_host.cpp
+ * @author  cgil
+ * @date    2026
+ */
+
+#include "WebServer.h"
+
+#include <string>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+//! _client d'une requete servie par appeler() : la reponse va dans _sortie
+#define CLIENT_MEMOIRE (-2)
+
+static String decoderUrl(const std::string& s) {
+    std::string r;
+    for (size_t i = 0; i < s.size(); i++) {
+        if (s[i] == '+') r += ' ';
+        else if (s[i] == '%' && i + 2 < s.size()) { r += (char)strtol(s.substr(i + 1, 2).c_str(), nullptr, 16); i += 2; }
+        else r += s[i];
+    }
+    return String(r);
+}
+
+static void analyserArguments(const std::string& qs, std::vector<std::pair<String, String>>& args) {
+    size_t debut = 0;
+    while (debut < qs.size()) {
+        size_t fin = qs.find('&', debut);
+        if (fin == std::string::npos) fin = qs.size();
+        std::string kv = qs.substr(debut, fin - debut);
+        size_t eg = kv.find('=');
+        if (!kv.empty())
+            args.push_back({decoderUrl(kv.substr(0, eg)), eg == std::string::npos ? String() : decoderUrl(kv.substr(eg + 1))});
+        debut = fin + 1;
+    }
+}
+
+static const char* texteStatut(int code) {
+    switch (code) {
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default:  return "";
+    }
+}
+
+WebServer::WebServer(int port) {
+    const char* env = getenv("GMC_HTTP_PORT");
+    _port = env ? atoi(env) : (port < 1024 ? 8000 + port : port);
+}
+
+WebServer::~WebServer() { close(); }
+
+void WebServer::begin() {
+    _ecoute = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int un = 1;
+    setsockopt(_ecoute, SOL_SOCKET, SO_REUSEADDR, &un, sizeof(un));
+    sockaddr_in adr{};
+    adr.sin_family = AF_INET;
+    adr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    adr.sin_port = htons(_port);
+    if (bind(_ecoute, (sockaddr*)&adr, sizeof(adr)) < 0 || listen(_ecoute, 64) < 0) {
+        perror("WebServer hote");
+        ::close(_ecoute);
+        _ecoute = -1;
+        return;
+    }
+    printf("[hote] WebServer sur http://127.0.0.1:%d\n", _port);
+}
+
+void WebServer::close() {
+    if (_ecoute >= 0) ::close(_ecoute);
+    _ecoute = -1;
+}
+
+void WebServer::on(const String& uri, HTTPMethod method, THandlerFunction fn) {
+    _routes.push_back({uri, method, fn});
+}
+
+/**
+ * @brief Accepte au plus un client et le sert entierement (comme l'ESP32)
+ */
+void WebServer::handleClient() {
+    if (_ecoute < 0) return;
+    _client = accept4(_ecoute, nullptr, nullptr, SOCK_CLOEXEC);
+    if (_client < 0) return;
+
+    timeval to{2, 0};
+    setsockopt(_client, SOL_SOCKET, SO_RCVTIMEO, &to, sizeof(to));
+    int un = 1;
+    setsockopt(_client, IPPROTO_TCP, TCP_NODELAY, &un, sizeof(un));
+
+    if (lireRequete()) traiter();
+    ::close(_client);
+    _client = -1;
+}
+
+//! Aiguillage vers la route (requete deja lue dans _uri, _method, _args)
+void WebServer::traiter() {
+    _nbRequetes++;
+    _enTetesReponse.clear();
+    _contentLength = CONTENT_LENGTH_NOT_SET;
+    _enTetesEnvoyes = false;
+    _chunked = false;
+
+    bool trouve = false;
+    for (auto& r : _routes) {
+        if (r.uri == _uri && (r.method == HTTP_ANY || r.method == _method)) {
+            r.fn();
+            trouve = true;
+            break;
+        }
+    }
+    if (!trouve) {
+        if (_notFound) _notFound();
+        else send(404, "text/plain", "Not found");
+    }
+    if (_chunked) ecrire("0\r\n\r\n", 5);
+}
+
+size_t WebServer::appeler(HTTPMethod method, const char* uri, const char* requete) {
+    _args.clear();
+    _headers.clear();
+    _method = method;
+    _uri = uri;
+    if (requete) analyserArguments(requete, _args);
+
+    _sortie.clear();
+    _client = CLIENT_MEMOIRE;
+    traiter();
+    _client = -1;
+    return _sortie.size();
+}
+
+bool WebServer::lireRequete() {
+    std::string brut;
+    char buf[2048];
+    size_t finEnTetes;
+    while ((finEnTetes = brut.find("\r\n\r\n")) == std::string::npos) {
+        ssize_t n = recv(_client, buf, sizeof(buf), 0);
+        if (n <= 0 || brut.size() > 16384) return false;
+        brut.append(buf, n);
+    }
+
+    _args.clear();
+    _headers.clear();
+    size_t finLigne = brut.find("\r\n");
+    std::string ligne = brut.substr(0, finLigne);
+    size_t e1 = ligne.find(' '), e2 = ligne.find(' ', e1 + 1);
+    if (e1 == std::string::npos || e2 == std::string::npos) return false;
+    std::string methode = ligne.substr(0, e1);
+    std::string cible = ligne.substr(e1 + 1, e2 - e1 - 1);
+    _method = methode == "POST" ? HTTP_POST : methode == "PUT" ? HTTP_PUT : methode == "DELETE" ? HTTP_DELETE
+            : methode == "HEAD" ? HTTP_HEAD : methode == "OPTIONS" ? HTTP_OPTIONS : HTTP_GET;
+    size_t q = cible.find('?');
+    _uri = decoderUrl(cible.substr(0, q));
+    if (q != std::string::npos) analyserArguments(cible.substr(q + 1), _args);
+
+    size_t longueur = 0;
+    String type;
+    for (size_t p = finLigne + 2; p < finEnTetes;) {
+        size_t f = brut.find("\r\n", p);
+        std::string h = brut.substr(p, f - p);
+        size_t dp = h.find(':');
+        if (dp != std::string::npos) {
+            std::string v = h.substr(dp + 1);
+            v.erase(0, v.find_first_not_of(' '));
+            _headers.push_back({String(h.substr(0, dp)), String(v)});
+            String nom(h.substr(0, dp));
+            nom.toLowerCase();
+            if (nom == "content-length") longueur = strtoul(v.c_str(), nullptr, 10);
+            if (nom == "content-type") type = String(v);
+        }
+        p = f + 2;
+    }
+
+    std::string corps = brut.substr(finEnTetes + 4);
+    while (corps.size() < longueur) {
+        ssize_t n = recv(_client, buf, sizeof(buf), 0);
+        if (n <= 0) return false;
+        corps.append(buf, n);
+    }
+    if (longueur > 0) {
+        if (type.startsWith("application/x-www-form-urlencoded")) analyserArguments(corps, _args);
+        else _args.push_back({String("plain"), String(corps)});
+    }
+    return true;
+}
+
+String WebServer::arg(const String& name) const {
+    for (auto& a : _args) if (a.first == name) return a.second;
+    return String();
+}
+String WebServer::arg(int i) const { return i < (int)_args.size() ? _args[i].second : String(); }
+String WebServer::argName(int i) const { return i < (int)_args.size() ? _args[i].first : String(); }
+bool WebServer::hasArg(const String& name) const {
+    for (auto& a : _args) if (a.first == name) return true;
+    return false;
+}
+
+String WebServer::header(const String& name) const {
+    String n = name; n.toLowerCase();
+    for (auto& h : _headers) { String k = h.first; k.toLowerCase(); if (k == n) return h.second; }
+    return String();
+}
+bool WebServer::hasHeader(const String& name) const { return header(name).length() > 0; }
+
+void WebServer::ecrire(const char* data, size_t len) {
+    if (_client == CLIENT_MEMOIRE) { _sortie.append(data, len); return; }
+    while (len > 0) {
+        ssize_t n = ::send(_client, data, len, MSG_NOSIGNAL);
+        if (n <= 0) return;
+        data += n;
+        len -= n;
+    }
+}
+
+void WebServer::sendHeader(const String& name, const String& value, bool first) {
+    if (first) _enTetesReponse.insert(_enTetesReponse.begin(), {name, value});
+    else _enTetesReponse.push_back({name, value});
+}
+
+void WebServer::envoyerEnTetes(int code, const char* contentType, size_t len) {
+    std::string h = "HTTP/1.1 " + std::to_string(code) + " " + texteStatut(code) + "\r\n";
+    h += "Content-Type: " + std::string(contentType ? contentType : "text/html") + "\r\n";
+    if (_contentLength == CONTENT_LENGTH_UNKNOWN) {
+        h += "Transfer-Encoding: chunked\r\n";
+        _chunked = true;
+    } else {
+        h += "Content-Length: " + std::to_string(_contentLength != CONTENT_LENGTH_NOT_SET ? _contentLength : len) + "\r\n";
+    }
+    for (auto& e : _enTetesReponse) h += std::string(e.first.c_str()) + ": " + e.second.c_str() + "\r\n";
+    h += "Connection: close\r\n\r\n";
+    ecrire(h.data(), h.size());
+    _enTetesEnvoyes = true;
+}
+
+void WebServer::send(int code, const char* contentType, const String& content) {
+    send(code, contentType, content.c_str(), content.length());
+}
+
+void WebServer::send(int code, const char* contentType, const char* content, size_t len) {
+    if (_client == -1 || _enTetesEnvoyes) return;
+    envoyerEnTetes(code, contentType, len);
+    if (len > 0) sendContent(content, len);
+}
+
+void WebServer::sendContent(const char* content, size_t len) {
+    if (_client == -1) return;
+    if (!_chunked) { ecrire(content, len); return; }
+    if (len == 0) {                 // Fin du flux chunked (comme sur l'ESP32)
+        ecrire("0\r\n\r\n", 5);
+        _chunked = false;
+        return;
+    }
+    char tete[16];
+    int n = snprintf(tete, sizeof(tete), "%zx\r\n", len);
+    ecrire(tete, n);
+    ecrire(content, len);
+    ecrire("\r\n", 2);
+}
+
+size_t WebServer::streamFile(File& file, const String& contentType, int code) {
+    _contentLength = file.size();
+    envoyerEnTetes(code, contentType.c_str(), _contentLength);
+    uint8_t buf[1436];
+    size_t total = 0, n;
+    while ((n = file.read(buf, sizeof(buf))) > 0) { ecrire((const char*)buf, n); total += n; }
+    return total;
+}
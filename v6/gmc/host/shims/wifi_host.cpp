@@ -0,0 +1,96 @@
+/**
+ * @brief   Implementation hote de WiFi (radio simulee)
+ * @file    wifi_host.cpp
+ * @author  cgil
+ * @date    2026
+ */
+
+#include "WiFi.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <chrono>
+
+WiFiClass WiFi;
+
+namespace {
+std::mutex verrou;
+wifi_mode_t modeCourant = WIFI_OFF;
+std::atomic<wl_status_t> statut{WL_IDLE_STATUS};
+std::atomic<bool> boxPresente{getenv("GMC_WIFI_BOX") == nullptr || atoi(getenv("GMC_WIFI_BOX")) != 0};
+std::atomic<unsigned> generation{0};   // invalide les associations en cours
+String ssidCourant;
+std::vector<WiFiEventFuncCb> abonnes;
+
+void emettre(arduino_event_id_t evt) {
+    std::vector<WiFiEventFuncCb> copie;
+    { std::lock_guard<std::mutex> l(verrou); copie = abonnes; }
+    arduino_event_info_t info{};
+    for (auto& cb : copie) cb(evt, info);
+}
+}  // namespace
+
+void wifiHoteBoxPresente(bool presente) {
+    boxPresente = presente;
+    if (!presente && statut == WL_CONNECTED) {
+        generation++;
+        statut = WL_CONNECTION_LOST;
+        emettre(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    }
+}
+
+bool WiFiClass::mode(wifi_mode_t m) {
+    std::lock_guard<std::mutex> l(verrou);
+    if (!(m & WIFI_STA)) { generation++; statut = WL_DISCONNECTED; }
+    modeCourant = m;
+    return true;
+}
+
+wifi_mode_t WiFiClass::getMode() { std::lock_guard<std::mutex> l(verrou); return modeCourant; }
+
+wl_status_t WiFiClass::begin(const char* ssid, const char*) {
+    unsigned gen;
+    {
+        std::lock_guard<std::mutex> l(verrou);
+        ssidCourant = ssid;
+        gen = ++generation;
+    }
+    statut = WL_DISCONNECTED;
+    long delaiMs = getenv("GMC_WIFI_DELAI_MS") ? atol(getenv("GMC_WIFI_DELAI_MS")) : 300;
+    std::thread([gen, delaiMs]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delaiMs));
+        if (gen != generation) return;
+        if (boxPresente) {
+            statut = WL_CONNECTED;
+            emettre(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+        } else {
+            statut = WL_NO_SSID_AVAIL;
+            emettre(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+        }
+    }).detach();
+    return statut;
+}
+
+bool WiFiClass::disconnect(bool) {
+    generation++;
+    bool etaitConnecte = (statut == WL_CONNECTED);
+    statut = WL_DISCONNECTED;
+    if (etaitConnecte) emettre(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    return true;
+}
+
+wl_status_t WiFiClass::status() { return statut; }
+int8_t WiFiClass::RSSI() { return statut == WL_CONNECTED ? -55 : 0; }
+IPAddress WiFiClass::localIP() { return statut == WL_CONNECTED ? IPAddress(192, 168, 1, 48) : IPAddress(); }
+String WiFiClass::SSID() { std::lock_guard<std::mutex> l(verrou); return ssidCourant; }
+
+bool WiFiClass::softAP(const char* ssid, const char*) { return ssid && strlen(ssid) > 0; }
+bool WiFiClass::softAPdisconnect(bool) { return true; }
+
+int WiFiClass::onEvent(WiFiEventFuncCb cb) {
+    std::lock_guard<std::mutex> l(verrou);
+    abonnes.push_back(cb);
+    return (int)abonnes.size();
+}
@@ -0,0 +1,140 @@
+/**
+ * @brief   Essai d'endurance memoire du module gmc (construction hote)
+ * @file    soak_mem.cpp
+ * @author  cgil
+ * @date    avril 2026
+ *
+ * Lance setup() (qui demarre les taches, voir taches.h) puis enchaine des
+ * requetes HTTP sur les routes de Net, servies par la tache web.
+ * Mesures sur le tas simule (shims/tas_host.cpp) :
+ *   - allocations par requete (moyenne par route) : serveur web compris,
+ *     comme sur la cible (les autres taches n'allouent pas en regime etabli)
+ *   - tas libre, plus grand bloc libre et son minimum au fil du temps
+ *
+ *   make soak                              (20000 requetes)
+ *   make soak SOAK_REQUETES=500000         (plusieurs heures de trafic)
+ *
+ * Le rapport sort sur stderr, les traces du module sur stdout.
+ * La frequence de mesure est passee a 1 s (POST /api/config) pour que
+ * l'echantillonneur et le Dao travaillent pendant l'essai.
+ */
+
+#include <Arduino.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+
+void setup();
+
+struct RouteSoak {
+    const char* methode;
+    const char* uri;
+    const char* corps;
+    unsigned long nb;
+    unsigned long allocs;
+    unsigned long octets;
+};
+
+static RouteSoak routes[] = {
+    { "GET",  "/api/status",            nullptr, 0, 0, 0 },
+    { "GET",  "/api/history?ch=temp",   nullptr, 0, 0, 0 },
+    { "GET",  "/api/history?ch=hum",    nullptr, 0, 0, 0 },
+    { "GET",  "/api/wifi",              nullptr, 0, 0, 0 },
+    { "GET",  "/api/echant",            nullptr, 0, 0, 0 },
+    { "GET",  "/api/telemetrie",        nullptr, 0, 0, 0 },
+    { "GET",  "/api/stats",             nullptr, 0, 0, 0 },
+    { "GET",  "/api/alarmes",           nullptr, 0, 0, 0 },
+    { "GET",  "/api/gpio?masque=0x70000000000&valeur=0", nullptr, 0, 0, 0 },
+    { "GET",  "/api/config",            nullptr, 0, 0, 0 },
+    { "GET",  "/api/get_uptime?valeur=42", nullptr, 0, 0, 0 },
+    { "POST", "/api/config",            "freq=1", 0, 0, 0 },
+    { "GET",  "/style.css",             nullptr, 0, 0, 0 },
+};
+#define NB_ROUTES (int)(sizeof(routes) / sizeof(routes[0]))
+
+static int port = 0;
+
+/**
+ * @brief Une requete : envoi complet puis lecture jusqu'a la fermeture
+ * @return octets recus (0 si echec)
+ */
+static size_t requete(const RouteSoak& r) {
+    int s = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in a{};
+    a.sin_family = AF_INET;
+    a.sin_port = htons(port);
+    a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(s, (sockaddr*)&a, sizeof(a)) < 0) { close(s); return 0; }
+
+    char req[256];
+    int n = r.corps
+        ? snprintf(req, sizeof(req), "%s %s HTTP/1.1\r\nHost: gmc\r\nContent-Type: application/x-www-form-urlencoded\r\n"
+                   "Content-Length: %zu\r\nConnection: close\r\n\r\n%s", r.methode, r.uri, strlen(r.corps), r.corps)
+        : snprintf(req, sizeof(req), "%s %s HTTP/1.1\r\nHost: gmc\r\nConnection: close\r\n\r\n", r.methode, r.uri);
+    send(s, req, n, 0);
+
+    char buf[4096];
+    size_t total = 0;
+    ssize_t lu;
+    while ((lu = recv(s, buf, sizeof(buf), 0)) > 0) total += lu;
+    close(s);
+    return total;
+}
+
+int main() {
+    setenv("GMC_DELAI_ECHELLE", "0", 0);
+    setenv("GMC_DATA_DIR", "build/littlefs", 0);
+    //! le WebServer global lit GMC_HTTP_PORT avant main() : fixe par make soak
+    const char* envPort = getenv("GMC_HTTP_PORT");
+    port = envPort ? atoi(envPort) : 8080;
+    const char* env = getenv("SOAK_REQUETES");
+    unsigned long nbRequetes = env ? strtoul(env, nullptr, 10) : 20000;
+    unsigned long periode = nbRequetes / 20 ? nbRequetes / 20 : 1;
+
+    setup();
+    delay(200);
+
+    uint32_t minBloc = tasHotePlusGrandBloc();
+    uint32_t libreDepart = tasHoteLibre();
+    auto t0 = std::chrono::steady_clock::now();
+    unsigned long allocsFenetre = 0, echecs = 0;
+
+    fprintf(stderr, "\n%10s %8s %12s %10s %10s %12s\n", "requetes", "t (s)", "allocs/req", "libre", "bloc max", "bloc max min");
+    for (unsigned long i = 1; i <= nbRequetes; i++) {
+        RouteSoak& r = routes[i % NB_ROUTES];
+        unsigned long a0 = tasHoteNbAllocations();
+        size_t octets = requete(r);
+        unsigned long da = tasHoteNbAllocations() - a0;
+        if (octets == 0) echecs++;
+        r.nb++;
+        r.allocs += da;
+        r.octets += octets;
+        allocsFenetre += da;
+
+        uint32_t bloc = tasHotePlusGrandBloc();
+        if (bloc < minBloc) minBloc = bloc;
+
+        if (i % periode == 0) {
+            double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            fprintf(stderr, "%10lu %8.1f %12.1f %10u %10u %12u\n", i, t, (double)allocsFenetre / periode,
+                   tasHoteLibre(), bloc, minBloc);
+            allocsFenetre = 0;
+        }
+    }
+
+    fprintf(stderr, "\n%-28s %8s %12s %10s\n", "route", "nb", "allocs/req", "octets/req");
+    for (int k = 0; k < NB_ROUTES; k++) {
+        const RouteSoak& r = routes[k];
+        if (!r.nb) continue;
+        char nom[40];
+        snprintf(nom, sizeof(nom), "%s %s", r.methode, r.uri);
+        fprintf(stderr, "%-28s %8lu %12.1f %10lu\n", nom, r.nb, (double)r.allocs / r.nb, r.octets / r.nb);
+    }
+    fprintf(stderr, "\ntas : libre %u -> %u, plus grand bloc min %u / %u, echecs arene %lu, requetes en echec %lu\n",
+           libreDepart, tasHoteLibre(), minBloc, tasHoteTaille(), tasHoteNbEchecs(), echecs);
+    //! taches du module encore actives : pas de destructeurs statiques
+    fflush(stdout);
+    _exit(echecs != 0);
+}
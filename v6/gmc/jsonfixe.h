@@ -0,0 +1,186 @@
+/**
+ * @brief   Ecriture JSON dans un tampon fixe, sans allocation
+ * @file    jsonfixe.h
+ * @author  cgil
+   @version	1.0
+ * @date    avril 2026
+ *
+ * Remplace JsonDocument + String pour les reponses de Net et l'envoi cloud :
+ * le JSON est ecrit au fil de l'eau dans un tampon (pile ou statique).
+ * Si une fonction "vider" est fournie, le tampon plein lui est passe
+ * (envoi chunked sur la socket) et l'ecriture continue : la memoire reste
+ * constante quelle que soit la taille de la reponse.
+ *
+ *   char tampon[256];
+ *   JsonFixe j(tampon, sizeof(tampon));
+ *   j.objet().champ("temp", 215).champ("date", "--:--");
+ *   j.tableau("histo"); for (...) j.val(n); j.fin();
+ *   j.fin();                          // j.c_str() : {"temp":215,"date":"--:--","histo":[...]}
+ */
+
+#ifndef JSONFIXE_H
+#define JSONFIXE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+//! Recoit un morceau de JSON quand le tampon est plein (et a la fin)
+typedef void (*ViderJson)(void* ctx, const char* data, size_t n);
+
+//! Profondeur maxi d'imbrication objets/tableaux
+#define JSONFIXE_PROFONDEUR 16
+
+class JsonFixe {
+private:
+    char* _tampon;
+    size_t _taille;             //! capacite utile ('\0' final en plus)
+    size_t _pos = 0;
+    size_t _total = 0;          //! octets deja passes a vider()
+    ViderJson _vider;
+    void* _ctx;
+    bool _deborde = false;
+
+    //! Un bit par niveau : 1 = premier element (pas de virgule), et type ouvert
+    uint32_t _premiers = 1;
+    uint32_t _tableaux = 0;
+    int _profondeur = 0;
+
+    void ecrire(const char* s, size_t n) {
+        while (n) {
+            if (_pos == _taille) {
+                if (!_vider) { _deborde = true; return; }
+                vider();
+            }
+            size_t c = (n < _taille - _pos) ? n : _taille - _pos;
+            memcpy(_tampon + _pos, s, c);
+            _pos += c; s += c; n -= c;
+        }
+    }
+    void ecrire(char c) { ecrire(&c, 1); }
+    void ecrire(const char* s) { ecrire(s, strlen(s)); }
+
+    //! Virgule si ce n'est pas le premier element du niveau
+    void element() {
+        uint32_t bit = (uint32_t)1 << _profondeur;
+        if (_premiers & bit) _premiers &= ~bit;
+        else ecrire(',');
+    }
+
+    void ouvrir(char c, bool tableau) {
+        ecrire(c);
+        if (_profondeur + 1 >= JSONFIXE_PROFONDEUR) { _deborde = true; return; }
+        _profondeur++;
+        _premiers |= (uint32_t)1 << _profondeur;
+        if (tableau) _tableaux |= (uint32_t)1 << _profondeur;
+        else _tableaux &= ~((uint32_t)1 << _profondeur);
+    }
+
+    void texte(const char* s) {
+        ecrire('"');
+        if (s) {
+            for (; *s; s++) {
+                unsigned char c = *s;
+                if (c == '"' || c == '\\') { ecrire('\\'); ecrire((char)c); }
+                else if (c == '\n') ecrire("\\n", 2);
+                else if (c == '\r') ecrire("\\r", 2);
+                else if (c == '\t') ecrire("\\t", 2);
+                else if (c < 0x20) { char u[8]; snprintf(u, sizeof(u), "\\u%04x", c); ecrire(u, 6); }
+                else ecrire((char)c);
+            }
+        }
+        ecrire('"');
+    }
+
+    void nombre(long long v) { char b[24]; int n = snprintf(b, sizeof(b), "%lld", v); ecrire(b, n); }
+    void nombre(unsigned long long v) { char b[24]; int n = snprintf(b, sizeof(b), "%llu", v); ecrire(b, n); }
+
+public:
+    /**
+     * @param tampon  zone d'ecriture (un octet est reserve pour le '\0')
+     * @param vider   optionnel : appele tampon plein et par vider() ;
+     *                sans lui, un depassement est signale par deborde()
+     */
+    JsonFixe(char* tampon, size_t taille, ViderJson vider = nullptr, void* ctx = nullptr)
+        : _tampon(tampon), _taille(taille ? taille - 1 : 0), _vider(vider), _ctx(ctx) {}
+
+    //! Ouvre un objet (ou un membre objet si cle)
+    JsonFixe& objet(const char* cle = nullptr) { if (cle) this->cle(cle); element(); ouvrir('{', false); return *this; }
+    //! Ouvre un tableau (ou un membre tableau si cle)
+    JsonFixe& tableau(const char* cle = nullptr) { if (cle) this->cle(cle); element(); ouvrir('[', true); return *this; }
+    //! Ferme le dernier objet ou tableau ouvert
+    JsonFixe& fin() {
+        if (_profondeur == 0) return *this;
+        ecrire((_tableaux & ((uint32_t)1 << _profondeur)) ? ']' : '}');
+        _profondeur--;
+        return *this;
+    }
+
+    //! Nom de membre ; la valeur suit (val, objet, tableau)
+    JsonFixe& cle(const char* nom) {
+        element();
+        texte(nom);
+        ecrire(':');
+        //! la valeur qui suit ne doit pas ajouter de virgule
+        _premiers |= (uint32_t)1 << _profondeur;
+        return *this;
+    }
+
+    // Valeurs (element de tableau ou apres cle())
+    JsonFixe& val(const char* s) { element(); if (s) texte(s); else ecrire("null", 4); return *this; }
+    JsonFixe& val(bool b) { element(); if (b) ecrire("true", 4); else ecrire("false", 5); return *this; }
+    JsonFixe& val(int v) { element(); nombre((long long)v); return *this; }
+    JsonFixe& val(long v) { element(); nombre((long long)v); return *this; }
+    JsonFixe& val(long long v) { element(); nombre(v); return *this; }
+    JsonFixe& val(unsigned int v) { element(); nombre((unsigned long long)v); return *this; }
+    JsonFixe& val(unsigned long v) { element(); nombre((unsigned long long)v); return *this; }
+    JsonFixe& val(unsigned long long v) { element(); nombre(v); return *this; }
+    JsonFixe& val(double v, int decimales = 2) {
+        element();
+        char b[32];
+        int n = snprintf(b, sizeof(b), "%.*f", decimales, v);
+        ecrire(b, n);
+        return *this;
+    }
+    JsonFixe& null() { element(); ecrire("null", 4); return *this; }
+
+    /**
+     * @brief Valeur en virgule fixe (brut / echelle, echelle puissance de 10)
+     *        sans passer par un float : 215, 10 -> 21.5
+     */
+    JsonFixe& fixe(long brut, int echelle) {
+        if (echelle <= 1) return val(brut);
+        int decimales = 0;
+        for (long e = echelle; e > 1; e /= 10) decimales++;
+        element();
+        char b[24];
+        unsigned long a = (brut < 0) ? (unsigned long)(-brut) : (unsigned long)brut;
+        int n = snprintf(b, sizeof(b), "%s%lu.%0*lu", (brut < 0) ? "-" : "",
+                         a / echelle, decimales, a % echelle);
+        ecrire(b, n);
+        return *this;
+    }
+
+    //! Membre : cle + valeur
+    template <typename T>
+    JsonFixe& champ(const char* nom, T v) { cle(nom); return val(v); }
+    JsonFixe& champ(const char* nom, double v, int decimales) { cle(nom); return val(v, decimales); }
+
+    //! Passe le contenu du tampon a la fonction vider (fin de reponse chunked)
+    void vider() {
+        if (_vider && _pos) {
+            _vider(_ctx, _tampon, _pos);
+            _total += _pos;
+            _pos = 0;
+        }
+    }
+
+    //! JSON du tampon (termine par '\0') : toute la reponse si rien n'a ete vide
+    const char* c_str() { _tampon[_pos] = 0; return _tampon; }
+    size_t longueur() const { return _pos; }
+    size_t total() const { return _total + _pos; }
+    bool deborde() const { return _deborde; }
+    bool flux() const { return _total > 0; }
+};
+
+#endif
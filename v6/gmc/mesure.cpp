@@ -22,13 +22,16 @@
 /**
  * @brief constructeur
  */
-Mesure::Mesure(int _id_mesure, String _date_creation, int _valeur_tdc) \
-    : id_mesure(_id_mesure), date_creation(_date_creation), valeur_tdc(_valeur_tdc) 
+Mesure::Mesure(int _id_mesure, const char* _date_creation, int _valeur_tdc, int _canal) \
+    : id_mesure(_id_mesure), valeur_tdc(_valeur_tdc), canal(_canal) 
 {
- 
+    setDateCreation(_date_creation);
 }
 
 Mesure::Mesure() 
-{}
+    : id_mesure(0), valeur_tdc(0), canal(0)
+{
+    date_creation[0] = 0;
+}
 
  
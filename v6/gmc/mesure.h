@@ -13,6 +13,9 @@
 
 #include <Arduino.h>
 
+//! "JJ/MM/AAAA HH:MM:SS" + '\0'
+#define MESURE_TAILLE_DATE 20
+
 /** \class  	Mesure
 
  * \brief		Classe Mesure 
@@ -30,18 +33,22 @@ private:
         // identifiant primary unique
         int id_mesure;
 
-        //! date de creation de lenreg
-        String date_creation; 
+        //! date de creation de lenreg (tampon fixe : une Mesure ne touche pas au tas)
+        char date_creation[MESURE_TAILLE_DATE];
         
         //! Valeur temperature en DIXIEMES de celcius (toujours en INT pas de virgules)
+        //!   (ou valeur brute du canal, voir canaux.h)
         int valeur_tdc; 
+
+        //! Canal de la valeur (CANAL_TEMP par defaut)
+        int canal;
     
 public:
         /**
         * \brief	Constructeurs de la classe 
                          parametrique ou pas
         */
-        Mesure(int _id_mesure, String _date_creation, int _valeur_tdc);
+        Mesure(int _id_mesure, const char* _date_creation, int _valeur_tdc, int _canal = 0);
         Mesure();
 
         /**
@@ -52,14 +59,16 @@ public:
         inline void setIdMesure (int _id_mesure)
             {id_mesure=_id_mesure;};
 
-        inline String getDateCreation () const {return date_creation;};
-        inline void setDateCreation (String _date_creation)
-            {date_creation=_date_creation;};
+        inline const char* getDateCreation () const {return date_creation;};
+        inline void setDateCreation (const char* _date_creation)
+            {strlcpy(date_creation, _date_creation, sizeof(date_creation));};
 
         inline int getValeurTdc () const {return valeur_tdc;};
         inline void setValeurTdc (int _valeur_tdc)
             {valeur_tdc=_valeur_tdc;};
 
+        inline int getCanal () const {return canal;};
+
 };
 
 #endif
@@ -27,67 +27,153 @@
 extern Dao* dao; 
 
 Net::Net(WebServer& webServer, Conf* config) 
-    : _webServer(webServer), _conf(config) {}
+    : _webServer(webServer), _conf(config) {
+    //! Envoi cloud : la tache uplink ne lit pas la Conf, l'URL lui est postee
+    //!   (la cadence suit les lignes stockees, donc la frequence de mesure)
+    _boiteUrl = xQueueCreate(1, CONF_TAILLE_TEXTE);
+    xQueueOverwrite(_boiteUrl, _conf->getBoxCloudUrl());
+    _conf->abonner(CONF_BOX_CLOUD_URL, [this](MasqueConf) {
+        xQueueOverwrite(_boiteUrl, _conf->getBoxCloudUrl());
+    });
+
+    //! Format de l'envoi cloud, lu par la tache uplink
+    _cloudCbor = _conf->cloudEnCbor();
+    _conf->abonner(CONF_CLOUD_FORMAT, [this](MasqueConf) {
+        _cloudCbor = _conf->cloudEnCbor();
+    });
+
+    //! Reseau : nouveaux identifiants Box => reconnexion par gererWifi()
+    _conf->abonner(CONF_BOX_SSID | CONF_BOX_PWD, [this](MasqueConf) {
+        _relancerWifi = true;
+    });
+}
 
 
 /**
-    @brief : méthode pour envoyer la donnée
+    @brief : POST d'un corps JSON vers l'URL cloud
+    @return code HTTP (<= 0 : erreur, 0 : pas de WiFi)
 */
-void Net::sendToCloud(float valTemp, bool etatVoyant, String cloudUrl) {
-    if (WiFi.status() == WL_CONNECTED) {
-        HTTPClient http;
+int Net::posterCloud(const char* cloudUrl, const char* corps, size_t longueur, const char* type) {
+    if (WiFi.status() != WL_CONNECTED) return 0;
+    HTTPClient http;
 
-         Serial.print("☁️ Tentative d'envoi vers le cloud ["); Serial.print(cloudUrl); Serial.println("]...");
-        
-        // URL de ton nouveau dossier sur Alwaysdata
-        //http.begin("http://btscielinfo.alwaysdata.net/projet/index.php");
-        http.begin(cloudUrl);
-        http.addHeader("Content-Type", "application/json");
+    // URL de ton nouveau dossier sur Alwaysdata
+    //http.begin("http://btscielinfo.alwaysdata.net/projet/index.php");
+    http.begin(cloudUrl);
+    http.addHeader("Content-Type", type);
 
-        // On prépare le JSON
-        // ex: {"temp": 215, "voyant": true}
-        String json = "{";
-        json += "\"temp\":" + String(valTemp) + ",";
-        json += "\"voyant\":" + String(etatVoyant ? "true" : "false");
-        json += "}";
+    // Envoi du POST
+    int httpResponseCode = http.POST((uint8_t*)corps, longueur);
 
-        // Envoi du POST
-        int httpResponseCode = http.POST(json);
+    if (httpResponseCode > 0) {
+        Serial.print("✅ Cloud OK, code : ");
+        Serial.println(httpResponseCode);
+    } else {
+        Serial.print("❌ Erreur envoi Cloud : ");
+        Serial.println(httpResponseCode);
+    }
+    http.end();
+    return httpResponseCode;
+}
 
-        if (httpResponseCode > 0) {
-            Serial.print("✅ Cloud OK, code : ");
-            Serial.println(httpResponseCode);
-        } else {
-            Serial.print("❌ Erreur envoi Cloud : ");
-            Serial.println(httpResponseCode);
-        }
-        http.end();
+
+/**
+    @brief : méthode pour envoyer la donnée d'un canal
+        la cle porte le nom du canal : {"canal":"temp","temp":215,"voyant":false}
+*/
+void Net::sendToCloud(int canal, int valeur, bool etatVoyant, const char* cloudUrl) {
+    if (WiFi.status() == WL_CONNECTED) {
+         Serial.print("☁️ Tentative d'envoi vers le cloud ["); Serial.print(cloudUrl); 
+         Serial.print("] canal "); Serial.print(CANAUX[canal].nom); Serial.println("...");
+
+        // On prépare le JSON (tampon de la pile, pas de String)
+        // ex: {"canal":"temp","temp": 215, "voyant": true}
+        char corps[96];
+        JsonFixe json(corps, sizeof(corps));
+        json.objet()
+            .champ("canal", CANAUX[canal].nom)
+            .champ(CANAUX[canal].nom, valeur)
+            .champ("voyant", etatVoyant)
+            .fin();
+
+        posterCloud(cloudUrl, json.c_str(), json.longueur());
     }
 }
 
 
-void Net::gererEnvoiDataCloud() {
-    static unsigned long dernierEnvoi = 0;
+void Net::envoyerLigne(const LigneMesure& ligne) {
+    // URL courante (boite aux lettres partagee avec la tache alerte, non bloquant)
+    xQueuePeek(_boiteUrl, _urlCloud, 0);
 
-    // On utilise la valeur de frequences
-    unsigned long intervalle = this->_conf->getFrequenceMesures()*1000;
-    
-    if (millis() - dernierEnvoi >= intervalle) { 
-        dernierEnvoi = millis();
+    // Voyant : une regle d'alarme au moins est active (alarmes.h)
+    bool monEtatVoyant = alarmes->getVoyant();
 
-        int derniereValTemp = 0;
-        std::vector<Mesure> mesures = dao->accederTableMesure_lireDesMesures(1);
-        if (!mesures.empty()) 
-            derniereValTemp = mesures[0].getValeurTdc();
-        //bool monEtat = digitalRead(PIN_ALERTE); // Exemple de booléen
-        bool monEtatVoyant = false;
+    // CBOR : toute la ligne en un seul POST
+    if (_cloudCbor) {
+        envoyerLigneCbor(ligne, monEtatVoyant);
+        return;
+    }
 
-        // On utilise l'URL stockée dans les Prefs !
-        sendToCloud(derniereValTemp, monEtatVoyant, _conf->getBoxCloudUrl());
+    // Un envoi par canal declare "cloud" dans canaux.h
+    for (int c = 0; c < NB_CANAUX; c++) {
+        if (!CANAUX[c].cloud) continue;
+        sendToCloud(c, ligne.valeurs[c], monEtatVoyant, _urlCloud);
     }
 }
 
 
+/**
+    @brief : ligne complete en CBOR (Content-Type application/cbor), un POST :
+        {"t": epoch, "voyant": false, "temp": 215, "hum": 480, "alarme": 0}
+        valeurs brutes (voir CANAUX[].echelle), ~30 octets au lieu de 3 JSON
+*/
+void Net::envoyerLigneCbor(const LigneMesure& ligne, bool voyant) {
+    if (WiFi.status() != WL_CONNECTED) return;
+    Serial.print("☁️ Tentative d'envoi CBOR vers le cloud ["); Serial.print(_urlCloud); Serial.println("]...");
+
+    int nb = 0;
+    for (int c = 0; c < NB_CANAUX; c++) if (CANAUX[c].cloud) nb++;
+
+    uint8_t corps[32 + NB_CANAUX * 24];
+    CborFixe cbor(corps, sizeof(corps));
+    cbor.map(2 + nb)
+        .champ("t", (long long)ligne.date)
+        .champ("voyant", voyant);
+    for (int c = 0; c < NB_CANAUX; c++) {
+        if (CANAUX[c].cloud) cbor.champ(CANAUX[c].nom, ligne.valeurs[c]);
+    }
+    posterCloud(_urlCloud, (const char*)cbor.donnees(), cbor.longueur(), "application/cbor");
+}
+
+
+/**
+    @brief : push immediat d'un changement d'etat d'alarme (tache alerte)
+        meme format que les mesures (valeur brute du canal), plus la regle :
+        {"canal":"temp","temp":315,"voyant":true,"alarme":"temp_haute","niveau":"critique","etat":"active"}
+    @return true si le cloud a accepte le POST
+*/
+bool Net::envoyerAlarme(const EvenementAlarme& e) {
+    char url[CONF_TAILLE_TEXTE] = "";
+    xQueuePeek(_boiteUrl, url, 0);
+
+    const Regle& r = REGLES[e.regle];
+    char corps[192];
+    JsonFixe json(corps, sizeof(corps));
+    json.objet()
+        .champ("canal", CANAUX[r.canal].nom)
+        .champ(CANAUX[r.canal].nom, e.valeur)
+        .champ("voyant", alarmes->getVoyant())
+        .champ("alarme", r.nom)
+        .champ("niveau", Alarmes::nomNiveau(r.niveau))
+        .champ("etat", e.active ? "active" : "retombee")
+        .fin();
+
+    Serial.printf("🚨 Alarme %s %s (valeur %d) -> cloud\n", r.nom, e.active ? "active" : "retombee", e.valeur);
+    int code = posterCloud(url, json.c_str(), json.longueur());
+    return code > 0 && code < 300;
+}
+
+
 bool Net::begin() {
    Serial.print("\t🛠 Montage LittleFS :");
     
@@ -270,6 +356,52 @@ bool Net::begin() {
 }
 */
 
+/**
+ * @brief Valeur en virgule fixe dans un tampon (215, 10 -> "21.5"),
+ *        comme JsonFixe::fixe() ; retourne la longueur ecrite
+ */
+static size_t formaterFixe(char* b, size_t taille, long brut, int echelle) {
+    int n;
+    if (echelle <= 1) {
+        n = snprintf(b, taille, "%ld", brut);
+    } else {
+        int decimales = 0;
+        for (long e = echelle; e > 1; e /= 10) decimales++;
+        unsigned long a = (brut < 0) ? (unsigned long)(-brut) : (unsigned long)brut;
+        n = snprintf(b, taille, "%s%lu.%0*lu", (brut < 0) ? "-" : "", a / echelle, decimales, a % echelle);
+    }
+    return (n < 0) ? 0 : ((size_t)n < taille ? (size_t)n : taille - 1);
+}
+
+/**
+ * @brief Lit une sequence "masque:valeur:duree_ms,..." (masque et valeur en
+ *        decimal ou 0x...) ; retourne le nombre d'etapes, -1 si invalide
+ */
+static int lireEtapes(const char* texte, EtapeGpio* etapes, int max) {
+    int nb = 0;
+    const char* p = texte;
+    while (*p) {
+        if (nb == max) return -1;
+        char* fin;
+        etapes[nb].masque = strtoull(p, &fin, 0);
+        if (*fin != ':') return -1;
+        etapes[nb].valeur = strtoull(fin + 1, &fin, 0);
+        if (*fin != ':') return -1;
+        etapes[nb].dureeMs = strtoul(fin + 1, &fin, 10);
+        if (*fin != ',' && *fin != 0) return -1;
+        nb++;
+        p = (*fin == ',') ? fin + 1 : fin;
+    }
+    return nb;
+}
+
+//! Masque GPIO en hexadecimal (les bits 32..53 depassent un entier JSON 32 bits)
+static const char* masqueHexa(char* b, size_t taille, uint64_t m) {
+    snprintf(b, taille, "0x%llx", (unsigned long long)m);
+    return b;
+}
+
+
 /**
  * @section GUIDE_PEDAGOGIQUE_V5
  * * COMMENT AJOUTER UNE NOUVELLE INTERACTION (EX: UN BOUTON) :
@@ -280,22 +412,26 @@ bool Net::begin() {
  * fetch('/api/ma-route').then(res => res.json()).then(data => ...); 
  * }
  * * 3. DANS LE C++ (ici) : Créer le "Slot" (la Route)
- * _webServer.on("/api/ma-route", HTTP_GET, [this](){
+ * route("/api/ma-route", HTTP_GET, [this](){
  * // Faire l'action C++ (ex: digitalWrite)
  * _webServer.send(200, "application/json", "{\"status\":\"ok\"}");
  * });
  */
 void Net::setupRoutes() {
 
+    //! En-tetes lus par les routes (le WebServer ne garde que ceux-ci)
+    static const char* entetes[] = { "Accept" };
+    _webServer.collectHeaders(entetes, 1);
+
     // --- 1. ROUTES POUR LES PAGES (Interface Utilisateur) ---
     
-    _webServer.on("/", HTTP_GET, [this]() {
+    route("/", HTTP_GET, [this]() {
         if (!handleFileRead("/index.html")) {
             _webServer.send(404, "text/plain", "index.html introuvable");
         }
     });
 
-    _webServer.on("/config", HTTP_GET, [this]() {
+    route("/config", HTTP_GET, [this]() {
         handleFileRead("/config.html");
     });
 
@@ -303,91 +439,277 @@ void Net::setupRoutes() {
     // --- 2. API : ROUTES DE DONNÉES (Le "Back-end") ---
 
     // [ROUTE STATUS] : Appelée automatiquement toutes les 15s par le timer JS
-    _webServer.on("/api/status", HTTP_GET, [this]() {
-        JsonDocument doc; 
-        
-        // Récupération de la dernière mesure via le DAO
-        std::vector<Mesure> mesures = dao->accederTableMesure_lireDesMesures(1);
+    route("/api/status", HTTP_GET, [this]() {
+        ReponseJson j(_webServer);
+        j.objet();
         
-        if (!mesures.empty()) {
-            doc["temp"] = mesures[0].getValeurTdc(); // Valeur brute (ex: 215 pour 21.5)
-            doc["date"] = mesures[0].getDateCreation();
-        } else {
-            doc["temp"] = 0;
-            doc["date"] = "--:--";
+        // Récupération de la dernière mesure via le DAO (Mesure sur la pile)
+        int nb = dao->parcourirMesures(1, CANAL_TEMP, [&j](const Mesure& m) {
+            j.champ("temp", m.getValeurTdc()); // Valeur brute (ex: 215 pour 21.5)
+            j.champ("date", m.getDateCreation());
+        });
+        if (nb == 0) {
+            j.champ("temp", 0);
+            j.champ("date", "--:--");
         }
 
-        doc["uptime"] = millis() / 1000;
-        
-        String response;
-        serializeJson(doc, response);
-        _webServer.send(200, "application/json", response);
+        // Derniere valeur de chaque canal (brute, voir canaux.h)
+        j.objet("canaux");
+        for (int c = 0; c < NB_CANAUX; c++) {
+            j.champ(CANAUX[c].nom, dao->derniereValeur(c));
+        }
+        j.fin();
+
+        j.champ("uptime", millis() / 1000);
+        j.fin();
+        j.envoyer();
     });
 
    
 
+    // [ROUTE HISTORY] : Historique d'un canal, ?ch=temp|hum|alarme (ou 0,1,2)
+    //                  JSON, ou CBOR si demande (?format=cbor, Accept: application/cbor)
+    route("/api/history", HTTP_GET, [this]() {
+        int canal = chercherCanal(_webServer.arg("ch").c_str());
+        if (canal < 0) {
+            _webServer.send(400, "application/json", "{\"erreur\":\"canal inconnu\"}");
+            return;
+        }
+
+        // ?n= : profondeur (defaut 1 heure, jusqu'a 7 jours avec l'anneau PSRAM)
+        int n = _webServer.hasArg("n") ? atoi(_webServer.arg("n").c_str()) : DAO_NB_MESURES;
+        if (n <= 0 || n > dao->capacite()) n = dao->capacite();
+
+        // CBOR : dates epoch et valeurs brutes en deltas, du plus recent au plus ancien
+        //   {"canal":"temp","echelle":10,"d":[t0, v0, t1-t0, v1-v0, ...]}
+        if (accepteCbor()) {
+            ReponseCbor c(_webServer);
+            c.map(3).champ("canal", CANAUX[canal].nom).champ("echelle", CANAUX[canal].echelle);
+            c.cle("d").tableau();
+            int32_t tPrec = 0;
+            int vPrec = 0;
+            dao->parcourirBrut(n, canal, [&](int i, int32_t t, int16_t v) {
+                c.entier(i ? (long long)t - tPrec : t);
+                c.entier(i ? v - vPrec : v);
+                tPrec = t;
+                vPrec = v;
+            });
+            c.fin();
+            c.envoyer();
+            return;
+        }
+
+        ReponseJson j(_webServer);
+        j.tableau();
+        
+        // On demande les dernières mesures du canal au DAO (sans vector)
+        dao->parcourirMesures(n, canal, [&j, canal](const Mesure& m) {
+            j.objet();
+            j.cle("v").fixe(m.getValeurTdc(), CANAUX[canal].echelle); // La valeur (21.5)
+            j.champ("t", m.getDateCreation());    // La date
+            j.fin();
+        });
+
+        j.fin();
+        j.envoyer();
+    });
+
+    // [ROUTE STATS] : min, max, moyenne, ecart-type glissants par fenetre (voir stats.h)
+    //                ?ch=temp|hum|alarme pour un seul canal, tous sinon
+    route("/api/stats", HTTP_GET, [this]() {
+        int seul = _webServer.hasArg("ch") ? chercherCanal(_webServer.arg("ch").c_str()) : -1;
+        if (_webServer.hasArg("ch") && seul < 0) {
+            _webServer.send(400, "application/json", "{\"erreur\":\"canal inconnu\"}");
+            return;
+        }
+
+        ReponseJson j(_webServer);
+        j.objet();
+        for (int c = 0; c < NB_CANAUX; c++) {
+            if (seul >= 0 && c != seul) continue;
+            int echelle = CANAUX[c].echelle;
+            j.objet(CANAUX[c].nom);
+            for (int f = 0; f < NB_FENETRES; f++) {
+                ResumeStats r;
+                dao->lireStats(f, c, r);
+                j.objet(FENETRES_STATS[f].nom);
+                j.champ("n", r.n);
+                j.cle("min").fixe(r.min, echelle);
+                j.cle("max").fixe(r.max, echelle);
+                j.champ("moy", (double)r.moyenne / echelle, 2);
+                j.champ("ecart_type", (double)r.ecartType / echelle, 2);
+                j.fin();
+            }
+            j.fin();
+        }
+        j.fin();
+        j.envoyer();
+    });
+
+    // [ROUTE ALARMES] : etat des regles, voyant, latence des push cloud (voir alarmes.h)
+    route("/api/alarmes", HTTP_GET, [this]() {
+        ReponseJson j(_webServer);
+        j.objet();
+        j.champ("voyant", alarmes->getVoyant());
+        j.champ("niveau", Alarmes::nomNiveau(alarmes->getNiveau()));
+
+        j.tableau("regles");
+        for (int i = 0; i < NB_REGLES; i++) {
+            const Regle& r = REGLES[i];
+            j.objet();
+            j.champ("nom", r.nom);
+            j.champ("canal", CANAUX[r.canal].nom);
+            j.champ("type", Alarmes::nomType(r.type));
+            j.champ("seuil", r.seuil);
+            j.champ("niveau", Alarmes::nomNiveau(r.niveau));
+            j.champ("active", alarmes->estActive(i));
+            j.champ("declenchements", alarmes->getNbDeclenchements(i));
+            j.fin();
+        }
+        j.fin();
+
+        //! detection (tache acquisition) -> POST termine (tache alerte)
+        j.objet("push");
+        j.champ("nb", alarmes->getNbPush());
+        j.champ("echecs", alarmes->getNbEchecsPush());
+        j.champ("derniere_us", alarmes->getDerniereLatenceUs());
+        j.champ("max_us", alarmes->getMaxLatenceUs());
+        j.fin();
+
+        j.fin();
+        j.envoyer();
+    });
+
+    // [ROUTE EXPORT] : tout l'historique stocke, en flux (memoire constante)
+    //   ?format=csv|ndjson (defaut csv) &from=&to= (secondes epoch, bornes incluses)
+    route("/api/export", HTTP_GET, [this]() {
+        bool csv = !_webServer.hasArg("format") || strcmp(_webServer.arg("format").c_str(), "csv") == 0;
+        if (!csv && strcmp(_webServer.arg("format").c_str(), "ndjson") != 0) {
+            _webServer.send(400, "application/json", "{\"erreur\":\"format inconnu (csv, ndjson)\"}");
+            return;
+        }
+        int32_t depuis = _webServer.hasArg("from") ? (int32_t)atol(_webServer.arg("from").c_str()) : 0;
+        int32_t jusqua = _webServer.hasArg("to") ? (int32_t)atol(_webServer.arg("to").c_str()) : INT32_MAX;
+
+        _webServer.sendHeader("Content-Disposition", csv ? "attachment; filename=\"gmc.csv\""
+                                                         : "attachment; filename=\"gmc.ndjson\"");
+        ReponseFlux flux(_webServer, csv ? "text/csv" : "application/x-ndjson");
+        char ligne[48 + NB_CANAUX * 24];
+
+        if (csv) {
+            // Entete : t (epoch), date lisible, un canal par colonne (valeurs mises a l'echelle)
+            size_t n = snprintf(ligne, sizeof(ligne), "t,date");
+            for (int c = 0; c < NB_CANAUX && n < sizeof(ligne); c++)
+                n += snprintf(ligne + n, sizeof(ligne) - n, ",%s", CANAUX[c].nom);
+            flux.ecrire(ligne);
+            flux.ecrire("\n", 1);
+        }
+
+        dao->parcourirLignes(depuis, jusqua, [&](int32_t date, const int16_t valeurs[NB_CANAUX]) {
+            if (csv) {
+                time_t t = date;
+                struct tm tm_info;
+                localtime_r(&t, &tm_info);
+                size_t n = snprintf(ligne, sizeof(ligne), "%ld,", (long)date);
+                n += strftime(ligne + n, sizeof(ligne) - n, "%Y-%m-%d %H:%M:%S", &tm_info);
+                for (int c = 0; c < NB_CANAUX && n < sizeof(ligne); c++) {
+                    ligne[n++] = ',';
+                    n += formaterFixe(ligne + n, sizeof(ligne) - n, valeurs[c], CANAUX[c].echelle);
+                }
+                if (n < sizeof(ligne)) ligne[n++] = '\n';
+                flux.ecrire(ligne, n);
+            } else {
+                JsonFixe j(ligne, sizeof(ligne));
+                j.objet().champ("t", (long)date);
+                for (int c = 0; c < NB_CANAUX; c++) j.cle(CANAUX[c].nom).fixe(valeurs[c], CANAUX[c].echelle);
+                j.fin();
+                flux.ecrire(j.c_str(), j.longueur());
+                flux.ecrire("\n", 1);
+            }
+        });
+        flux.terminer();
+    });
+
     // [ROUTE GET_UPTIME] :  Reçoit une valeur et répond
-    _webServer.on("/api/get_uptime", HTTP_GET, [this]() {
-        String message = "Aucune valeur";
+    route("/api/get_uptime", HTTP_GET, [this]() {
+        char message[64] = "Aucune valeur";
          Serial.print("/api/get_uptime...");
         
         // On vérifie si l'argument "valeur" est présent dans l'URL
         if (_webServer.hasArg("valeur")) {
-            message = _webServer.arg("valeur");
+            strlcpy(message, _webServer.arg("valeur").c_str(), sizeof(message));
             Serial.print("📥 Valeur uptime reçue du Web : ");
             Serial.println(message);
             
             // Exemple : on fait clignoter la LED selon la valeur reçue
-            // flashLED(message.toInt()); 
+            // flashLED(atoi(message)); 
         }
 
-        JsonDocument doc;
-        doc["status"] = "OK";
-        doc["recu"] = message; // On renvoie la valeur pour confirmation
-        
-        String response;
-        serializeJson(doc, response);
-        _webServer.send(200, "application/json", response);
+        ReponseJson j(_webServer);
+        j.objet();
+        j.champ("status", "OK");
+        j.champ("recu", message); // On renvoie la valeur pour confirmation
+        j.fin();
+        j.envoyer();
     });
 
-    // [ROUTE PILOTER] : Action générique sur GPIO
-    _webServer.on("/api/piloter_gpio", HTTP_GET, [this](){
-        Serial.println("\nAction spécifique sur GPIO demandée par le Web");
-        //digitalWrite(40, HIGH); // Rouge
-        // Exemple d'action : digitalWrite(4, HIGH);
-        _webServer.send(200, "text/plain", "GPIO Actionne avec succes");
-    });
-
-    _webServer.on("/api/piloter_gpio/semaphore_on", HTTP_GET, [this](){
-        Serial.println("\nAction spécifique sur GPIO demandée par le Web");
-        Serial.println("🚨 Allumage du Sémaphore !");
-    
-        // On allume les 3 LEDs (adapte les numéros de pins selon ton câblage)
-        digitalWrite(40, HIGH); // Rouge
-        digitalWrite(41, HIGH); // Jaune
-        digitalWrite(42, HIGH); // Vert
-       
-
-        
-        // Exemple d'action : digitalWrite(4, HIGH);
-        _webServer.send(200, "text/plain", "GPIO Actionne avec succes  Sémaphore Allumé");
-    });
-
-    _webServer.on("/api/piloter_gpio/semaphore_off", HTTP_GET, [this](){
-        Serial.println("\nAction spécifique sur GPIO demandée par le Web");
-        Serial.println("🚨 Eteint le Sémaphore !");
-    
-        // On eteint les 3 LEDs (adapte les numéros de pins selon ton câblage)
-        digitalWrite(40, LOW); // Rouge
-        digitalWrite(41, LOW); // Jaune
-        digitalWrite(42, LOW); // Vert
-        
-        // Exemple d'action : digitalWrite(4, HIGH);
-        _webServer.send(200, "text/plain", "GPIO Actionne avec succes  Sémaphore eteint");
+    // [ROUTE GPIO] : commande groupee des sorties de SORTIES[] (voir sorties.h)
+    //   ?masque=&valeur=   : bits par numero de GPIO, ecrits en une fois
+    //   ?seq=m:v:ms,...&rep= : sequence temporisee (remplace la precedente)
+    //   ?stop              : arrete la sequence ; sans argument : etat
+    route("/api/gpio", HTTP_ANY, [this]() {
+        if (_webServer.hasArg("masque") || _webServer.hasArg("valeur")) {
+            uint64_t masque = strtoull(_webServer.arg("masque").c_str(), nullptr, 0);
+            uint64_t valeur = strtoull(_webServer.arg("valeur").c_str(), nullptr, 0);
+            if (!_webServer.hasArg("masque") || !sorties->appliquer(masque, valeur)) {
+                _webServer.send(400, "application/json", "{\"erreur\":\"masque absent ou hors des sorties autorisees\"}");
+                return;
+            }
+        }
+        if (_webServer.hasArg("seq")) {
+            EtapeGpio etapes[SORTIES_NB_ETAPES];
+            int nb = lireEtapes(_webServer.arg("seq").c_str(), etapes, SORTIES_NB_ETAPES);
+            int rep = _webServer.hasArg("rep") ? _webServer.arg("rep").toInt() : 1;
+            if (nb <= 0 || !sorties->lancer(etapes, nb, rep)) {
+                _webServer.send(400, "application/json", "{\"erreur\":\"sequence invalide (masque:valeur:duree_ms,...)\"}");
+                return;
+            }
+        }
+        if (_webServer.hasArg("stop")) sorties->arreter();
+
+        char hexa[24];
+        uint64_t niveaux = sorties->lire();
+        ReponseJson j(_webServer);
+        j.objet();
+        j.champ("autorise", masqueHexa(hexa, sizeof(hexa), SORTIES_MASQUE));
+        j.champ("niveaux", masqueHexa(hexa, sizeof(hexa), niveaux));
+        j.tableau("sorties");
+        for (int i = 0; i < NB_SORTIES; i++) {
+            j.objet();
+            j.champ("pin", (int)SORTIES[i].pin);
+            j.champ("nom", SORTIES[i].nom);
+            j.champ("niveau", (niveaux & BIT_GPIO(SORTIES[i].pin)) != 0);
+            j.fin();
+        }
+        j.fin();
+
+        j.objet("sequence");
+        j.champ("en_cours", sorties->enCours());
+        j.champ("etape", sorties->getEtape());
+        j.champ("nb_etapes", sorties->getNbEtapes());
+        j.champ("tour", sorties->getTour());
+        j.champ("rep", sorties->getRepetitions());
+        j.champ("retard_max_us", sorties->getRetardMaxUs());
+        j.fin();
+
+        j.champ("commandes", sorties->getNbCommandes());
+        j.champ("sequences", sorties->getNbSequences());
+        j.fin();
+        j.envoyer();
     });
 
     // [ROUTE SYNC] : Reçoit l'heure du navigateur au chargement
-    _webServer.on("/api/sync_time", HTTP_GET, [this]() {
+    route("/api/sync_time", HTTP_GET, [this]() {
         if (_webServer.hasArg("t")) {
             time_t t = _webServer.arg("t").toInt();
             struct timeval tv = { .tv_sec = t, .tv_usec = 0 };
@@ -397,53 +719,205 @@ void Net::setupRoutes() {
     });
     
 
+    // [ROUTE WIFI] : Etat de la liaison et metriques de reconnexion
+    route("/api/wifi", HTTP_GET, [this]() {
+        ReponseJson j(_webServer);
+        const char* etats[] = {"hors_ligne", "en_connexion", "connecte", "non_configure"};
+
+        j.objet();
+        j.champ("mode",         _modeSolo ? "solo" : "cluster");
+        j.champ("etat",         etats[_etatWifi]);
+        j.champ("rssi",         (_etatWifi == WIFI_CONNECTE) ? (int)WiFi.RSSI() : 0);
+        j.champ("reconnexions", _nbReconnexions);
+        j.champ("echecs",       _nbEchecs);
+        j.champ("coupure_ms",   getDureeCoupureMs());
+        j.champ("prochain_essai_ms", (_etatWifi == WIFI_HORS_LIGNE) ? _delaiRetry : 0UL);
+        j.fin();
+        j.envoyer();
+    });
+
+    // [ROUTE ECHANT] : Regularite de l'echantillonnage (jitter periode a periode)
+    route("/api/echant", HTTP_GET, [this]() {
+        if (_webServer.hasArg("raz")) echant->razStats();
+
+        ReponseJson j(_webServer);
+        j.objet();
+        j.champ("periode_s",      echant->getPeriodeS());
+        j.champ("echantillons",   echant->getNbEchantillons());
+        j.champ("pertes",         echant->getPertes());
+        j.champ("jitter_max_us",  echant->getJitterMaxUs());
+        j.champ("latence_max_us", echant->getLatenceMaxUs());
+
+        //! classes : nombre d'ecarts < borne (la derniere prend le reste)
+        j.tableau("bornes_us");
+        for (int i = 0; i < ECHANT_NB_CLASSES; i++) j.val(Echantillonneur::BORNES_US[i]);
+        j.fin();
+        j.tableau("histo");
+        for (int i = 0; i < ECHANT_NB_CLASSES; i++) j.val(echant->getHistogramme()[i]);
+        j.fin();
+
+        j.fin();
+        j.envoyer();
+    });
+
+    // [ROUTE TELEMETRIE] : Duree de loop(), latence des routes, tas et piles
+    route("/api/telemetrie", HTTP_GET, [this]() {
+        ReponseJson j(_webServer);
+        j.objet();
+
+        j.objet("boucle");
+        j.champ("tours",  telem->getNbTours());
+        j.champ("moy_us", telem->getMoyTourUs());
+        j.champ("max_us", telem->getMaxTourUs());
+        j.tableau("bornes_us");
+        for (int i = 0; i < TELEM_NB_CLASSES; i++) j.val(Telemetrie::BORNES_US[i]);
+        j.fin();
+        j.tableau("histo");
+        for (int i = 0; i < TELEM_NB_CLASSES; i++) j.val(telem->getHistogramme()[i]);
+        j.fin();
+        j.fin();
+
+        //! requetes servies par handleClient() depuis le boot (ou la raz)
+        j.champ("requetes", telem->getNbRequetes());
+        j.tableau("routes");
+        for (int i = 0; i < telem->getNbRoutes(); i++) {
+            const StatRoute& r = telem->getRoute(i);
+            if (r.nb == 0) continue;
+            j.objet();
+            j.champ("uri",    r.uri);
+            j.champ("nb",     r.nb);
+            j.champ("moy_us", (uint32_t)(r.cumulUs / r.nb));
+            j.champ("max_us", r.maxUs);
+            j.fin();
+        }
+        j.fin();
+
+        j.objet("tas");
+        j.champ("libre",               telem->getTasLibre());
+        j.champ("min_libre",           ESP.getMinFreeHeap());
+        j.champ("plus_grand_bloc",     telem->getTasPlusGrandBloc());
+        j.champ("min_plus_grand_bloc", telem->getTasMinPlusGrandBloc());
+        //! fragmentation : part du libre qui n'est pas allouable d'un seul bloc
+        j.champ("frag_pct", telem->getTasLibre() ? 
+            100 - (int)((uint64_t)telem->getTasPlusGrandBloc() * 100 / telem->getTasLibre()) : 0);
+        j.fin();
+
+        //! profondeur d'historique : anneau PSRAM ou 120 lignes NVS
+        j.objet("stockage");
+        j.champ("psram",    dao->enPsram());
+        j.champ("capacite", dao->capacite());
+        j.champ("mesures",  dao->nbMesures());
+        j.champ("psram_libre", ESP.getFreePsram());
+        j.fin();
+
+        j.tableau("piles");
+        for (int i = 0; i < telem->getNbTaches(); i++) {
+            const StatTache& t = telem->getTache(i);
+            j.objet();
+            j.champ("tache",     t.nom);
+            j.champ("marge_min", t.marge);
+            j.champ("coeur",     t.coeur);
+            j.champ("cpu_pct",   t.cpuPct);
+            j.fin();
+        }
+        j.fin();
+
+        //! files entre taches : niveau courant et lignes perdues (file pleine)
+        j.tableau("files");
+        for (int i = 0; taches && i < Taches::NB_FILES; i++) {
+            j.objet();
+            j.champ("file",   taches->getFile(i).nom);
+            j.champ("niveau", taches->getNiveau(i));
+            j.champ("taille", taches->getFile(i).taille);
+            j.champ("pertes", (uint32_t)taches->getFile(i).pertes);
+            j.fin();
+        }
+        j.fin();
+
+        if (_webServer.hasArg("raz")) telem->razStats();
+
+        j.fin();
+        j.envoyer();
+    });
+
     // [ROUTE API CONFIG] : Envoie les réglages actuels au formulaire HTML
-    _webServer.on("/api/config", HTTP_GET, [this]() {
-        JsonDocument doc;
+    route("/api/config", HTTP_GET, [this]() {
+        ReponseJson j(_webServer);
         
-        // On remplit le JSON avec les valeurs de ton objet de config
-        doc["box_ssid"] = _conf->getBoxSSID();
-        doc["box_pwd"]  = _conf->getBoxPassword();
-        doc["box_cloud_url"]  = _conf->getBoxCloudUrl();
-        doc["ap_ssid"]  = _conf->getApSSID();
-        doc["ap_pwd"]   = _conf->getApPassword();
-        doc["freq"]     = _conf->getFrequenceMesures();
-        doc["mode"]     = _conf->getMode();
-
-        String response;
-        serializeJson(doc, response);
-        _webServer.send(200, "application/json", response);
+        // On remplit le JSON avec les valeurs de ton objet de config (table PARAMS_CONF)
+        j.objet();
+        _conf->exporterJson(j);
+        j.champ("version", _conf->getVersion());      //! compteur de commits A/B
+        j.fin();
+        j.envoyer();
         
         Serial.println("📡 API : Données de config envoyées au navigateur");
     });
 
     // [ROUTE API SAVE] : Reçoit les réglages du formulaire et les sauvegarde
-    _webServer.on("/api/config", HTTP_POST, [this]() {
+    route("/api/config", HTTP_POST, [this]() {
         Serial.println("📥 Réception d'une nouvelle configuration...");
 
-        // On récupère les valeurs envoyées par le formulaire JS
-        String new_box_ssid = _webServer.arg("box_ssid");
-        String new_box_pwd  = _webServer.arg("box_pwd");
-        String new_box_cloud_url  = _webServer.arg("box_cloud_url");
-        String new_ap_ssid  = _webServer.arg("ap_ssid");
-        String new_ap_pwd   = _webServer.arg("ap_pwd");
-        int new_freq        = _webServer.arg("freq").toInt();
-        String new_mode   = _webServer.arg("mode");
-
-        // On met à jour l'objet de configuration (qui va écrire dans les Preferences)
-        // Note : Adapte le nom de ta méthode de sauvegarde si elle est différente
-        _conf->save(new_box_ssid, new_box_pwd, new_box_cloud_url, 
-                        new_ap_ssid, new_ap_pwd, 
-                        new_freq, new_mode);
-
-        // On répond au navigateur pour confirmer que c'est OK
-        JsonDocument doc;
-        doc["status"] = "success";
-        doc["message"] = "Configuration enregistrée. Redémarrage...";
-        
-        String response;
-        serializeJson(doc, response);
-        _webServer.send(200, "application/json", response);
+        // On récupère les valeurs envoyées : formulaire JS (un champ par
+        //   parametre, les absents sont inchangés) ou corps JSON
+        MasqueConf modifies = 0;
+        if (_webServer.hasArg("plain")) {
+            JsonDocument entree;
+            if (deserializeJson(entree, _webServer.arg("plain"))) {
+                _webServer.send(400, "application/json", "{\"status\":\"error\",\"message\":\"JSON invalide\"}");
+                return;
+            }
+            modifies = _conf->importerJson(entree.as<JsonObjectConst>());
+        } else {
+            for (int i = 0; i < CONF_NB_PARAMS; i++)
+                if (_webServer.hasArg(PARAMS_CONF[i].nom))
+                    _conf->modifier(i, _webServer.arg(PARAMS_CONF[i].nom).c_str());
+            // On met à jour l'objet de configuration (qui n'écrit dans les Preferences
+            //   que les valeurs modifiées)
+            modifies = _conf->valider();
+        }
+        if (_conf->getEchecEcriture()) {
+            _webServer.send(500, "application/json", "{\"status\":\"error\",\"message\":\"Ecriture NVS impossible, configuration inchangée.\"}");
+            return;
+        }
+        //! freq, URL cloud et Box sont deja prises en compte (abonnes),
+        //!   le point d'acces et le mode ne se reconfigurent qu'au demarrage
+        bool redemarrage = (modifies & CONF_PARAMS_REDEMARRAGE) != 0;
+        //! Valeurs invalides : ignorees (les autres sont appliquees), mais signalees
+        MasqueConf refuses = _conf->getRefuses();
+
+        // On répond au navigateur : ce qui a changé, ce qui est refusé, et ce qui impose un reboot
+        ReponseJson j(_webServer);
+        j.objet();
+        j.champ("status", refuses ? "error" : "success");
+        j.champ("redemarrage", redemarrage);
+        j.tableau("refuses");
+        for (int i = 0; i < CONF_NB_PARAMS; i++)
+            if (refuses & ((MasqueConf)1 << i)) j.val(PARAMS_CONF[i].nom);
+        j.fin();
+        j.tableau("modifies");
+        for (int i = 0; i < CONF_NB_PARAMS; i++)
+            if (modifies & ((MasqueConf)1 << i)) j.val(PARAMS_CONF[i].nom);
+        j.fin();
+        j.tableau("a_redemarrer");
+        for (int i = 0; i < CONF_NB_PARAMS; i++)
+            if (modifies & CONF_PARAMS_REDEMARRAGE & ((MasqueConf)1 << i)) j.val(PARAMS_CONF[i].nom);
+        j.fin();
+        if (refuses)
+            j.champ("message", "Valeur(s) refusée(s), les autres sont enregistrées.");
+        else if (redemarrage)
+            j.champ("message", "Configuration enregistrée. Redémarrage...");
+        else if (modifies)
+            j.champ("message", "Configuration enregistrée et appliquée.");
+        else
+            j.champ("message", "Aucune modification.");
+        j.fin();
+        j.envoyer(refuses ? 400 : 200);
+
+        if (!redemarrage) {
+            Serial.printf("💾 Config appliquée sans reboot (modifs 0x%02X)\n", (unsigned)modifies);
+            return;
+        }
 
         // On laisse un peu de temps pour que la réponse arrive au navigateur
         // avant de couper le WiFi pour redémarrer.
@@ -454,25 +928,132 @@ void Net::setupRoutes() {
 
     // --- 3. GESTION DES FICHIERS STATIQUES & ERREURS ---
 
-    _webServer.onNotFound([this]() {
-        if (!handleFileRead(_webServer.uri())) {
+    int idFichiers = telem->enregistrerRoute("(fichiers)");
+    _webServer.onNotFound([this, idFichiers]() {
+        unsigned long debut = micros();
+        if (!handleFileRead(_webServer.uri().c_str())) {
             _webServer.send(404, "text/plain", "404: Fichier non trouve");
         }
+        telem->finRequete(idFichiers, micros() - debut);
     });
 }
 
 
-String Net::getContentType(String filename) {
-    if (filename.endsWith(".html")) return "text/html";
-    if (filename.endsWith(".css"))  return "text/css";
-    if (filename.endsWith(".js"))   return "application/javascript";
-    if (filename.endsWith(".ico"))  return "image/x-icon";
+/**
+ * @brief Reponse JSON : d'un bloc (Content-Length) si elle tient dans le
+ *        tampon, sinon fin du flux chunked commence par versClient()
+ */
+void ReponseJson::versClient(void* ctx, const char* data, size_t n) {
+    ReponseJson* r = (ReponseJson*)ctx;
+    if (!r->flux()) {
+        r->_ws.setContentLength(CONTENT_LENGTH_UNKNOWN);
+        r->_ws.send(200, "application/json", "");
+    }
+    r->_ws.sendContent(data, n);
+}
+
+void ReponseJson::envoyer(int code) {
+    if (flux()) {
+        vider();
+        _ws.sendContent("", 0);     //! dernier morceau (taille 0)
+        return;
+    }
+    _ws.send_P(code, "application/json", c_str(), longueur());
+}
+
+
+void ReponseCbor::versClient(void* ctx, const uint8_t* data, size_t n) {
+    ReponseCbor* r = (ReponseCbor*)ctx;
+    if (!r->flux()) {
+        r->_ws.setContentLength(CONTENT_LENGTH_UNKNOWN);
+        r->_ws.send(200, "application/cbor", "");
+    }
+    r->_ws.sendContent((const char*)data, n);
+}
+
+void ReponseCbor::envoyer(int code) {
+    if (flux()) {
+        vider();
+        _ws.sendContent("", 0);     //! dernier morceau (taille 0)
+        return;
+    }
+    _ws.send_P(code, "application/cbor", (const char*)donnees(), longueur());
+}
+
+
+bool Net::accepteCbor() {
+    if (_webServer.hasArg("format")) return strcmp(_webServer.arg("format").c_str(), "cbor") == 0;
+    return strstr(_webServer.header("Accept").c_str(), "application/cbor") != nullptr;
+}
+
+
+void ReponseFlux::vider() {
+    if (!_pos) return;
+    if (!_total) {
+        _ws.setContentLength(CONTENT_LENGTH_UNKNOWN);
+        _ws.send(200, _type, "");
+    }
+    _ws.sendContent(_tampon, _pos);
+    _total += _pos;
+    _pos = 0;
+}
+
+void ReponseFlux::ecrire(const char* texte, size_t n) {
+    while (n) {
+        if (_pos == sizeof(_tampon)) vider();
+        size_t c = (n < sizeof(_tampon) - _pos) ? n : sizeof(_tampon) - _pos;
+        memcpy(_tampon + _pos, texte, c);
+        _pos += c; texte += c; n -= c;
+    }
+}
+
+void ReponseFlux::terminer() {
+    if (!_total) {
+        //! tout tient dans le tampon : reponse d'un bloc
+        _ws.send_P(200, _type, _tampon, _pos);
+        _total = _pos;
+        _pos = 0;
+        return;
+    }
+    vider();
+    _ws.sendContent("", 0);     //! dernier morceau (taille 0)
+}
+
+
+/**
+ * @brief Enregistre une route en l'enveloppant dans une mesure de duree
+ */
+void Net::route(const char* uri, HTTPMethod methode, WebServer::THandlerFunction handler) {
+    int id = telem->enregistrerRoute(uri);
+    _webServer.on(uri, methode, [id, handler]() {
+        unsigned long debut = micros();
+        handler();
+        telem->finRequete(id, micros() - debut);
+    });
+}
+
+
+//! Vrai si texte se termine par fin
+static bool finitPar(const char* texte, const char* fin) {
+    size_t n = strlen(texte), m = strlen(fin);
+    return n >= m && strcmp(texte + n - m, fin) == 0;
+}
+
+const char* Net::getContentType(const char* filename) {
+    if (finitPar(filename, ".html")) return "text/html";
+    if (finitPar(filename, ".css"))  return "text/css";
+    if (finitPar(filename, ".js"))   return "application/javascript";
+    if (finitPar(filename, ".ico"))  return "image/x-icon";
     return "text/plain";
 }
 
-bool Net::handleFileRead(String path) {
-    if (path.endsWith("/")) path += "index.html";
-    String contentType = getContentType(path);
+bool Net::handleFileRead(const char* uri) {
+    // Chemin sur la pile ("/" => "/index.html")
+    char path[64];
+    size_t n = strlcpy(path, uri, sizeof(path));
+    if (n >= sizeof(path)) return false;
+    if (n > 0 && path[n - 1] == '/') strlcat(path, "index.html", sizeof(path));
+    const char* contentType = getContentType(path);
 
     if (LittleFS.exists(path)) {
         File file = LittleFS.open(path, "r");
@@ -508,77 +1089,55 @@ bool Net::handleFileRead(String path) {
 */
 
 
+//! Delais de la machine d'etat WiFi (ms)
+#define WIFI_DUREE_ESSAI_MS   10000UL   //! duree max d'une association
+#define WIFI_RETRY_MIN_MS      2000UL   //! premier delai avant nouvel essai
+#define WIFI_RETRY_MAX_MS     60000UL   //! plafond du backoff exponentiel
+
 void Net::setupNetwork() {
-    Serial.println("\t📅 Réseau Dynamique");
-    
-    if (_conf->getMode() == "solo") { 
-        //Serial.printf("\t\t-Mode SOLO - AP: %s\n", _conf->getSSID().c_str());
-        
+    Serial.println("\t📅 Réseau Dynamique (connexion en tache de fond)");
 
-        /** 
-            1. Nettoyage complet pour repartir sur une base saine
-        */
-        WiFi.softAPdisconnect(true); 
-        WiFi.disconnect(true);
-        delay(500); // On laisse un peu plus de temps à la puce
+    _modeSolo = _conf->estSolo();
 
-        /** 
-            2. On essaie d' etre toujours en mode hybride
-                sinon on laisse tomber et on garde que le mode AP
-        */ 
-        Serial.printf("\t\t.Tentative mode STA Hybride - AP et Box ...\n");
-        WiFi.mode(WIFI_AP_STA); 
+    /** 
+        1. Nettoyage complet pour repartir sur une base saine
+    */
+    WiFi.softAPdisconnect(true); 
+    WiFi.disconnect(true);
+    delay(100);
 
-        Serial.printf("\t\t.Connexion box : [%s] ...\n", this->_conf->getBoxSSID().c_str());
-        Serial.print("\t\t.Adresse MAC Station : "); Serial.println(WiFi.macAddress());
-        Serial.print("\t\t.Adresse MAC SoftAP  : "); Serial.println(WiFi.softAPmacAddress());
-        Serial.printf("\t\t.Mode actuel : %d (1:STA, 2:AP, 3:BOTH)\n", WiFi.getMode());
+    //! La reconnexion est pilotee par gererWifi() et non par le driver
+    WiFi.setAutoReconnect(false);
+    WiFi.setSleep(false); 
 
-        // 2.1 : On force la désactivation du mode économie (aide à l'auth)
-        WiFi.setSleep(false); 
-        WiFi.setMinSecurity(WIFI_AUTH_WPA2_PSK);
-        WiFi.begin(this->_conf->getBoxSSID().c_str(), this->_conf->getBoxPassword().c_str());
-    
-        //! 2.2 : Tentative connexion a la Box locale pendant 10 secondes
-        int retry = 0;  Serial.printf("\t\t\t");
-        while (WiFi.status() != WL_CONNECTED && retry < 20) { 
-            delay(500); Serial.print("... "); retry++; 
-        }
+    //! Les evenements arrivent dans la tache WiFi : on ne fait que lever des drapeaux
+    WiFi.onEvent([this](WiFiEvent_t event, WiFiEventInfo_t info) {
+        if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) _evtConnecte = true;
+        else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) _evtDeconnecte = true;
+    });
 
-        //! 2.3 : Connexte Box ? Oui ou Non
-        if(WiFi.status() == WL_CONNECTED) {
-                Serial.println(" ->Connecté à la Box ✅");
-                Serial.printf("\t🏠 Box : %s\n", WiFi.localIP().toString().c_str());
-                Serial.print("\t\t.Cloud URL : ["); Serial.print(this->_conf->getBoxCloudUrl()); Serial.println("]");
-        }
+    _etatWifi = WIFI_HORS_LIGNE;
+    _delaiRetry = WIFI_RETRY_MIN_MS;
+    _debutCoupure = millis();
+    _enCoupure = true;
 
-        //! Box impossible ou pas configuree
-        //! Pour configurer : 192.168.4.1/config
-        if(WiFi.status() != WL_CONNECTED) {
-            Serial.println("\n\t\t Pas de Box possible !. Mode Hybride abandonné");
-            Serial.println("\t\t⚠️ Changer la config avec '192.168.4.1/config'");
-            
-            
-            //! MODE NORMAL : Uniquement Point d'accès
-                //! 1. Nettoyage complet pour repartir sur une base saine
-            
-            WiFi.softAPdisconnect(true); 
-            WiFi.disconnect(true);
-            delay(500); // On laisse un peu plus de temps à la puce
+    if (_modeSolo) { 
+        /** 
+            2. Le point d'acces est monte tout de suite : la page /config
+               reste joignable pendant que la Box est cherchee
+        */
+        WiFi.mode(WIFI_AP_STA); 
+        WiFi.setMinSecurity(WIFI_AUTH_WPA2_PSK);
 
-            WiFi.mode(WIFI_AP); //Uniquement Point d'accès
-        }
-        
-      
-        //! chp'tite pause...
-        delay(200);
+        Serial.print("\t\t.Adresse MAC Station : "); Serial.println(WiFi.macAddress());
+        Serial.print("\t\t.Adresse MAC SoftAP  : "); Serial.println(WiFi.softAPmacAddress());
 
         // --- CONFIGURATION DU POINT D'ACCÈS (AP) ---
-        // On le fait après la connexion Box (si box trouvee) pour hériter du bon canal WiFi
-        String password_AP = _conf->getApPassword();
-        const char* passord_AP_Str = (password_AP.length() < 8) ? NULL : password_AP.c_str();
+        // Le canal suit celui de la Box des que la station est associee
+        const char* password_AP = _conf->getApPassword();
+        const char* passord_AP_Str = (strlen(password_AP) < 8) ? NULL : password_AP;
 
-        if (WiFi.softAP(_conf->getApSSID().c_str(), passord_AP_Str)) {
+        if (WiFi.softAP(_conf->getApSSID(), passord_AP_Str)) {
             Serial.print("\t📡 Point d'accès IP : "); Serial.print(WiFi.softAPIP()); 
             Serial.print(" - SSID ["); Serial.print(_conf->getApSSID()); Serial.print("] "); Serial.println("✅");
         } else {
@@ -586,26 +1145,160 @@ void Net::setupNetwork() {
             haltSystem(); 
         }
 
+        //! 3. Box pas configuree : pas la peine d'essayer, ni maintenant ni plus
+        //!    tard (chaque essai repasse en AP+STA et gene le point d'acces) ;
+        //!    de nouveaux identifiants relancent la machine (_relancerWifi)
+        //! Pour configurer : 192.168.4.1/config
+        if (!boxConfiguree()) {
+            Serial.println("\t\t⚠️ Pas de Box configurée, changer la config avec '192.168.4.1/config'");
+            WiFi.mode(WIFI_AP);
+            _etatWifi = WIFI_NON_CONFIGURE;
+            return;
+        }
     } else {
         // --- MODE CLUSTER ---
-        Serial.printf("\t\tMode CLUSTER - Connexion à: %s\n", _conf->getApSSID().c_str());
+        Serial.printf("\t\tMode CLUSTER - Connexion à: %s\n", _conf->getApSSID());
         WiFi.mode(WIFI_STA);
-        WiFi.begin(_conf->getApSSID().c_str(), _conf->getApPassword().c_str());
-        
-        int retry = 0;
-        while (WiFi.status() != WL_CONNECTED && retry < 30) { 
-            delay(500); Serial.print("."); retry++; 
-        }
+    }
+
+    lancerConnexionWifi();
+}
 
-        if (WiFi.status() != WL_CONNECTED) {
-            Serial.println("\t\t❌ [ERREUR] Impossible de joindre le Cluster.");
-            haltSystem();
+
+/**
+ * @brief Solo : la Box n'est plus celle par defaut de PARAMS_CONF
+ */
+bool Net::boxConfiguree() const {
+    return strcmp(_conf->getBoxSSID(), PARAMS_CONF[PARAM_BOX_SSID].defaut) != 0;
+}
+
+
+/**
+ * @brief Lance une association STA sans attendre le resultat
+ *    solo    : repasse en AP+STA et vise la Box
+ *    cluster : vise le point d'acces du SCMC
+ */
+void Net::lancerConnexionWifi() {
+    _evtDeconnecte = false;     //! evenement d'un lien precedent : perime
+    if (_modeSolo) {
+        if (WiFi.getMode() != WIFI_AP_STA) WiFi.mode(WIFI_AP_STA);
+        Serial.printf("\t\t.Connexion box : [%s] ...\n", _conf->getBoxSSID());
+        WiFi.begin(_conf->getBoxSSID(), _conf->getBoxPassword());
+    } else {
+        WiFi.begin(_conf->getApSSID(), _conf->getApPassword());
+    }
+    _debutEssai = millis();
+    _etatWifi = WIFI_EN_CONNEXION;
+}
+
+
+void Net::surConnexionWifi(unsigned long maintenant) {
+    if (_enCoupure) {
+        _cumulCoupureMs += maintenant - _debutCoupure;
+        _enCoupure = false;
+    }
+    if (_dejaConnecte) _nbReconnexions++;
+    _dejaConnecte = true;
+    _delaiRetry = WIFI_RETRY_MIN_MS;
+    _etatWifi = WIFI_CONNECTE;
+
+    Serial.printf("\t🏠 %s : %s ✅\n", _modeSolo ? "Box" : "Cluster", WiFi.localIP().toString().c_str());
+    if (_modeSolo) {
+        Serial.print("\t\t.Cloud URL : ["); Serial.print(_conf->getBoxCloudUrl()); Serial.println("]");
+    }
+}
+
+
+void Net::surPerteWifi(unsigned long maintenant) {
+    if (_etatWifi == WIFI_CONNECTE) {
+        Serial.println("\t⚠️ Lien WiFi perdu, reconnexion en tache de fond");
+        _debutCoupure = maintenant;
+        _enCoupure = true;
+        _delaiRetry = WIFI_RETRY_MIN_MS;
+    } else {
+        //! Echec d'association : backoff exponentiel
+        _nbEchecs++;
+        _delaiRetry = (_delaiRetry * 2 > WIFI_RETRY_MAX_MS) ? WIFI_RETRY_MAX_MS : _delaiRetry * 2;
+    }
+
+    WiFi.disconnect();
+    //! En solo on revient en AP seul pour ne pas perturber le point d'acces
+    if (_modeSolo) WiFi.mode(WIFI_AP);
+
+    _finEssai = maintenant;
+    _etatWifi = WIFI_HORS_LIGNE;
+}
+
+
+/**
+ * @brief Machine d'etat WiFi, ne bloque jamais loop()
+ */
+void Net::gererWifi() {
+    unsigned long maintenant = millis();
+
+    //! Identifiants Box changes par /api/config : on lache le lien actuel
+    //!   et on relance un essai (le point d'acces reste monte en solo)
+    if (_relancerWifi) {
+        _relancerWifi = false;
+        if (_modeSolo) {
+            Serial.println("\t🔁 Identifiants Box modifiés, reconnexion");
+            if (_etatWifi == WIFI_CONNECTE) {
+                _debutCoupure = maintenant;
+                _enCoupure = true;
+            }
+            if (_etatWifi == WIFI_CONNECTE || _etatWifi == WIFI_EN_CONNEXION) {
+                WiFi.disconnect();
+                WiFi.mode(WIFI_AP);
+            }
+            _evtConnecte = false;
+            if (boxConfiguree()) {
+                _etatWifi = WIFI_HORS_LIGNE;
+                _delaiRetry = WIFI_RETRY_MIN_MS;    //! le temps que la deconnexion soit signalee
+                _finEssai = maintenant;
+            } else {
+                //! Retour a la Box par defaut : plus d'essai
+                _etatWifi = WIFI_NON_CONFIGURE;
+            }
         }
-        Serial.println("\t\t[OK] Connecté au Cluster ✅");
+    }
+
+    if (_evtConnecte) {
+        _evtConnecte = false;
+        if (_etatWifi != WIFI_CONNECTE && WiFi.status() == WL_CONNECTED) surConnexionWifi(maintenant);
+    }
+    if (_evtDeconnecte) {
+        _evtDeconnecte = false;
+        //! En cours d'association, le driver signale ainsi un echec (Box absente, mauvais mdp)
+        if (_etatWifi == WIFI_EN_CONNEXION || _etatWifi == WIFI_CONNECTE) surPerteWifi(maintenant);
+    }
+
+    switch (_etatWifi) {
+        case WIFI_EN_CONNEXION:
+            if (WiFi.status() == WL_CONNECTED) surConnexionWifi(maintenant);
+            else if (maintenant - _debutEssai >= WIFI_DUREE_ESSAI_MS) surPerteWifi(maintenant);
+            break;
+        case WIFI_HORS_LIGNE:
+            if (maintenant - _finEssai >= _delaiRetry) lancerConnexionWifi();
+            break;
+        case WIFI_CONNECTE:
+            //! Filet de securite si l'evenement a ete manque
+            if (WiFi.status() != WL_CONNECTED) surPerteWifi(maintenant);
+            break;
+        case WIFI_NON_CONFIGURE:
+            break;      //! point d'acces seul, en attente de /config
     }
 }
 
 
+/**
+ * @brief Metriques de connexion (route /api/wifi)
+ */
+unsigned long Net::getDureeCoupureMs() const {
+    unsigned long cumul = _cumulCoupureMs;
+    if (_enCoupure) cumul += millis() - _debutCoupure;
+    return cumul;
+}
+
 
 
 
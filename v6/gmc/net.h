@@ -15,33 +15,162 @@
 
 #include "dao.h" 
 #include "conf.h"
+#include "echant.h"
+#include "telem.h"
+#include "jsonfixe.h"
+#include "cborfixe.h"
+#include "taches.h"
+#include "alarmes.h"
+#include "sorties.h"
 #include "dbg.h"
 
-// On indique au compilateur que l'objet dao 
-// est défini dans le fichier principal
+// On indique au compilateur que les objets dao, echant et telem
+// sont définis dans le fichier principal
 extern Dao* dao; 
+extern Echantillonneur* echant;
+extern Telemetrie* telem;
+extern Taches* taches;
+extern Alarmes* alarmes;
+extern Sorties* sorties;
+
+/**
+ * @brief Etats de la machine de connexion WiFi (Box en solo, SCMC en cluster)
+ */
+enum EtatWifi {
+    WIFI_HORS_LIGNE,    //! Pas de lien, attente du prochain essai (backoff)
+    WIFI_EN_CONNEXION,  //! Association en cours en tache de fond
+    WIFI_CONNECTE,      //! Lien etabli (mode hybride AP+STA restaure en solo)
+    WIFI_NON_CONFIGURE  //! Solo, Box par defaut : aucun essai avant de nouveaux identifiants
+};
+
+//! Tampon (pile) d'une reponse JSON : au-dela, la reponse part en chunked
+#define NET_TAMPON_JSON 512
+
+/**
+ * @brief Reponse JSON sans allocation : ecrite dans un tampon de la pile,
+ *        envoyee d'un bloc si elle y tient, sinon en morceaux (chunked)
+ *        au fil de l'ecriture. En chunked le code 200 part avec le premier
+ *        morceau : les erreurs sont a decider avant d'ecrire.
+ */
+class ReponseJson : public JsonFixe {
+private:
+    WebServer& _ws;
+    char _tampon[NET_TAMPON_JSON];
+    static void versClient(void* ctx, const char* data, size_t n);
+public:
+    ReponseJson(WebServer& ws) : JsonFixe(_tampon, sizeof(_tampon), versClient, this), _ws(ws) {}
+    void envoyer(int code = 200);
+};
+
+/**
+ * @brief Reponse CBOR (application/cbor), meme principe que ReponseJson
+ */
+class ReponseCbor : public CborFixe {
+private:
+    WebServer& _ws;
+    uint8_t _tampon[NET_TAMPON_JSON];
+    static void versClient(void* ctx, const uint8_t* data, size_t n);
+public:
+    ReponseCbor(WebServer& ws) : CborFixe(_tampon, sizeof(_tampon), versClient, this), _ws(ws) {}
+    void envoyer(int code = 200);
+};
+
+//! Tampon (pile) d'un export : un morceau chunked par tampon plein
+#define NET_TAMPON_FLUX 1024
+
+/**
+ * @brief Reponse texte en flux (CSV, NDJSON) : lignes accumulees dans un
+ *        tampon de la pile, envoyees en chunked a chaque tampon plein.
+ *        Memoire constante quelle que soit la longueur de la reponse.
+ */
+class ReponseFlux {
+private:
+    WebServer& _ws;
+    const char* _type;
+    char _tampon[NET_TAMPON_FLUX];
+    size_t _pos = 0;
+    size_t _total = 0;
+    void vider();
+public:
+    ReponseFlux(WebServer& ws, const char* type) : _ws(ws), _type(type) {}
+    void ecrire(const char* texte, size_t n);
+    void ecrire(const char* texte) { ecrire(texte, strlen(texte)); }
+    //! Dernier morceau ; total() : octets envoyes
+    void terminer();
+    size_t total() const { return _total + _pos; }
+};
 
 class Net {
 public:
     Net(WebServer&, Conf*);
     bool begin();
-    void setupNetwork(); //! Wifi
+    void setupNetwork(); //! Wifi (non bloquant)
+    void gererWifi();    //! Machine d'etat WiFi, a appeler par la tache web
     void setupRoutes();
-    void sendToCloud(float valTemp, bool etatVoyant, String cloudUrl);
-    void gererEnvoiDataCloud();
+    void sendToCloud(int canal, int valeur, bool etatVoyant, const char* cloudUrl);
+
+    //! Envoi cloud d'une ligne (un POST par canal "cloud"), tache uplink
+    void envoyerLigne(const LigneMesure& ligne);
+
+    //! Push immediat d'un changement d'etat d'alarme, tache alerte
+    bool envoyerAlarme(const EvenementAlarme& e);
 
     void haltSystem(); // bloquer le système en cas d'erreur
 
+    // Metriques de connexion WiFi
+    EtatWifi getEtatWifi() const { return _etatWifi; }
+    unsigned long getNbReconnexions() const { return _nbReconnexions; }
+    unsigned long getNbEchecsWifi() const { return _nbEchecs; }
+    unsigned long getDureeCoupureMs() const;
+
 private:
     WebServer& _webServer;
     Conf* _conf; // On stocke une référence à la config
+
+    //! Machine d'etat WiFi et metriques de connexion
+    EtatWifi _etatWifi = WIFI_HORS_LIGNE;
+    bool _modeSolo = true;
+    bool _dejaConnecte = false;
+    bool _enCoupure = false;
+    volatile bool _evtConnecte = false;     //! positionnes par la tache WiFi
+    volatile bool _evtDeconnecte = false;
+    unsigned long _debutEssai = 0;
+    unsigned long _finEssai = 0;
+    unsigned long _delaiRetry = 0;
+    unsigned long _debutCoupure = 0;
+    unsigned long _cumulCoupureMs = 0;
+    unsigned long _nbReconnexions = 0;
+    unsigned long _nbEchecs = 0;
+    volatile bool _relancerWifi = false;    //! identifiants Box modifies
+    volatile bool _cloudCbor = false;       //! envoi cloud en CBOR (Conf cloud_format)
+
+    //! URL cloud : boite aux lettres (longueur 1) remplie par l'abonne Conf
+    //! (tache web), lue sans la vider (xQueuePeek) par uplink et alerte ;
+    //! copie locale propre a la tache uplink
+    QueueHandle_t _boiteUrl = nullptr;
+    char _urlCloud[CONF_TAILLE_TEXTE] = "";
+
+    int posterCloud(const char* cloudUrl, const char* corps, size_t longueur,
+                    const char* type = "application/json");
+    void envoyerLigneCbor(const LigneMesure& ligne, bool voyant);
+
+    //! Le client demande du CBOR : ?format=cbor ou en-tete Accept
+    bool accepteCbor();
+
+    void lancerConnexionWifi();
+    bool boxConfiguree() const;
+    void surConnexionWifi(unsigned long maintenant);
+    void surPerteWifi(unsigned long maintenant);
     
+    // Enregistre une route dont la duree est mesuree par la telemetrie
+    void route(const char* uri, HTTPMethod methode, WebServer::THandlerFunction handler);
+
     // Handlers pour les requêtes
     void handleRoot();      // Pour afficher la page d'accueil
     void handleGetData();  // Pour renvoyer le JSON des mesures
     
-    bool handleFileRead(String path);
-    String getContentType(String filename);
+    bool handleFileRead(const char* path);
+    const char* getContentType(const char* filename);
 
 };
 
@@ -0,0 +1,128 @@
+/**
+ * @brief   Pilotage groupe des sorties GPIO (voir sorties.h)
+ * @file    sorties.cpp
+ * @author  cgil
+   @version	1.0
+ * @date    avril 2026
+ */
+
+#include "sorties.h"
+#include <soc/gpio_struct.h>
+
+
+bool Sorties::begin() {
+    for (int i = 0; i < NB_SORTIES; i++) pinMode(SORTIES[i].pin, OUTPUT);
+
+    esp_timer_create_args_t args = {};
+    args.callback = &Sorties::surEcheance;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "sorties";
+    return esp_timer_create(&args, &_timer) == ESP_OK;
+}
+
+
+/**
+ * @brief Par banque : clear puis set, les deux registres n'ecrivent que les
+ *        bits a 1, les autres broches ne sont pas touchees
+ */
+void Sorties::ecrire(uint64_t masque, uint64_t valeur) {
+    uint32_t bas = (uint32_t)masque, haut = (uint32_t)(masque >> 32);
+    uint32_t vBas = (uint32_t)valeur, vHaut = (uint32_t)(valeur >> 32);
+
+    if (bas) {
+        if (bas & ~vBas) GPIO.out_w1tc = bas & ~vBas;
+        if (bas & vBas)  GPIO.out_w1ts = bas & vBas;
+    }
+    if (haut) {
+        if (haut & ~vHaut) GPIO.out1_w1tc.val = haut & ~vHaut;
+        if (haut & vHaut)  GPIO.out1_w1ts.val = haut & vHaut;
+    }
+}
+
+
+bool Sorties::appliquer(uint64_t masque, uint64_t valeur) {
+    if (masque & ~SORTIES_MASQUE) return false;
+    arreter();
+    ecrire(masque, valeur);
+    _nbCommandes = _nbCommandes + 1;
+    return true;
+}
+
+
+bool Sorties::lancer(const EtapeGpio* etapes, int nb, int repetitions) {
+    if (!_timer || nb <= 0 || nb > SORTIES_NB_ETAPES) return false;
+    if (repetitions <= 0 || repetitions > SORTIES_MAX_REPETITIONS) return false;
+    for (int i = 0; i < nb; i++)
+        if ((etapes[i].masque & ~SORTIES_MASQUE) || etapes[i].dureeMs > SORTIES_MAX_DUREE_MS) return false;
+
+    arreter();
+    portENTER_CRITICAL(&_mux);
+    memcpy(_etapes, etapes, nb * sizeof(EtapeGpio));
+    _nbEtapes = nb;
+    _repetitions = repetitions;
+    _etape = 0;
+    _tour = 0;
+    _enCours = true;
+    _echeanceUs = esp_timer_get_time();
+    portEXIT_CRITICAL(&_mux);
+
+    _nbSequences = _nbSequences + 1;
+    etapeSuivante();
+    return true;
+}
+
+
+void Sorties::arreter() {
+    if (_timer) esp_timer_stop(_timer);
+    portENTER_CRITICAL(&_mux);
+    _enCours = false;
+    portEXIT_CRITICAL(&_mux);
+}
+
+
+void Sorties::surEcheance(void* arg) {
+    static_cast<Sorties*>(arg)->etapeSuivante();
+}
+
+
+/**
+ * @brief Ecrit l'etape courante puis arme l'echeance absolue de la suivante ;
+ *        la section critique ecarte un lancer()/arreter() concurrent
+ */
+void Sorties::etapeSuivante() {
+    portENTER_CRITICAL(&_mux);
+    if (!_enCours) { portEXIT_CRITICAL(&_mux); return; }
+
+    int64_t maintenant = esp_timer_get_time();
+    if (maintenant - _echeanceUs > (int64_t)_retardMaxUs) _retardMaxUs = (uint32_t)(maintenant - _echeanceUs);
+
+    const EtapeGpio& e = _etapes[_etape];
+    ecrire(e.masque, e.valeur);
+    _echeanceUs += (int64_t)e.dureeMs * 1000;
+
+    int etape = _etape + 1;
+    if (etape == _nbEtapes) {
+        etape = 0;
+        _tour = _tour + 1;
+    }
+    _etape = etape;
+    if (_tour == _repetitions) _enCours = false;
+
+    bool armer = _enCours;
+    int64_t delaiUs = _echeanceUs - maintenant;
+    portEXIT_CRITICAL(&_mux);
+
+    if (armer) {
+        esp_timer_stop(_timer);     //! deja arme par un callback en vol pendant lancer()
+        esp_timer_start_once(_timer, delaiUs > 0 ? (uint64_t)delaiUs : 0);
+    }
+}
+
+
+uint64_t Sorties::lire() const {
+    uint64_t niveaux = 0;
+    for (int i = 0; i < NB_SORTIES; i++)
+        if (digitalRead(SORTIES[i].pin) == HIGH) niveaux |= BIT_GPIO(SORTIES[i].pin);
+    return niveaux;
+}
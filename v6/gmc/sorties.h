@@ -0,0 +1,135 @@
+/**
+ * @brief   Pilotage groupe des sorties GPIO (masque/valeur, sequences)
+ * @file    sorties.h
+ * @author  cgil
+   @version	1.0
+ * @date    avril 2026
+ *
+ * Les sorties pilotables sont declarees a la compilation (SORTIES[], comme
+ * CANAUX[]) : seules leurs broches sont accessibles depuis /api/gpio.
+ *
+ * ecrire(masque, valeur) : un bit par numero de GPIO. Les broches du masque
+ * passent a la valeur de leur bit par les registres "write 1 to clear" puis
+ * "write 1 to set" de leur banque (out_w1tc/out_w1ts pour GPIO 0..31,
+ * out1_w1tc/out1_w1ts pour 32..53) : pas de lecture-modification-ecriture,
+ * donc pas de verrou ni de conflit avec un digitalWrite() de l'autre coeur.
+ * Les broches d'une banque qui vont dans le meme sens basculent sur la meme
+ * ecriture ; avec un masque mixte, celles qui passent a 0 (w1tc) basculent
+ * une ecriture avant celles qui passent a 1 (w1ts), quelques cycles d'horloge
+ * pendant lesquels l'etat intermediaire est visible sur les broches.
+ *
+ * Sequence : jusqu'a SORTIES_NB_ETAPES etapes {masque, valeur, duree_ms},
+ * rejouees rep fois. Chaque etape est appliquee par le callback d'un
+ * esp_timer one-shot rearme sur l'echeance absolue (debut + somme des
+ * durees) : les retards ne s'accumulent pas d'une etape a l'autre.
+ *
+ * GUIDE AJOUT SORTIE : une ligne dans SORTIES[] (broche cablee en sortie)
+ */
+
+#ifndef SORTIES_H
+#define SORTIES_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+
+//! Semaphore (pilote aussi par le moteur d'alarmes)
+#define PIN_SEMAPHORE_ROUGE 40
+#define PIN_SEMAPHORE_JAUNE 41
+#define PIN_SEMAPHORE_VERT  42
+
+struct SortieGpio {
+    uint8_t pin;
+    const char* nom;
+};
+
+static constexpr SortieGpio SORTIES[] = {
+    { PIN_SEMAPHORE_ROUGE, "rouge" },
+    { PIN_SEMAPHORE_JAUNE, "jaune" },
+    { PIN_SEMAPHORE_VERT,  "vert" },
+};
+#define NB_SORTIES (int)(sizeof(SORTIES) / sizeof(SORTIES[0]))
+
+#define BIT_GPIO(pin) ((uint64_t)1 << (pin))
+
+//! Masque des broches autorisees (bits des GPIO de SORTIES[])
+constexpr uint64_t masqueSorties() {
+    uint64_t m = 0;
+    for (int i = 0; i < NB_SORTIES; i++) m |= BIT_GPIO(SORTIES[i].pin);
+    return m;
+}
+#define SORTIES_MASQUE (masqueSorties())
+
+#define MASQUE_SEMAPHORE (BIT_GPIO(PIN_SEMAPHORE_ROUGE) | BIT_GPIO(PIN_SEMAPHORE_JAUNE) | BIT_GPIO(PIN_SEMAPHORE_VERT))
+
+//! Bornes d'une sequence
+#define SORTIES_NB_ETAPES       16
+#define SORTIES_MAX_REPETITIONS 1000
+#define SORTIES_MAX_DUREE_MS    3600000UL
+
+struct EtapeGpio {
+    uint64_t masque;
+    uint64_t valeur;
+    uint32_t dureeMs;   //! maintien avant l'etape suivante
+};
+
+class Sorties {
+private:
+    esp_timer_handle_t _timer = nullptr;
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+    //! Sequence en cours (copiee par lancer(), lue par le callback)
+    EtapeGpio _etapes[SORTIES_NB_ETAPES];
+    int _nbEtapes = 0;
+    int _repetitions = 0;
+    volatile int _etape = 0;
+    volatile int _tour = 0;
+    volatile bool _enCours = false;
+    int64_t _echeanceUs = 0;        //! echeance absolue de l'etape suivante
+
+    volatile uint32_t _nbCommandes = 0;
+    volatile uint32_t _nbSequences = 0;
+    volatile uint32_t _retardMaxUs = 0;     //! retard max d'une etape sur son echeance
+
+    //! Callback esp_timer : applique l'etape courante et arme la suivante
+    static void surEcheance(void* arg);
+    void etapeSuivante();
+
+public:
+    //! Broches de SORTIES[] en sortie, timer de sequence
+    bool begin();
+
+    /**
+     * @brief Ecriture groupee par les registres set/clear (masque deja valide)
+     *        Utilisable avant begin() (moteur d'alarmes)
+     */
+    static void ecrire(uint64_t masque, uint64_t valeur);
+
+    /**
+     * @brief Commande immediate : arrete la sequence en cours puis ecrit
+     * @return false si le masque sort de SORTIES_MASQUE
+     */
+    bool appliquer(uint64_t masque, uint64_t valeur);
+
+    /**
+     * @brief Remplace la sequence en cours ; la premiere etape est ecrite
+     *        tout de suite
+     * @return false si une etape sort de SORTIES_MASQUE ou hors bornes
+     */
+    bool lancer(const EtapeGpio* etapes, int nb, int repetitions);
+    void arreter();
+
+    //! Niveaux des sorties (bits des GPIO de SORTIES[])
+    uint64_t lire() const;
+
+    bool enCours() const { return _enCours; }
+    int getEtape() const { return _etape; }
+    int getNbEtapes() const { return _nbEtapes; }
+    int getTour() const { return _tour; }
+    int getRepetitions() const { return _repetitions; }
+    uint32_t getNbCommandes() const { return _nbCommandes; }
+    uint32_t getNbSequences() const { return _nbSequences; }
+    uint32_t getRetardMaxUs() const { return _retardMaxUs; }
+};
+
+#endif
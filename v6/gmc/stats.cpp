@@ -0,0 +1,102 @@
+/**
+ * @brief   Statistiques glissantes par canal (voir stats.h)
+ * @file    stats.cpp
+ * @author  cgil
+   @version	1.0
+ * @date    avril 2026
+ */
+
+#include "stats.h"
+#include <math.h>
+#include <new>
+
+
+bool FenetreStats::lier(uint32_t dureeS, const int32_t* dates, int16_t* const colonnes[NB_CANAUX],
+                        int capAnneau, bool psram) {
+    // Une ligne par seconde au plus (freq >= 1 s) : pas plus de dureeS + 1 lignes
+    uint32_t cap = dureeS / STATS_PERIODE_MIN_S + 1;
+    if (cap > (uint32_t)capAnneau) cap = capAnneau;
+
+    // Deux files par canal dans un seul bloc
+    size_t taille = 2 * NB_CANAUX * cap * sizeof(uint16_t);
+    uint16_t* bloc = psram ? (uint16_t*)ps_malloc(taille) : new (std::nothrow) uint16_t[2 * NB_CANAUX * cap];
+    if (!bloc) return false;
+
+    _dureeS = dureeS;
+    _dates = dates;
+    for (int c = 0; c < NB_CANAUX; c++) {
+        _colonnes[c] = colonnes[c];
+        _min[c] = { bloc + (2 * c) * cap, (int)cap, 0, 0 };
+        _max[c] = { bloc + (2 * c + 1) * cap, (int)cap, 0, 0 };
+        _moyenne[c] = _m2[c] = 0;
+    }
+    _capAnneau = capAnneau;
+    _capFile = cap;
+    _queue = 0;
+    _n = 0;
+    return true;
+}
+
+
+/**
+ * @brief La plus ancienne ligne sort : Welford a rebours, et tete des files
+ *        monotones si c'est elle
+ */
+void FenetreStats::retirerQueue() {
+    for (int c = 0; c < NB_CANAUX; c++) {
+        if (_n == 1) {
+            _moyenne[c] = _m2[c] = 0;
+        } else {
+            double y = _colonnes[c][_queue];
+            double ancienne = _moyenne[c];
+            _moyenne[c] -= (y - ancienne) / (_n - 1);
+            _m2[c] -= (y - ancienne) * (y - _moyenne[c]);
+            if (_m2[c] < 0) _m2[c] = 0;     //! arrondis
+        }
+        if (_min[c].nb && _min[c].devant() == _queue) _min[c].retirerDevant();
+        if (_max[c].nb && _max[c].devant() == _queue) _max[c].retirerDevant();
+    }
+    _queue = (_queue + 1) % _capAnneau;
+    _n--;
+}
+
+
+void FenetreStats::ajouter(int pos, int32_t date, const int16_t valeurs[NB_CANAUX]) {
+    if (!active()) return;
+
+    // Ligne hors sequence (ne doit pas arriver) : on repart de cette ligne
+    if (_n && pos != (_queue + (int)_n) % _capAnneau) {
+        while (_n) retirerQueue();
+    }
+    if (!_n) _queue = pos;
+
+    // Sorties : place pour la nouvelle ligne, puis lignes trop anciennes
+    while (_n && (_n >= _capFile || _dates[_queue] <= date - (int32_t)_dureeS)) retirerQueue();
+    if (!_n) _queue = pos;
+
+    _n++;
+    for (int c = 0; c < NB_CANAUX; c++) {
+        double y = valeurs[c];
+        double d = y - _moyenne[c];
+        _moyenne[c] += d / _n;
+        _m2[c] += d * (y - _moyenne[c]);
+
+        // Files monotones : les valeurs dominees ne seront jamais min / max
+        while (_min[c].nb && _colonnes[c][_min[c].derriere()] >= valeurs[c]) _min[c].retirerDerriere();
+        _min[c].ajouter(pos);
+        while (_max[c].nb && _colonnes[c][_max[c].derriere()] <= valeurs[c]) _max[c].retirerDerriere();
+        _max[c].ajouter(pos);
+    }
+}
+
+
+ResumeStats FenetreStats::resume(int canal) const {
+    ResumeStats r = { 0, 0, 0, 0, 0 };
+    if (!active() || !_n) return r;
+    r.n = _n;
+    r.min = _colonnes[canal][_min[canal].devant()];
+    r.max = _colonnes[canal][_max[canal].devant()];
+    r.moyenne = (float)_moyenne[canal];
+    r.ecartType = (_n > 1) ? (float)sqrt(_m2[canal] / (_n - 1)) : 0;
+    return r;
+}
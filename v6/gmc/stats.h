@@ -0,0 +1,110 @@
+/**
+ * @brief   Statistiques glissantes par canal (min, max, moyenne, ecart-type)
+ * @file    stats.h
+ * @author  cgil
+   @version	1.0
+ * @date    avril 2026
+ *
+ * Une FenetreStats suit les lignes de l'anneau de lecture du Dao dont la
+ * date est dans les dureeS dernieres secondes. A chaque ligne, en O(1) amorti :
+ *  - min / max : files monotones de positions dans l'anneau (la tete est
+ *    le min ou le max courant, elle sort quand sa ligne sort de la fenetre)
+ *  - moyenne / variance : Welford, ajout de la nouvelle valeur et retrait
+ *    de celles qui sortent (relues dans l'anneau avant d'etre ecrasees)
+ * La fenetre est bornee par l'anneau : 24 h avec la PSRAM, 120 lignes sinon.
+ *
+ * Les files et les sommes n'appartiennent qu'a la tache stockage ; seul le
+ * resume (ResumeStats) est publie pour /api/stats, sous la section
+ * critique du Dao.
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <Arduino.h>
+#include "canaux.h"
+
+struct DefFenetre {
+    const char* nom;
+    uint32_t dureeS;
+};
+
+//! Fenetres suivies (ajout : une ligne, rien d'autre)
+static constexpr DefFenetre FENETRES_STATS[] = {
+    { "5min", 300 },
+    { "1h",   3600 },
+    { "24h",  86400 },
+};
+#define NB_FENETRES (int)(sizeof(FENETRES_STATS) / sizeof(FENETRES_STATS[0]))
+
+//! Periode de mesure minimale (Conf : freq >= 1 s) : borne les files monotones
+#define STATS_PERIODE_MIN_S 1
+
+//! Resume publie d'un canal sur une fenetre (valeurs brutes, voir CANAUX[].echelle)
+struct ResumeStats {
+    uint32_t n;
+    int16_t min;
+    int16_t max;
+    float moyenne;
+    float ecartType;
+};
+
+/**
+ * @brief File monotone de positions (tampon circulaire de capacite fixe)
+ */
+struct FileMonotone {
+    uint16_t* pos = nullptr;
+    int cap = 0;
+    int tete = 0;
+    int nb = 0;
+
+    int devant() const { return pos[tete]; }
+    int derriere() const { return pos[(tete + nb - 1) % cap]; }
+    void retirerDevant() { tete = (tete + 1) % cap; nb--; }
+    void retirerDerriere() { nb--; }
+    void ajouter(int p) { pos[(tete + nb) % cap] = (uint16_t)p; nb++; }
+};
+
+class FenetreStats {
+private:
+    uint32_t _dureeS = 0;
+
+    //! Anneau de lecture du Dao (colonnes), fixe apres Dao::begin()
+    const int32_t* _dates = nullptr;
+    const int16_t* _colonnes[NB_CANAUX] = {};
+    int _capAnneau = 0;
+
+    //! Lignes dans la fenetre : de _queue (la plus ancienne) a la derniere ajoutee
+    int _queue = 0;
+    uint32_t _n = 0;
+    uint32_t _capFile = 0;      //! lignes maximum dans la fenetre
+
+    FileMonotone _min[NB_CANAUX];
+    FileMonotone _max[NB_CANAUX];
+    double _moyenne[NB_CANAUX] = {};
+    double _m2[NB_CANAUX] = {};
+
+    void retirerQueue();
+
+public:
+    /**
+     * @brief Lie la fenetre a l'anneau et alloue ses files
+     *        (capacite : lignes possibles dans dureeS, bornee par l'anneau)
+     * @param psram allouer les files en PSRAM
+     * @return false si l'allocation echoue (fenetre inactive)
+     */
+    bool lier(uint32_t dureeS, const int32_t* dates, int16_t* const colonnes[NB_CANAUX],
+              int capAnneau, bool psram);
+    bool active() const { return _capAnneau > 0; }
+
+    /**
+     * @brief Nouvelle ligne a la position pos de l'anneau. A appeler AVANT
+     *        de l'y ecrire : l'ancienne ligne peut encore sortir de la fenetre.
+     */
+    void ajouter(int pos, int32_t date, const int16_t valeurs[NB_CANAUX]);
+
+    //! Resume courant d'un canal (O(1), tache stockage)
+    ResumeStats resume(int canal) const;
+};
+
+#endif
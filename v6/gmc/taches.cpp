@@ -0,0 +1,174 @@
+/**
+ * @brief   Code des taches FreeRTOS du firmware (voir taches.h)
+ * @file    taches.cpp
+ * @author  cgil
+   @version	1.0
+ * @date    avril 2026
+ */
+
+#include "taches.h"
+#include <WebServer.h>
+#include "net.h"
+
+//! Objets du fichier principal
+extern WebServer webServer;
+extern Net* net;
+extern Alarmes* alarmes;
+
+
+bool Taches::creer(TaskFunction_t fn, const char* nom, uint32_t pile, UBaseType_t prio, int coeur, int& id) {
+    TaskHandle_t tache = nullptr;
+    if (xTaskCreatePinnedToCore(fn, nom, pile, this, prio, &tache, coeur) != pdPASS) return false;
+    id = telem->surveillerTache(tache, nom, coeur);
+    return true;
+}
+
+bool Taches::demarrer() {
+    _mesures.file = xQueueCreate(TACHES_TAILLE_FILE_MESURES, sizeof(LigneMesure));
+    _uplink.file = xQueueCreate(TACHES_TAILLE_FILE_UPLINK, sizeof(LigneMesure));
+    _alertes.file = xQueueCreate(TACHES_TAILLE_FILE_ALERTES, sizeof(EvenementAlarme));
+    if (!_mesures.file || !_uplink.file || !_alertes.file) return false;
+
+    esp_timer_create_args_t args = {};
+    args.callback = &Taches::surFlash;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "flash";
+    if (esp_timer_create(&args, &_flash) != ESP_OK) return false;
+
+    //! Consommateurs d'abord : la premiere ligne trouve sa file videe
+    return creer(stockage,    "stockage",    4096, 4, TACHES_COEUR_MESURES, _idStockage)
+        && creer(uplink,      "uplink",      6144, 2, TACHES_COEUR_RESEAU,  _idUplink)
+        && creer(alerte,      "alerte",      6144, 4, TACHES_COEUR_RESEAU,  _idAlerte)
+        && creer(acquisition, "acquisition", 3072, 5, TACHES_COEUR_MESURES, _idAcquisition)
+        && creer(web,         "web",         8192, 3, TACHES_COEUR_RESEAU,  _idWeb);
+}
+
+
+/**
+ * @brief Un tick de l'echantillonneur = une ligne (date du tick, pas de la lecture)
+ *        Les alarmes sont evaluees ici, avant le stockage et l'envoi de la ligne
+ */
+void Taches::acquisition(void* arg) {
+    Taches* self = static_cast<Taches*>(arg);
+    for (;;) {
+        Echantillon e;
+        if (!echant->lire(e, portMAX_DELAY)) continue;
+
+        unsigned long debut = micros();
+        LigneMesure l;
+        l.date = e.date;
+        acquerirMesures(l.valeurs);
+
+        EvenementAlarme evts[NB_REGLES];
+        int nb = alarmes->evaluer(l, evts);
+        for (int i = 0; i < nb; i++) {
+            if (xQueueSend(self->_alertes.file, &evts[i], 0) != pdTRUE)
+                self->_alertes.pertes = self->_alertes.pertes + 1;
+        }
+
+        if (xQueueSend(self->_mesures.file, &l, 0) != pdTRUE)
+            self->_mesures.pertes = self->_mesures.pertes + 1;
+        telem->ajouterActivite(self->_idAcquisition, micros() - debut);
+
+        // petit Flash vie : joue par le timer, l'acquisition n'attend pas
+        self->lancerFlash();
+    }
+}
+
+/**
+ * @brief Repart de la premiere couleur ; un flash en cours est remplace
+ */
+void Taches::lancerFlash() {
+    if (!_flash) return;
+    esp_timer_stop(_flash);
+    _etapeFlash = 0;
+    esp_timer_start_once(_flash, 0);
+}
+
+void Taches::surFlash(void* arg) {
+    Taches* self = static_cast<Taches*>(arg);
+    switch (self->_etapeFlash) {
+    case 0:
+        setLED("blanc");
+        self->_etapeFlash = 1;
+        esp_timer_start_once(self->_flash, TACHES_FLASH_BLANC_MS * 1000ULL);
+        break;
+    case 1:
+        setLED("orange");
+        self->_etapeFlash = 2;
+        esp_timer_start_once(self->_flash, TACHES_FLASH_ORANGE_MS * 1000ULL);
+        break;
+    default:
+        setLED("vert");
+        break;
+    }
+}
+
+/**
+ * @brief Seul ecrivain du Dao ; la ligne stockee part ensuite vers le cloud
+ */
+void Taches::stockage(void* arg) {
+    Taches* self = static_cast<Taches*>(arg);
+    for (;;) {
+        LigneMesure l;
+        if (xQueueReceive(self->_mesures.file, &l, portMAX_DELAY) != pdTRUE) continue;
+
+        unsigned long debut = micros();
+        if (dao->accederTableMesure_ecrireDesMesures(l.valeurs, l.date)) {
+            Serial.printf("🌡️ Mesure simulee : %d (hum %d, alarme %d)\n",
+                l.valeurs[CANAL_TEMP], l.valeurs[CANAL_HUM], l.valeurs[CANAL_ALARME]);
+        }
+        if (xQueueSend(self->_uplink.file, &l, 0) != pdTRUE)
+            self->_uplink.pertes = self->_uplink.pertes + 1;
+        telem->ajouterActivite(self->_idStockage, micros() - debut);
+    }
+}
+
+/**
+ * @brief Ancienne loop() : requetes Web, WiFi, telemetrie
+ */
+void Taches::web(void* arg) {
+    Taches* self = static_cast<Taches*>(arg);
+    for (;;) {
+        // Telemetrie : duree du tour precedent, tas et piles (1/s)
+        telem->tourDeBoucle();
+
+        unsigned long debut = micros();
+        webServer.handleClient();
+        net->gererWifi();
+        telem->ajouterActivite(self->_idWeb, micros() - debut);
+
+        vTaskDelay(pdMS_TO_TICKS(TACHES_PERIODE_WEB_MS));
+    }
+}
+
+/**
+ * @brief Envoi cloud de chaque ligne stockee (attente HTTP comprise dans l'activite)
+ */
+void Taches::uplink(void* arg) {
+    Taches* self = static_cast<Taches*>(arg);
+    for (;;) {
+        LigneMesure l;
+        if (xQueueReceive(self->_uplink.file, &l, portMAX_DELAY) != pdTRUE) continue;
+
+        unsigned long debut = micros();
+        net->envoyerLigne(l);
+        telem->ajouterActivite(self->_idUplink, micros() - debut);
+    }
+}
+
+/**
+ * @brief Push cloud d'un changement d'etat d'alarme des sa detection
+ */
+void Taches::alerte(void* arg) {
+    Taches* self = static_cast<Taches*>(arg);
+    for (;;) {
+        EvenementAlarme e;
+        if (xQueueReceive(self->_alertes.file, &e, portMAX_DELAY) != pdTRUE) continue;
+
+        unsigned long debut = micros();
+        alarmes->noterPush(e, net->envoyerAlarme(e));
+        telem->ajouterActivite(self->_idAlerte, micros() - debut);
+    }
+}
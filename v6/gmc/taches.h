@@ -0,0 +1,121 @@
+/**
+ * @brief   Repartition du firmware en taches FreeRTOS sur les deux coeurs
+ * @file    taches.h
+ * @author  cgil
+   @version	1.0
+ * @date    avril 2026
+ *
+ *  coeur 1 (APP) : acquisition (prio 5)  --fileMesures-->  stockage (prio 4)
+ *  coeur 0 (PRO) : web (prio 3)          uplink (prio 2) <--fileUplink-- stockage
+ *                  alerte (prio 4) <--fileAlertes-- acquisition
+ *
+ *  - acquisition : attend un tick de l'Echantillonneur, lit les canaux,
+ *                  evalue les alarmes (alarmes.h) puis depose une LigneMesure
+ *                  (jamais bloquante : file pleine = perte comptee)
+ *  - stockage    : seul ecrivain du Dao (NVS, anneau PSRAM, flush fichier)
+ *  - web         : WebServer, machine d'etat WiFi, telemetrie (ex-loop())
+ *  - uplink      : envoi cloud, ses attentes HTTP ne bloquent plus le serveur Web
+ *  - alerte      : push cloud immediat des changements d'etat d'alarme ; plus
+ *                  prioritaire qu'uplink, il n'attend pas la ligne suivante
+ *  - loop()      : bouton BOOT (factoryReset) seulement
+ *  - flash de vie : sequence de la LED apres chaque ligne, jouee par un
+ *                  esp_timer one-shot (tache esp_timer) : l'acquisition
+ *                  ne fait qu'armer le timer
+ *
+ * Propriete des objets partages :
+ *  - Dao        : ecrit par stockage ; lu par web via un instantane (voir dao.h)
+ *  - Conf       : lue et modifiee par web seul (/api/config ; les abonnes
+ *                 s'executent donc dans web). L'URL cloud part vers uplink
+ *                 par une boite aux lettres (Net, xQueueOverwrite).
+ *                 factoryReset() (loop) est suivi d'un reboot.
+ *  - Echantillonneur : file remplie par esp_timer, videe par acquisition ;
+ *                 ses statistiques sont lues et remises a zero par web
+ *                 sous section critique (voir echant.h)
+ *  - Telemetrie : web ; chaque tache ecrit seulement son compteur d'activite
+ *  - Alarmes    : regles evaluees par acquisition (voyant, semaphore GPIO) ;
+ *                 compteurs de push ecrits par alerte ; lus par web et uplink
+ */
+
+#ifndef TACHES_H
+#define TACHES_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <esp_timer.h>
+#include "canaux.h"
+#include "alarmes.h"
+
+//! Profondeur des files (lignes de mesure)
+#define TACHES_TAILLE_FILE_MESURES  8
+#define TACHES_TAILLE_FILE_UPLINK   4
+#define TACHES_TAILLE_FILE_ALERTES  8
+
+//! Coeurs : la pile WiFi/lwIP tourne sur le coeur 0
+#define TACHES_COEUR_RESEAU  0
+#define TACHES_COEUR_MESURES 1
+
+//! Pause du tour de la tache web (handleClient() n'attend pas de client)
+#define TACHES_PERIODE_WEB_MS 2
+
+//! Flash de vie : blanc puis orange puis vert
+#define TACHES_FLASH_BLANC_MS  100
+#define TACHES_FLASH_ORANGE_MS 200
+
+//! Fournie par gmc.ino : une valeur par canal
+void acquerirMesures(int valeurs[NB_CANAUX]);
+void setLED(const char*);
+
+/**
+ * @brief Une file inter-taches et ses compteurs (route /api/telemetrie)
+ */
+struct StatFile {
+    const char* nom;
+    QueueHandle_t file;
+    UBaseType_t taille;
+    volatile uint32_t pertes;   //! ecrit par la tache productrice seule
+};
+
+class Taches {
+private:
+    StatFile _mesures = { "mesures", nullptr, TACHES_TAILLE_FILE_MESURES, 0 };
+    StatFile _uplink  = { "uplink",  nullptr, TACHES_TAILLE_FILE_UPLINK,  0 };
+    StatFile _alertes = { "alertes", nullptr, TACHES_TAILLE_FILE_ALERTES, 0 };
+
+    //! Identifiants Telemetrie (pile, charge)
+    int _idAcquisition = -1;
+    int _idStockage = -1;
+    int _idWeb = -1;
+    int _idUplink = -1;
+    int _idAlerte = -1;
+
+    //! Flash de vie, hors de la tache d'acquisition
+    esp_timer_handle_t _flash = nullptr;
+    volatile int _etapeFlash = 0;
+
+    static void acquisition(void* arg);
+    static void stockage(void* arg);
+    static void web(void* arg);
+    static void uplink(void* arg);
+    static void alerte(void* arg);
+    //! Callback esp_timer : une couleur par etape, arme l'etape suivante
+    static void surFlash(void* arg);
+    void lancerFlash();
+
+    bool creer(TaskFunction_t fn, const char* nom, uint32_t pile, UBaseType_t prio, int coeur, int& id);
+
+public:
+    //! Cree les files puis les cinq taches (a la fin du setup)
+    bool demarrer();
+
+    // Lecture (route /api/telemetrie)
+    static const int NB_FILES = 3;
+    const StatFile& getFile(int i) const { return i == 0 ? _mesures : i == 1 ? _uplink : _alertes; }
+    UBaseType_t getNiveau(int i) const {
+        const StatFile& f = getFile(i);
+        return f.file ? uxQueueMessagesWaiting(f.file) : 0;
+    }
+};
+
+#endif
@@ -0,0 +1,110 @@
+/**
+ * @brief   Code de la classe de telemetrie legere
+ * @file    telem.cpp
+ * @author  cgil
+   @version	1.0
+ * @date    mars 2026
+ */
+
+#include "telem.h"
+
+//! Classes en puissances de 4 : 16 µs ... 262 ms, puis le reste
+const uint32_t Telemetrie::BORNES_US[TELEM_NB_CLASSES] =
+    {16, 64, 256, 1024, 4096, 16384, 65536, 262144, UINT32_MAX};
+
+Telemetrie::Telemetrie() {
+    //! La tache loop() (appelante au setup) est toujours surveillee
+    surveillerTache(NULL, "loopTask");
+}
+
+
+void Telemetrie::tourDeBoucle() {
+    unsigned long maintenant = micros();
+
+    if (_dernierTourUs != 0) {
+        uint32_t duree = (uint32_t)(maintenant - _dernierTourUs);
+        _nbTours++;
+        _cumulTourUs += duree;
+        if (duree > _maxTourUs) _maxTourUs = duree;
+
+        int classe = 0;
+        while (duree >= BORNES_US[classe] && classe < TELEM_NB_CLASSES - 1) classe++;
+        _histo[classe]++;
+    }
+    _dernierTourUs = maintenant;
+
+    if (millis() - _derniereSante >= TELEM_PERIODE_SANTE_MS) {
+        _derniereSante = millis();
+        echantillonnerSante();
+    }
+}
+
+
+/**
+ * @brief Tas : libre, plus grand bloc allouable (fragmentation) ; piles : marge min
+ */
+void Telemetrie::echantillonnerSante() {
+    _tasLibre = ESP.getFreeHeap();
+    _tasPlusGrandBloc = ESP.getMaxAllocHeap();
+    if (_tasPlusGrandBloc < _tasMinPlusGrandBloc) _tasMinPlusGrandBloc = _tasPlusGrandBloc;
+
+    unsigned long maintenantUs = micros();
+    uint32_t periodeUs = (uint32_t)(maintenantUs - _derniereSanteUs);
+    _derniereSanteUs = maintenantUs;
+
+    for (int i = 0; i < _nbTaches; i++) {
+        StatTache& t = _taches[i];
+        //! En octets sur l'ESP32 (StackType_t = uint8_t)
+        uint32_t marge = uxTaskGetStackHighWaterMark(t.tache);
+        if (marge < t.marge) t.marge = marge;
+
+        //! Charge : temps actif de la periode (un seul ecrivain par compteur) ;
+        //! avec les run time stats FreeRTOS, le compteur du noyau (µs esp_timer)
+#if defined(configGENERATE_RUN_TIME_STATS) && configGENERATE_RUN_TIME_STATS == 1
+        uint32_t actif = ulTaskGetRunTimeCounter(t.tache);
+#else
+        uint32_t actif = t.actifUs;
+#endif
+        uint32_t delta = actif - t.actifPrecUs;
+        t.actifPrecUs = actif;
+        t.cpuPct = periodeUs ? (uint8_t)((uint64_t)(delta > periodeUs ? periodeUs : delta) * 100 / periodeUs) : 0;
+    }
+}
+
+
+int Telemetrie::enregistrerRoute(const char* uri) {
+    if (_nbRoutes < TELEM_NB_ROUTES) {
+        _routes[_nbRoutes] = { uri, 0, 0, 0 };
+        return _nbRoutes++;
+    }
+    _routes[TELEM_NB_ROUTES - 1].uri = "(autres)";
+    return TELEM_NB_ROUTES - 1;
+}
+
+void Telemetrie::finRequete(int id, uint32_t dureeUs) {
+    _nbRequetes++;
+    if (id < 0 || id >= _nbRoutes) return;
+    StatRoute& r = _routes[id];
+    r.nb++;
+    r.cumulUs += dureeUs;
+    if (dureeUs > r.maxUs) r.maxUs = dureeUs;
+}
+
+
+int Telemetrie::surveillerTache(TaskHandle_t tache, const char* nom, int coeur) {
+    if (_nbTaches >= TELEM_NB_TACHES) return -1;
+    if (tache == NULL) tache = xTaskGetCurrentTaskHandle();
+    _taches[_nbTaches] = { tache, nom, UINT32_MAX, coeur, 0, 0, 0 };
+    return _nbTaches++;
+}
+
+
+void Telemetrie::razStats() {
+    _nbTours = 0;
+    _maxTourUs = 0;
+    _cumulTourUs = 0;
+    for (int i = 0; i < TELEM_NB_CLASSES; i++) _histo[i] = 0;
+    for (int i = 0; i < _nbRoutes; i++) { _routes[i].nb = 0; _routes[i].maxUs = 0; _routes[i].cumulUs = 0; }
+    _nbRequetes = 0;
+    _tasMinPlusGrandBloc = UINT32_MAX;
+}
@@ -0,0 +1,119 @@
+/**
+ * @brief   Classe de telemetrie legere : boucle, routes web, tas et piles
+ * @file    telem.h
+ * @author  cgil
+   @version	1.0
+ * @date    mars 2026
+ *
+ * Cout par tour de loop() : un micros() et une recherche de classe.
+ * Le tas et les piles ne sont echantillonnes qu'une fois par seconde.
+ *
+ * CPU par tache : chaque tache ajoute elle-meme son temps actif
+ * (ajouterActivite, une seule tache ecrit chaque compteur) ; la charge est
+ * le temps actif rapporte a la periode d'echantillonnage. Pas besoin des
+ * run time stats FreeRTOS, absentes de la config Arduino par defaut
+ * (utilisees si configGENERATE_RUN_TIME_STATS est active).
+ * La Telemetrie appartient a la tache web (tourDeBoucle, routes, lecture).
+ */
+
+#ifndef TELEM_H
+#define TELEM_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+//! Histogramme de la duree d'un tour de loop() (bornes hautes en µs)
+#define TELEM_NB_CLASSES   9
+
+//! Nombre max de routes suivies (les suivantes partagent la derniere case)
+#define TELEM_NB_ROUTES    24
+
+//! Nombre max de taches dont on surveille la pile
+#define TELEM_NB_TACHES    8
+
+//! Periode d'echantillonnage du tas et des piles
+#define TELEM_PERIODE_SANTE_MS 1000
+
+struct StatRoute {
+    const char* uri;
+    uint32_t nb;
+    uint32_t maxUs;
+    uint64_t cumulUs;
+};
+
+struct StatTache {
+    TaskHandle_t tache;
+    const char* nom;
+    uint32_t marge;     //! plus petite marge de pile jamais vue (octets)
+    int coeur;          //! coeur d'epinglage (-1 : inconnu ou libre)
+    volatile uint32_t actifUs;  //! temps actif cumule (ecrit par la tache)
+    uint32_t actifPrecUs;       //! valeur au dernier echantillonnage
+    uint8_t cpuPct;             //! charge sur la derniere periode
+};
+
+class Telemetrie {
+private:
+    //! Boucle
+    unsigned long _dernierTourUs = 0;
+    uint32_t _nbTours = 0;
+    uint32_t _maxTourUs = 0;
+    uint64_t _cumulTourUs = 0;
+    uint32_t _histo[TELEM_NB_CLASSES] = {0};
+
+    //! Routes
+    StatRoute _routes[TELEM_NB_ROUTES];
+    int _nbRoutes = 0;
+    uint32_t _nbRequetes = 0;
+
+    //! Tas (echantillonne)
+    unsigned long _derniereSante = 0;
+    unsigned long _derniereSanteUs = 0;
+    uint32_t _tasLibre = 0;
+    uint32_t _tasPlusGrandBloc = 0;
+    uint32_t _tasMinPlusGrandBloc = UINT32_MAX;
+
+    //! Piles
+    StatTache _taches[TELEM_NB_TACHES];
+    int _nbTaches = 0;
+
+    void echantillonnerSante();
+
+public:
+    static const uint32_t BORNES_US[TELEM_NB_CLASSES];
+
+    Telemetrie();
+
+    //! A appeler en tete de loop() : mesure le tour precedent
+    void tourDeBoucle();
+
+    //! Routes web : enregistrement au setup puis une mesure par requete
+    int enregistrerRoute(const char* uri);
+    void finRequete(int id, uint32_t dureeUs);
+
+    //! Surveillance de pile et de charge (NULL = tache appelante)
+    //! @return identifiant pour ajouterActivite(), -1 si table pleine
+    int surveillerTache(TaskHandle_t tache, const char* nom, int coeur = -1);
+
+    //! Temps actif d'une tache, appele par la tache elle-meme apres un travail
+    void ajouterActivite(int id, uint32_t dureeUs) {
+        if (id >= 0 && id < _nbTaches) _taches[id].actifUs = _taches[id].actifUs + dureeUs;
+    }
+
+    // Lecture (route /api/telemetrie)
+    uint32_t getNbTours() const { return _nbTours; }
+    uint32_t getMaxTourUs() const { return _maxTourUs; }
+    uint32_t getMoyTourUs() const { return _nbTours ? (uint32_t)(_cumulTourUs / _nbTours) : 0; }
+    const uint32_t* getHistogramme() const { return _histo; }
+    uint32_t getNbRequetes() const { return _nbRequetes; }
+    int getNbRoutes() const { return _nbRoutes; }
+    const StatRoute& getRoute(int i) const { return _routes[i]; }
+    uint32_t getTasLibre() const { return _tasLibre; }
+    uint32_t getTasPlusGrandBloc() const { return _tasPlusGrandBloc; }
+    uint32_t getTasMinPlusGrandBloc() const { return _tasMinPlusGrandBloc; }
+    int getNbTaches() const { return _nbTaches; }
+    const StatTache& getTache(int i) const { return _taches[i]; }
+    void razStats();
+};
+
+#endif
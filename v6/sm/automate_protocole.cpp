@@ -0,0 +1,198 @@
+/**
+ * @file automate_protocole.cpp
+ * @brief Code des automates de protocole (voir automate_protocole.h).
+ */
+
+#include "automate_protocole.h"
+
+#include <cstring>
+#include <cctype>
+
+
+AutomateProtocole::AutomateProtocole(ServicesProtocole* services)
+    : services(services), etat(ATTENTE_START), client(CLIENT_INCONNU), nbMessages(0),
+      nbDonnees(0), nbAcquittees(0), intervalleAcquit(0) {}
+
+
+static bool commencePar(std::string_view ligne, std::string_view prefixe) {
+    return ligne.compare(0, prefixe.size(), prefixe) == 0;
+}
+
+static std::string_view trim(std::string_view s) {
+    size_t debut = 0, fin = s.size();
+    while (debut < fin && std::isspace((unsigned char)s[debut])) debut++;
+    while (fin > debut && std::isspace((unsigned char)s[fin - 1])) fin--;
+    return s.substr(debut, fin - debut);
+}
+
+
+/**
+ * @brief Decoupe en lignes sans copie quand la ligne est entiere dans le
+ *        morceau ; seule une ligne a cheval sur deux morceaux passe par partielle
+ */
+size_t AutomateProtocole::alimenter(const char* octets, size_t n, std::string& sortie) {
+    size_t nbLignes = 0;
+    const char* fin = octets + n;
+    while (octets < fin && etat != TERMINE) {
+        const char* nl = static_cast<const char*>(memchr(octets, '\n', fin - octets));
+        if (!nl) {
+            if (partielle.size() + (fin - octets) > PROTOCOLE_TAILLE_LIGNE_MAX + 1) {  //! + 1 : '\r'
+                partielle.clear();
+                refuserLigne(sortie);
+            } else {
+                partielle.append(octets, fin - octets);
+            }
+            break;
+        }
+
+        std::string_view ligne(octets, nl - octets);
+        if (!partielle.empty()) {
+            partielle.append(octets, nl - octets);
+            ligne = partielle;
+        }
+        if (!ligne.empty() && ligne.back() == '\r') ligne.remove_suffix(1);
+
+        traiterLigne(ligne, sortie);
+        nbLignes++;
+        partielle.clear();
+        octets = nl + 1;
+    }
+    return nbLignes;
+}
+
+
+/**
+ * @brief Une transition ; la borne PROTOCOLE_TAILLE_LIGNE_MAX est appliquee
+ *        ici pour que tous les serveurs refusent les memes lignes
+ */
+void AutomateProtocole::traiterLigne(std::string_view ligne, std::string& sortie) {
+    if (ligne.size() > PROTOCOLE_TAILLE_LIGNE_MAX) {
+        refuserLigne(sortie);
+        return;
+    }
+    nbMessages++;
+    switch (etat) {
+    case ATTENTE_START:
+        if (commencePar(ligne, "SEC_MSG_START")) {
+            client = CLIENT_BADGE;
+            demarrerBadge(ligne, sortie);
+        } else if (commencePar(ligne, "SEC_MOB_START") && services && services->mobile()) {
+            client = CLIENT_MOBILE;
+            if (trim(ligne) == "SEC_MOB_START") {
+                etat = MOBILE_ATTENTE_LECTURE;
+                repondre(ligne, "SEC_MOB_START_OK\n", sortie);
+            } else {
+                erreur(ligne, "ERROR: Commande mobile non attendue\n", sortie);
+            }
+        } else {
+            erreur(ligne, "ERROR: Type de client inconnu\n", sortie);
+        }
+        break;
+
+    case BADGE_ATTENTE_DATE:
+        if (commencePar(ligne, "SEC_MSG_DATE_")) {
+            etat = BADGE_ATTENTE_STOP;
+            repondre(ligne, "SEC_MSG_OK\n", sortie);
+        } else {
+            erreur(ligne, "ERROR: Message de donnees attendu\n", sortie);
+        }
+        break;
+
+    case BADGE_ATTENTE_STOP:
+        if (trim(ligne) == "SEC_MSG_STOP") {
+            etat = TERMINE;
+            repondre(ligne, "SEC_MSG_STOP_OK\n", sortie);
+        } else {
+            erreur(ligne, "ERROR: Fin de message incorrect\n", sortie);
+        }
+        break;
+
+    case BADGE_MULTI:
+        if (commencePar(ligne, "SEC_MSG_DATE_")) {
+            nbDonnees++;
+            if (services) services->tracer(ligne, std::string_view());
+            if (nbDonnees - nbAcquittees >= intervalleAcquit) acquitter(sortie);
+        } else if (trim(ligne) == "SEC_MSG_STOP") {
+            etat = TERMINE;
+            nbAcquittees = nbDonnees;
+            repondre(ligne, "SEC_MSG_STOP_OK_" + std::to_string(nbDonnees) + "\n", sortie);
+        } else {
+            acquitter(sortie);      //! ce qui a ete accepte reste acquis
+            erreur(ligne, "ERROR: Message de donnees attendu\n", sortie);
+        }
+        break;
+
+    case MOBILE_ATTENTE_LECTURE:
+        if (trim(ligne) == "SEC_LECTURE_IA") {
+            std::string iaResult = services->analyseIA();
+            etat = MOBILE_ATTENTE_STOP;
+            repondre(ligne, iaResult.empty() ? std::string("SEC_MOB_IA_DETECT_NO\n")
+                                             : "SEC_MOB_IA_DETECT_YES_#" + iaResult + "\n", sortie);
+            break;
+        }
+        // pas de lecture IA demandee : la ligne doit etre la fin
+        // fall through
+    case MOBILE_ATTENTE_STOP:
+        if (trim(ligne) == "SEC_MOB_STOP") {
+            etat = TERMINE;
+            repondre(ligne, "SEC_MOB_STOP_OK\n", sortie);
+        } else {
+            erreur(ligne, "ERROR: Fin de message incorrect\n", sortie);
+        }
+        break;
+
+    case TERMINE:
+        break;
+    }
+}
+
+
+/**
+ * @brief SEC_MSG_START : session classique ; SEC_MSG_START_MULTI[_k] : session
+ *        multi-evenements, intervalle d'acquittement k borne a PROTOCOLE_ACQUIT_MAX
+ */
+void AutomateProtocole::demarrerBadge(std::string_view ligne, std::string& sortie) {
+    std::string_view suite = trim(ligne.substr(strlen("SEC_MSG_START")));
+    if (!commencePar(suite, "_MULTI")) {
+        etat = BADGE_ATTENTE_DATE;
+        repondre(ligne, "SEC_MSG_START_OK\n", sortie);
+        return;
+    }
+
+    unsigned long k = PROTOCOLE_ACQUIT_DEFAUT;
+    suite.remove_prefix(strlen("_MULTI"));
+    if (commencePar(suite, "_") && suite.size() > 1) {
+        k = 0;
+        for (size_t i = 1; i < suite.size() && std::isdigit((unsigned char)suite[i]) && k <= PROTOCOLE_ACQUIT_MAX; i++)
+            k = k * 10 + (suite[i] - '0');
+    }
+    if (k < 1) k = 1;
+    if (k > PROTOCOLE_ACQUIT_MAX) k = PROTOCOLE_ACQUIT_MAX;
+
+    intervalleAcquit = (unsigned)k;
+    etat = BADGE_MULTI;
+    repondre(ligne, "SEC_MSG_START_OK_MULTI_" + std::to_string(k) + "\n", sortie);
+}
+
+void AutomateProtocole::acquitter(std::string& sortie) {
+    if (etat != BADGE_MULTI || nbAcquittees == nbDonnees) return;
+    nbAcquittees = nbDonnees;
+    sortie += "SEC_MSG_OK_";
+    sortie += std::to_string(nbDonnees);
+    sortie += '\n';
+}
+
+void AutomateProtocole::refuserLigne(std::string& sortie) {
+    acquitter(sortie);      //! ce qui a ete accepte reste acquis
+    erreur(std::string_view(), "ERROR: Ligne trop longue\n", sortie);
+}
+
+void AutomateProtocole::repondre(std::string_view recu, std::string_view reponse, std::string& sortie) {
+    sortie += reponse;
+    if (services) services->tracer(recu, reponse);
+}
+
+void AutomateProtocole::erreur(std::string_view recu, const char* message, std::string& sortie) {
+    etat = TERMINE;
+    repondre(recu, message, sortie);
+}
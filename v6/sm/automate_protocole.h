@@ -0,0 +1,119 @@
+/**
+ * @file automate_protocole.h
+ * @brief Automates des protocoles badge (SEC_MSG_*) et mobile (SEC_MOB_*).
+ *
+ * L'automate ne fait aucune entree/sortie : il recoit des octets ou des lignes
+ * et ajoute ses reponses a une chaine que l'appelant envoie. Le meme code sert
+ * donc le modele bloquant (ClientConnecte) et les boucles epoll.
+ *
+ * La premiere ligne choisit le protocole (plus de recv MSG_PEEK) :
+ *
+ *   badge  : ATTENTE_START --SEC_MSG_START--> BADGE_ATTENTE_DATE
+ *            --SEC_MSG_DATE_...--> BADGE_ATTENTE_STOP --SEC_MSG_STOP--> TERMINE
+ *   mobile : ATTENTE_START --SEC_MOB_START--> MOBILE_ATTENTE_LECTURE
+ *            --SEC_LECTURE_IA--> MOBILE_ATTENTE_STOP --SEC_MOB_STOP--> TERMINE
+ *            (SEC_MOB_STOP directement accepte en MOBILE_ATTENTE_LECTURE)
+ *
+ * Session badge multi-evenements, negociee au demarrage :
+ *   SEC_MSG_START_MULTI_<k>  -> SEC_MSG_START_OK_MULTI_<k'>  (k' = min(k, PROTOCOLE_ACQUIT_MAX))
+ *   SEC_MSG_DATE_...         (autant que voulu, sans attendre de reponse)
+ *                            -> SEC_MSG_OK_<n> toutes les k' donnees et quand
+ *                               l'appelant a vide son entree (acquitter())
+ *   SEC_MSG_STOP             -> SEC_MSG_STOP_OK_<n>, puis fermeture
+ * n : nombre cumule de SEC_MSG_DATE_ acceptes dans la session, un acquit
+ * couvre toutes les donnees precedentes. Un serveur plus ancien repond
+ * SEC_MSG_START_OK (prefixe SEC_MSG_START reconnu) : le client revient
+ * alors a une donnee par session.
+ *
+ * Toute ligne inattendue : reponse "ERROR: ..." et TERMINE. L'appelant ferme
+ * la connexion une fois termine() et les reponses envoyees.
+ * Le protocole mobile demande un ServicesProtocole qui le sert (mobile(),
+ * analyse IA) ; sinon un client mobile recoit "ERROR: Type de client inconnu".
+ */
+
+#ifndef AUTOMATE_PROTOCOLE_H
+#define AUTOMATE_PROTOCOLE_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+#define PROTOCOLE_TAILLE_LIGNE_MAX  1024
+#define PROTOCOLE_ACQUIT_DEFAUT     32      //! SEC_MSG_START_MULTI sans intervalle
+#define PROTOCOLE_ACQUIT_MAX        1024
+
+/**
+ * @brief Ce que l'automate demande a son serveur (une instance par serveur ou par connexion)
+ */
+class ServicesProtocole {
+public:
+    virtual ~ServicesProtocole() {}
+    //! Protocole mobile servi (analyse IA disponible)
+    virtual bool mobile() const { return false; }
+    //! Resultat de l'analyse IA du jour, vide si rien n'est detecte
+    virtual std::string analyseIA() { return std::string(); }
+    //! Trace d'un echange ; reponse vide si la ligne n'en produit pas
+    virtual void tracer(std::string_view recu, std::string_view reponse) { (void)recu; (void)reponse; }
+};
+
+class AutomateProtocole {
+public:
+    enum Client {
+        CLIENT_INCONNU = 0,
+        CLIENT_BADGE   = 1,
+        CLIENT_MOBILE  = 2
+    };
+
+    enum Etat {
+        ATTENTE_START,
+        BADGE_ATTENTE_DATE,
+        BADGE_ATTENTE_STOP,
+        BADGE_MULTI,            //! donnees en rafale jusqu'a SEC_MSG_STOP
+        MOBILE_ATTENTE_LECTURE,
+        MOBILE_ATTENTE_STOP,
+        TERMINE
+    };
+
+    explicit AutomateProtocole(ServicesProtocole* services = nullptr);
+
+    //! Octets recus, n'importe quel decoupage ; rend le nombre de lignes traitees
+    size_t alimenter(const char* octets, size_t n, std::string& sortie);
+    //! Une ligne complete, fin de ligne retiree (lecteur de lignes de l'appelant) ;
+    //! plus de PROTOCOLE_TAILLE_LIGNE_MAX octets : refusee comme par refuserLigne()
+    void traiterLigne(std::string_view ligne, std::string& sortie);
+    //! Ligne trop longue dont l'appelant n'a pas garde les octets
+    void refuserLigne(std::string& sortie);
+    //! Abandon sans reponse (client parti)
+    void terminer() { etat = TERMINE; }
+    //! Session multi : acquit cumule des donnees pas encore acquittees ; a appeler
+    //! quand plus aucune ligne n'est en attente de traitement, avant d'envoyer
+    void acquitter(std::string& sortie);
+
+    bool termine() const { return etat == TERMINE; }
+    Etat getEtat() const { return etat; }
+    Client getClient() const { return client; }
+    unsigned long getNbMessages() const { return nbMessages; }
+    //! Donnees SEC_MSG_DATE_ acceptees dans la session
+    unsigned long getNbDonnees() const { return nbDonnees; }
+    //! Session multi : intervalle d'acquittement negocie, 0 pour une session classique
+    unsigned getIntervalleAcquit() const { return intervalleAcquit; }
+    //! Octets d'une ligne partielle en attente de sa fin
+    size_t enAttente() const { return partielle.size(); }
+
+private:
+    ServicesProtocole* services;
+    Etat etat;
+    Client client;
+    unsigned long nbMessages;
+    unsigned long nbDonnees;
+    unsigned long nbAcquittees;
+    unsigned intervalleAcquit;
+    std::string partielle;
+
+    void demarrerBadge(std::string_view ligne, std::string& sortie);
+
+    void repondre(std::string_view recu, std::string_view reponse, std::string& sortie);
+    void erreur(std::string_view recu, const char* message, std::string& sortie);
+};
+
+#endif // AUTOMATE_PROTOCOLE_H
@@ -0,0 +1,109 @@
+/**
+ * @file aller_retour_badges.cpp
+ * @brief Banc aller-retour du protocole badge : latence de chaque echange (Linux).
+ *
+ * Joue K sessions badge l'une apres l'autre sur une seule connexion a la fois
+ * et chronometre chaque echange (envoi de la ligne -> reponse complete) :
+ *   START -> START_OK, DATE -> OK, STOP -> STOP_OK
+ * Avec morceaux > 1, chaque ligne part en plusieurs send() espaces de 1 ms :
+ * le serveur doit recoller les lignes partielles.
+ *
+ * Commande de compilation :
+ * g++ -O2 -std=c++17 -o aller_retour_badges bench/aller_retour_badges.cpp
+ *
+ * Commande d'exécution :
+ * ./aller_retour_badges ip port [K sessions] [morceaux]
+ *   ex : ./aller_retour_badges 127.0.0.1 8080 200
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+using namespace std;
+using Horloge = std::chrono::steady_clock;
+
+static sockaddr_in adresse;
+static int nbMorceaux = 1;
+
+static bool envoyer(int s, const string& ligne) {
+    size_t taille = (ligne.size() + nbMorceaux - 1) / nbMorceaux;
+    for (size_t i = 0; i < ligne.size(); i += taille) {
+        if (i) usleep(1000);
+        size_t n = min(taille, ligne.size() - i);
+        if (send(s, ligne.data() + i, n, MSG_NOSIGNAL) != (ssize_t)n) return false;
+    }
+    return true;
+}
+
+//! Un echange chronometre, -1 si la reponse n'est pas celle attendue
+static double echanger(int s, const string& ligne, const char* attendu) {
+    auto t0 = Horloge::now();
+    if (!envoyer(s, ligne)) return -1;
+    string reponse;
+    char tampon[256];
+    ssize_t n;
+    while (reponse.find('\n') == string::npos && (n = recv(s, tampon, sizeof(tampon), 0)) > 0)
+        reponse.append(tampon, n);
+    double ms = chrono::duration<double, milli>(Horloge::now() - t0).count();
+    return reponse.find(attendu) == 0 ? ms : -1;
+}
+
+static void afficher(const char* nom, vector<double>& v) {
+    sort(v.begin(), v.end());
+    auto centile = [&](double p) { return v.empty() ? 0.0 : v[(size_t)(p * (v.size() - 1))]; };
+    cout << "  " << nom << "\t" << v.size() << " echanges  p50 " << centile(0.50)
+         << " ms  p99 " << centile(0.99) << " ms  max " << centile(1.0) << " ms" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "usage : aller_retour_badges ip port [K sessions] [morceaux]" << endl;
+        return -2;
+    }
+    adresse.sin_family = AF_INET;
+    adresse.sin_port = htons(atoi(argv[2]));
+    inet_pton(AF_INET, argv[1], &adresse.sin_addr);
+    int nbSessions = argc > 3 ? atoi(argv[3]) : 100;
+    nbMorceaux = argc > 4 ? max(1, atoi(argv[4])) : 1;
+
+    vector<double> start, date, stop;
+    int echecs = 0;
+    auto t0 = Horloge::now();
+    for (int i = 0; i < nbSessions; i++) {
+        int s = socket(AF_INET, SOCK_STREAM, 0);
+        int un = 1;
+        setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &un, sizeof(un));
+        timeval to{10, 0};
+        setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, &to, sizeof(to));
+        if (connect(s, (sockaddr*)&adresse, sizeof(adresse)) < 0) { close(s); echecs++; continue; }
+
+        ostringstream ligneDate;
+        ligneDate << "SEC_MSG_DATE_2026_10_19_12_00_00_BADGE_" << i << "\r\n";
+        double a = echanger(s, "SEC_MSG_START\r\n", "SEC_MSG_START_OK");
+        double b = a < 0 ? -1 : echanger(s, ligneDate.str(), "SEC_MSG_OK");
+        double c = b < 0 ? -1 : echanger(s, "SEC_MSG_STOP\r\n", "SEC_MSG_STOP_OK");
+        close(s);
+        if (c < 0) { echecs++; continue; }
+        start.push_back(a);
+        date.push_back(b);
+        stop.push_back(c);
+    }
+    double total = chrono::duration<double>(Horloge::now() - t0).count();
+
+    cout << nbSessions << " sessions en " << total << " s, " << echecs << " echec(s), "
+         << nbMorceaux << " morceau(x) par ligne" << endl;
+    afficher("START", start);
+    afficher("DATE ", date);
+    afficher("STOP ", stop);
+    return echecs != 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file charge_badges.cpp
+ * @brief Generateur de charge : lecteurs de badges simultanes contre serveur_secuvia (Linux).
+ *
+ * Deroulement :
+ *  1. ouvre N connexions qui envoient SEC_MSG_START, recoivent SEC_MSG_START_OK
+ *     puis restent ouvertes en milieu de session (lecteurs connectes)
+ *  2. lit la memoire (VmRSS) et le nombre de threads du serveur (/proc/<pid>/status)
+ *  3. joue S sessions badge completes (START, DATE, STOP) sur C threads et
+ *     mesure la duree de chacune (connect -> SEC_MSG_STOP_OK)
+ *  4. termine proprement les N sessions ouvertes
+ * Une ligne de resultat par execution, pour comparer les modeles de service.
+ *
+ * Commande de compilation :
+ * g++ -O2 -std=c++17 -o charge_badges bench/charge_badges.cpp -pthread
+ *
+ * Commande d'exécution :
+ * ./charge_badges ip port pidServeur [N connexions tenues] [S sessions] [C threads]
+ *   ex : ./serveur_secuvia 127.0.0.1 8080 epoll 2 > /dev/null &
+ *        ./charge_badges 127.0.0.1 8080 $! 5000 2000 8
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+using namespace std;
+using Horloge = std::chrono::steady_clock;
+
+static sockaddr_in adresse;
+
+static int connecter() {
+    int s = socket(AF_INET, SOCK_STREAM, 0);
+    if (s < 0) return -1;
+    int un = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &un, sizeof(un));
+    timeval to{10, 0};
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, &to, sizeof(to));
+    if (connect(s, (sockaddr*)&adresse, sizeof(adresse)) < 0) { close(s); return -1; }
+    return s;
+}
+
+//! Envoie une ligne puis attend la reponse complete (jusqu'au '\n')
+static bool echanger(int s, const string& ligne, const char* attendu) {
+    if (send(s, ligne.data(), ligne.size(), MSG_NOSIGNAL) != (ssize_t)ligne.size()) return false;
+    string reponse;
+    char c;
+    while (recv(s, &c, 1, 0) == 1) {
+        if (c == '\n') return reponse.find(attendu) == 0;
+        reponse += c;
+    }
+    return false;
+}
+
+static bool debutSession(int s) { return echanger(s, "SEC_MSG_START\r\n", "SEC_MSG_START_OK"); }
+
+static bool finSession(int s, int numero) {
+    ostringstream date;
+    date << "SEC_MSG_DATE_2026_10_19_12_00_00_BADGE_" << numero << "\r\n";
+    return echanger(s, date.str(), "SEC_MSG_OK") && echanger(s, "SEC_MSG_STOP\r\n", "SEC_MSG_STOP_OK");
+}
+
+//! Champ "Nom:  valeur kB" de /proc/<pid>/status
+static long lireStatus(int pid, const string& champ) {
+    ifstream f("/proc/" + to_string(pid) + "/status");
+    string ligne;
+    while (getline(f, ligne))
+        if (ligne.compare(0, champ.size(), champ) == 0) return atol(ligne.c_str() + champ.size() + 1);
+    return -1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        cout << "usage : charge_badges ip port pidServeur [N tenues] [S sessions] [C threads]" << endl;
+        return -2;
+    }
+    adresse.sin_family = AF_INET;
+    adresse.sin_port = htons(atoi(argv[2]));
+    inet_pton(AF_INET, argv[1], &adresse.sin_addr);
+    int pid = atoi(argv[3]);
+    int nbTenues = argc > 4 ? atoi(argv[4]) : 1000;
+    int nbSessions = argc > 5 ? atoi(argv[5]) : 1000;
+    int nbThreads = argc > 6 ? atoi(argv[6]) : 4;
+
+    rlimit r;
+    getrlimit(RLIMIT_NOFILE, &r);
+    r.rlim_cur = r.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &r);
+
+    long rssAvant = lireStatus(pid, "VmRSS");
+
+    // 1. Lecteurs connectes, en milieu de session
+    auto t0 = Horloge::now();
+    vector<int> tenues;
+    for (int i = 0; i < nbTenues; i++) {
+        int s = connecter();
+        if (s < 0 || !debutSession(s)) {
+            if (s >= 0) close(s);
+            cerr << "connexion tenue " << i << " refusee" << endl;
+            break;
+        }
+        tenues.push_back(s);
+    }
+    double dureeOuverture = chrono::duration<double>(Horloge::now() - t0).count();
+
+    // 2. Cout memoire du serveur
+    usleep(200000);
+    long rss = lireStatus(pid, "VmRSS");
+    long threads = lireStatus(pid, "Threads");
+
+    // 3. Sessions completes pendant que les lecteurs sont connectes
+    vector<vector<double>> durees(nbThreads);
+    atomic<int> suivante(0), echecs(0);
+    t0 = Horloge::now();
+    vector<thread> ouvriers;
+    for (int k = 0; k < nbThreads; k++) {
+        ouvriers.emplace_back([&, k]() {
+            int i;
+            while ((i = suivante++) < nbSessions) {
+                auto d = Horloge::now();
+                int s = connecter();
+                bool ok = s >= 0 && debutSession(s) && finSession(s, i);
+                if (s >= 0) close(s);
+                if (!ok) { echecs++; continue; }
+                durees[k].push_back(chrono::duration<double, milli>(Horloge::now() - d).count());
+            }
+        });
+    }
+    for (auto& o : ouvriers) o.join();
+    double dureeSessions = chrono::duration<double>(Horloge::now() - t0).count();
+
+    vector<double> toutes;
+    for (auto& v : durees) toutes.insert(toutes.end(), v.begin(), v.end());
+    sort(toutes.begin(), toutes.end());
+    auto centile = [&](double p) { return toutes.empty() ? 0.0 : toutes[(size_t)(p * (toutes.size() - 1))]; };
+
+    // 4. Fin des sessions tenues
+    int finOk = 0;
+    for (size_t i = 0; i < tenues.size(); i++) {
+        if (finSession(tenues[i], (int)i)) finOk++;
+        close(tenues[i]);
+    }
+
+    cout << "tenues " << tenues.size() << " (" << dureeOuverture << " s)"
+         << " | serveur RSS " << rssAvant << " -> " << rss << " Ko"
+         << " (" << (tenues.empty() ? 0 : (rss - rssAvant) * 1024 / (long)tenues.size()) << " o/connexion)"
+         << ", threads " << threads
+         << " | sessions " << toutes.size() << "/" << nbSessions << " en " << dureeSessions << " s"
+         << " (" << (toutes.size() / dureeSessions) << "/s)"
+         << " p50 " << centile(0.50) << " ms p99 " << centile(0.99) << " ms max " << centile(1.0) << " ms"
+         << " | fin des tenues " << finOk << "/" << tenues.size()
+         << endl;
+    return echecs != 0 || finOk != (int)tenues.size();
+}
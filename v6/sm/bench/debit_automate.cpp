@@ -0,0 +1,114 @@
+/**
+ * @file debit_automate.cpp
+ * @brief Debit de l'AutomateProtocole seul, en messages/s sur un coeur (sans socket).
+ *
+ * Sessions badge (START, DATE, STOP) et mobile (START, LECTURE_IA, STOP)
+ * poussees en memoire dans un automate neuf par session, avec plusieurs
+ * decoupages des octets recus :
+ *   - session  : la session entiere en un morceau (client qui enchaine)
+ *   - 15 octets: paquets courts, lignes a cheval sur deux morceaux
+ *   - 7 octets : lignes coupees n'importe ou (paquets fragmentes)
+ *   - 1 octet  : pire cas
+ *   - lignes   : traiterLigne() direct (lignes deja decoupees par LecteurLignes)
+ *
+ * Commande de compilation :
+ * g++ -O2 -std=c++17 -o debit_automate bench/debit_automate.cpp automate_protocole.cpp
+ *
+ * Commande d'exécution :
+ * ./debit_automate [secondes par cas]
+ */
+
+#include "../automate_protocole.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+
+using namespace std;
+using Horloge = std::chrono::steady_clock;
+
+//! Mobile servi, analyse IA constante
+class ServicesBanc : public ServicesProtocole {
+public:
+    bool mobile() const override { return true; }
+    std::string analyseIA() override { return std::string(); }
+};
+
+static const string BADGE =
+    "SEC_MSG_START\r\nSEC_MSG_DATE_2026_10_19_12_00_00_BADGE_4242\r\nSEC_MSG_STOP\r\n";
+static const string MOBILE =
+    "SEC_MOB_START\r\nSEC_LECTURE_IA\r\nSEC_MOB_STOP\r\n";
+
+static volatile size_t puits;
+
+//! Sessions completes pendant ~duree s, morceaux de taille "morceau" (0 : session entiere)
+static void mesurer(const char* nom, const string& session, size_t morceau, ServicesProtocole* services, double duree) {
+    string sortie;
+    sortie.reserve(256);
+    unsigned long sessions = 0, messages = 0;
+    auto t0 = Horloge::now();
+    auto fin = t0 + chrono::duration_cast<Horloge::duration>(chrono::duration<double>(duree));
+    while (Horloge::now() < fin) {
+        for (int k = 0; k < 1000; k++) {
+            AutomateProtocole automate(services);
+            size_t pas = morceau ? morceau : session.size();
+            for (size_t i = 0; i < session.size(); i += pas)
+                automate.alimenter(session.data() + i, min(pas, session.size() - i), sortie);
+            if (!automate.termine() || sortie.find("ERROR") != string::npos) {
+                cerr << nom << " : session refusee [" << sortie << "]" << endl;
+                return;
+            }
+            messages += automate.getNbMessages();
+            puits = puits + sortie.size();
+            sortie.clear();
+        }
+        sessions += 1000;
+    }
+    double s = chrono::duration<double>(Horloge::now() - t0).count();
+    cout << "  " << left << setw(22) << nom << right << setw(8) << (long)(messages / s / 1000) << " k msg/s"
+         << setw(8) << (long)(sessions / s / 1000) << " k sessions/s"
+         << setw(8) << fixed << setprecision(1) << s * 1e9 / messages << " ns/msg" << endl;
+    cout.unsetf(ios::fixed);
+}
+
+//! traiterLigne() direct : le cout de l'automate sans le decoupage
+static void mesurerLignes(const char* nom, const vector<string>& lignes, ServicesProtocole* services, double duree) {
+    string sortie;
+    sortie.reserve(256);
+    unsigned long messages = 0;
+    auto t0 = Horloge::now();
+    auto fin = t0 + chrono::duration_cast<Horloge::duration>(chrono::duration<double>(duree));
+    while (Horloge::now() < fin) {
+        for (int k = 0; k < 1000; k++) {
+            AutomateProtocole automate(services);
+            for (const string& l : lignes) automate.traiterLigne(l, sortie);
+            messages += automate.getNbMessages();
+            puits = puits + sortie.size();
+            sortie.clear();
+        }
+    }
+    double s = chrono::duration<double>(Horloge::now() - t0).count();
+    cout << "  " << left << setw(22) << nom << right << setw(8) << (long)(messages / s / 1000) << " k msg/s"
+         << setw(8) << "" << "              "
+         << setw(8) << fixed << setprecision(1) << s * 1e9 / messages << " ns/msg" << endl;
+    cout.unsetf(ios::fixed);
+}
+
+int main(int argc, char* argv[]) {
+    double duree = argc > 1 ? atof(argv[1]) : 1.0;
+    ServicesBanc services;
+
+    cout << "Badge (" << BADGE.size() << " octets, 3 messages)" << endl;
+    mesurer("session", BADGE, 0, nullptr, duree);
+    mesurer("15 octets", BADGE, 15, nullptr, duree);
+    mesurer("7 octets", BADGE, 7, nullptr, duree);
+    mesurer("1 octet", BADGE, 1, nullptr, duree);
+    mesurerLignes("lignes", { "SEC_MSG_START", "SEC_MSG_DATE_2026_10_19_12_00_00_BADGE_4242", "SEC_MSG_STOP" }, nullptr, duree);
+
+    cout << "Mobile (" << MOBILE.size() << " octets, 3 messages, IA factice)" << endl;
+    mesurer("session", MOBILE, 0, &services, duree);
+    mesurer("1 octet", MOBILE, 1, &services, duree);
+    return 0;
+}
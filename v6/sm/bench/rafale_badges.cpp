@@ -0,0 +1,163 @@
+/**
+ * @file rafale_badges.cpp
+ * @brief Vidage d'un arriere d'evenements badge apres une coupure (Linux).
+ *
+ * Envoie E evenements SEC_MSG_DATE_ au serveur de deux facons et compare :
+ *  - classique : une session par evenement (connect, START, DATE, STOP)
+ *  - multi     : une seule session SEC_MSG_START_MULTI_<k>, les donnees
+ *                envoyees sans attendre, au plus W non acquittees en vol ;
+ *                les acquits cumules SEC_MSG_OK_<n> liberent la fenetre,
+ *                SEC_MSG_STOP_OK_<E> confirme le total
+ * Un serveur qui repond SEC_MSG_START_OK a la negociation ne connait pas
+ * le mode multi : la mesure multi est alors sautee.
+ *
+ * Commande de compilation :
+ * g++ -O2 -std=c++17 -o rafale_badges bench/rafale_badges.cpp
+ *
+ * Commande d'exécution :
+ * ./rafale_badges ip port [E evenements] [k intervalle d'acquit] [W fenetre]
+ *   ex : ./serveur_secuvia 127.0.0.1 8080 epoll 2 > /dev/null &
+ *        ./rafale_badges 127.0.0.1 8080 2000 32 256
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+using namespace std;
+using Horloge = std::chrono::steady_clock;
+
+static sockaddr_in adresse;
+
+static int connecter() {
+    int s = socket(AF_INET, SOCK_STREAM, 0);
+    if (s < 0) return -1;
+    int un = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &un, sizeof(un));
+    timeval to{10, 0};
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, &to, sizeof(to));
+    if (connect(s, (sockaddr*)&adresse, sizeof(adresse)) < 0) { close(s); return -1; }
+    return s;
+}
+
+static bool envoyer(int s, const string& octets) {
+    return send(s, octets.data(), octets.size(), MSG_NOSIGNAL) == (ssize_t)octets.size();
+}
+
+//! Reponses ligne par ligne, tamponnees
+struct Reponses {
+    int s;
+    string tampon;
+
+    bool ligne(string& l) {
+        size_t nl;
+        while ((nl = tampon.find('\n')) == string::npos) {
+            char bloc[4096];
+            ssize_t n = recv(s, bloc, sizeof(bloc), 0);
+            if (n <= 0) return false;
+            tampon.append(bloc, n);
+        }
+        l = tampon.substr(0, nl);
+        if (!l.empty() && l.back() == '\r') l.pop_back();
+        tampon.erase(0, nl + 1);
+        return true;
+    }
+};
+
+static string donnee(int numero) {
+    ostringstream os;
+    os << "SEC_MSG_DATE_2026_10_19_12_00_00_BADGE_" << numero << "\r\n";
+    return os.str();
+}
+
+static bool evenementClassique(int numero) {
+    int s = connecter();
+    if (s < 0) return false;
+    Reponses r{s, ""};
+    string l;
+    bool ok = envoyer(s, "SEC_MSG_START\r\n") && r.ligne(l) && l == "SEC_MSG_START_OK"
+           && envoyer(s, donnee(numero)) && r.ligne(l) && l == "SEC_MSG_OK"
+           && envoyer(s, "SEC_MSG_STOP\r\n") && r.ligne(l) && l == "SEC_MSG_STOP_OK";
+    close(s);
+    return ok;
+}
+
+//! -1 : serveur sans mode multi ; 0 : echec ; 1 : les E evenements acquittes
+static int rafaleMulti(int nbEvenements, int k, int fenetre, int& acquits) {
+    int s = connecter();
+    if (s < 0) return 0;
+    Reponses r{s, ""};
+    string l;
+    if (!envoyer(s, "SEC_MSG_START_MULTI_" + to_string(k) + "\r\n") || !r.ligne(l)) { close(s); return 0; }
+    if (l == "SEC_MSG_START_OK") {
+        envoyer(s, "SEC_MSG_STOP\r\n");
+        close(s);
+        return -1;
+    }
+    if (l.compare(0, 23, "SEC_MSG_START_OK_MULTI_") != 0) { close(s); return 0; }
+
+    int envoyees = 0, acquittees = 0;
+    acquits = 0;
+    string lot;
+    while (acquittees < nbEvenements) {
+        //! remplit la fenetre en un envoi
+        lot.clear();
+        while (envoyees < nbEvenements && envoyees - acquittees < fenetre) lot += donnee(envoyees++);
+        if (!lot.empty() && !envoyer(s, lot)) { close(s); return 0; }
+
+        if (!r.ligne(l) || l.compare(0, 11, "SEC_MSG_OK_") != 0) {
+            cerr << "reponse inattendue : " << l << endl;
+            close(s);
+            return 0;
+        }
+        acquittees = atoi(l.c_str() + 11);
+        acquits++;
+    }
+    bool ok = envoyer(s, "SEC_MSG_STOP\r\n") && r.ligne(l) && l == "SEC_MSG_STOP_OK_" + to_string(nbEvenements);
+    close(s);
+    return ok ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "usage : rafale_badges ip port [E evenements] [k intervalle d'acquit] [W fenetre]" << endl;
+        return -2;
+    }
+    adresse.sin_family = AF_INET;
+    adresse.sin_port = htons(atoi(argv[2]));
+    inet_pton(AF_INET, argv[1], &adresse.sin_addr);
+    int nbEvenements = argc > 3 ? atoi(argv[3]) : 1000;
+    int k = argc > 4 ? atoi(argv[4]) : 32;
+    int fenetre = argc > 5 ? atoi(argv[5]) : 256;
+    if (fenetre < 1) fenetre = 1;
+
+    auto t0 = Horloge::now();
+    int okClassique = 0;
+    for (int i = 0; i < nbEvenements; i++)
+        if (evenementClassique(i)) okClassique++;
+    double dureeClassique = chrono::duration<double>(Horloge::now() - t0).count();
+
+    t0 = Horloge::now();
+    int acquits = 0;
+    int multi = rafaleMulti(nbEvenements, k, fenetre, acquits);
+    double dureeMulti = chrono::duration<double>(Horloge::now() - t0).count();
+
+    cout << "classique " << okClassique << "/" << nbEvenements << " en " << dureeClassique << " s"
+         << " (" << (okClassique / dureeClassique) << " evt/s)";
+    if (multi < 0) {
+        cout << " | multi non supporte par le serveur" << endl;
+        return okClassique != nbEvenements;
+    }
+    cout << " | multi k=" << k << " W=" << fenetre << " " << (multi ? "ok" : "ECHEC") << " en " << dureeMulti << " s"
+         << " (" << (multi ? nbEvenements / dureeMulti : 0.0) << " evt/s, " << acquits << " acquits)"
+         << endl;
+    return okClassique != nbEvenements || multi != 1;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file tempete_connexions.cpp
+ * @brief Tempete de connexions : debit d'acceptation de serveur_secuvia (Linux).
+ *
+ * C threads ouvrent des connexions aussi vite que possible pendant D secondes.
+ * Chaque connexion envoie d'un bloc START, DATE et STOP, attend SEC_MSG_STOP_OK
+ * puis la fermeture par le serveur (pas de TIME_WAIT cote client).
+ * Mesures : connexions/s, duree du connect() (attente dans la file d'ecoute,
+ * SYN perdus : ~1 s et plus), duree de la session, echecs, et compteurs
+ * ListenOverflows / ListenDrops du noyau (/proc/net/netstat) pendant la tempete.
+ *
+ * Commande de compilation :
+ * g++ -O2 -std=c++17 -o tempete_connexions bench/tempete_connexions.cpp -pthread
+ *
+ * Commande d'exécution :
+ * ./tempete_connexions ip port [D secondes] [C threads]
+ *   ex : ./serveur_secuvia 127.0.0.1 8080 epoll 1 accepteurs 2 backlog 4096 > /dev/null &
+ *        ./tempete_connexions 127.0.0.1 8080 5 64
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+using namespace std;
+using Horloge = std::chrono::steady_clock;
+
+static sockaddr_in adresse;
+
+static const string SESSION =
+    "SEC_MSG_START\r\nSEC_MSG_DATE_2026_10_19_12_00_00_BADGE_1\r\nSEC_MSG_STOP\r\n";
+
+//! Valeur d'un compteur TcpExt de /proc/net/netstat (ligne d'en-tetes puis ligne de valeurs)
+static long compteurTcpExt(const string& nom) {
+    ifstream f("/proc/net/netstat");
+    string entetes, valeurs;
+    while (getline(f, entetes) && getline(f, valeurs)) {
+        if (entetes.compare(0, 7, "TcpExt:") != 0) continue;
+        istringstream e(entetes), v(valeurs);
+        string cle, valeur;
+        while (e >> cle && v >> valeur)
+            if (cle == nom) return atol(valeur.c_str());
+    }
+    return -1;
+}
+
+struct Mesures {
+    vector<double> connect, session;
+    long echecsConnect = 0, echecsSession = 0;
+};
+
+static void tempete(Horloge::time_point finTempete, Mesures& m) {
+    char tampon[256];
+    while (Horloge::now() < finTempete) {
+        auto t0 = Horloge::now();
+        int s = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (s < 0) { m.echecsConnect++; usleep(1000); continue; }
+        int un = 1;
+        setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &un, sizeof(un));
+        timeval to{5, 0};
+        setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, &to, sizeof(to));
+        setsockopt(s, SOL_SOCKET, SO_SNDTIMEO, &to, sizeof(to));   //! borne aussi connect()
+        if (connect(s, (sockaddr*)&adresse, sizeof(adresse)) < 0) {
+            close(s);
+            m.echecsConnect++;
+            continue;
+        }
+        auto t1 = Horloge::now();
+
+        string reponse;
+        bool ok = send(s, SESSION.data(), SESSION.size(), MSG_NOSIGNAL) == (ssize_t)SESSION.size();
+        ssize_t n;
+        while (ok && (n = recv(s, tampon, sizeof(tampon), 0)) > 0) reponse.append(tampon, n);
+        close(s);
+        if (!ok || reponse.find("SEC_MSG_STOP_OK") == string::npos) { m.echecsSession++; continue; }
+
+        m.connect.push_back(chrono::duration<double, milli>(t1 - t0).count());
+        m.session.push_back(chrono::duration<double, milli>(Horloge::now() - t0).count());
+    }
+}
+
+static string centiles(vector<double>& v) {
+    sort(v.begin(), v.end());
+    auto centile = [&](double p) { return v.empty() ? 0.0 : v[(size_t)(p * (v.size() - 1))]; };
+    ostringstream os;
+    os << "p50 " << centile(0.50) << " ms p99 " << centile(0.99) << " ms max " << centile(1.0) << " ms";
+    return os.str();
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "usage : tempete_connexions ip port [D secondes] [C threads]" << endl;
+        return -2;
+    }
+    adresse.sin_family = AF_INET;
+    adresse.sin_port = htons(atoi(argv[2]));
+    inet_pton(AF_INET, argv[1], &adresse.sin_addr);
+    double duree = argc > 3 ? atof(argv[3]) : 5.0;
+    int nbThreads = argc > 4 ? atoi(argv[4]) : 32;
+
+    rlimit r;
+    getrlimit(RLIMIT_NOFILE, &r);
+    r.rlim_cur = r.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &r);
+
+    long debordements = compteurTcpExt("ListenOverflows");
+    long pertes = compteurTcpExt("ListenDrops");
+
+    vector<Mesures> mesures(nbThreads);
+    vector<thread> threads;
+    auto t0 = Horloge::now();
+    auto fin = t0 + chrono::duration_cast<Horloge::duration>(chrono::duration<double>(duree));
+    for (int k = 0; k < nbThreads; k++) threads.emplace_back(tempete, fin, std::ref(mesures[k]));
+    for (auto& t : threads) t.join();
+    double ecoule = chrono::duration<double>(Horloge::now() - t0).count();
+
+    Mesures total;
+    for (auto& m : mesures) {
+        total.connect.insert(total.connect.end(), m.connect.begin(), m.connect.end());
+        total.session.insert(total.session.end(), m.session.begin(), m.session.end());
+        total.echecsConnect += m.echecsConnect;
+        total.echecsSession += m.echecsSession;
+    }
+
+    cout << total.session.size() << " sessions en " << ecoule << " s (" << (long)(total.session.size() / ecoule)
+         << " connexions/s, " << nbThreads << " threads)"
+         << " | connect " << centiles(total.connect)
+         << " | session " << centiles(total.session)
+         << " | echecs connect " << total.echecsConnect << ", session " << total.echecsSession
+         << " | ListenOverflows +" << compteurTcpExt("ListenOverflows") - debordements
+         << ", ListenDrops +" << compteurTcpExt("ListenDrops") - pertes
+         << endl;
+    return total.echecsConnect + total.echecsSession != 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file test_lecteur_lignes.cpp
+ * @brief Verification de LecteurLignes sur une socketpair (Linux).
+ *
+ * Cas couverts : lignes normales et "\r\n", ligne de LECTEUR_TAILLE_LIGNE_MAX
+ * octets, ligne trop longue recue d'un bloc avec sa fin (sautee, la suivante
+ * est lue), ligne trop longue sans fin, derniere ligne sans '\n'.
+ * Code de retour 0 si tout passe.
+ *
+ * Commande de compilation :
+ * g++ -O2 -std=c++17 -o test_lecteur_lignes bench/test_lecteur_lignes.cpp lecteur_lignes.cpp
+ */
+
+#include "../lecteur_lignes.h"
+
+#include <iostream>
+#include <string>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace std;
+
+static int echecs = 0;
+
+static void verifier(bool condition, const char* cas) {
+    cout << (condition ? "ok     " : "ECHEC  ") << cas << endl;
+    if (!condition) echecs++;
+}
+
+//! Ecrit les octets d'un bloc puis ferme l'extremite d'ecriture
+static LecteurLignes* preparer(int paire[2], const string& octets) {
+    socketpair(AF_UNIX, SOCK_STREAM, 0, paire);
+    if (!octets.empty()) write(paire[1], octets.data(), octets.size());
+    shutdown(paire[1], SHUT_WR);
+    return new LecteurLignes(paire[0]);
+}
+
+static void fermer(int paire[2], LecteurLignes* l) {
+    delete l;
+    close(paire[0]);
+    close(paire[1]);
+}
+
+int main() {
+    int paire[2];
+    string_view ligne;
+
+    {
+        LecteurLignes* l = preparer(paire, "SEC_MSG_START\r\nSEC_MSG_STOP\n");
+        verifier(l->lireLigne(ligne) == LecteurLignes::LIGNE && ligne == "SEC_MSG_START", "ligne \\r\\n");
+        verifier(l->lireLigne(ligne) == LecteurLignes::LIGNE && ligne == "SEC_MSG_STOP", "ligne \\n");
+        verifier(l->lireLigne(ligne) == LecteurLignes::FIN, "fin de connexion");
+        fermer(paire, l);
+    }
+    {
+        string limite(LECTEUR_TAILLE_LIGNE_MAX, 'a');
+        LecteurLignes* l = preparer(paire, limite + "\n" + limite + "\r\n");
+        verifier(l->lireLigne(ligne) == LecteurLignes::LIGNE && ligne.size() == LECTEUR_TAILLE_LIGNE_MAX,
+                 "ligne de LECTEUR_TAILLE_LIGNE_MAX octets acceptee");
+        verifier(l->lireLigne(ligne) == LecteurLignes::LIGNE && ligne.size() == LECTEUR_TAILLE_LIGNE_MAX,
+                 "idem terminee par \\r\\n (le \\r ne compte pas)");
+        fermer(paire, l);
+    }
+    {
+        string longue(3000, 'a');
+        LecteurLignes* l = preparer(paire, longue + "\nSEC_MSG_STOP\n");
+        verifier(l->lireLigne(ligne) == LecteurLignes::TROP_LONGUE, "ligne trop longue recue d'un bloc avec sa fin");
+        verifier(l->lireLigne(ligne) == LecteurLignes::LIGNE && ligne == "SEC_MSG_STOP", "ligne suivante lue");
+        fermer(paire, l);
+    }
+    {
+        string longue(LECTEUR_TAILLE_LIGNE_MAX + 1, 'a');
+        LecteurLignes* l = preparer(paire, longue + "\n");
+        verifier(l->lireLigne(ligne) == LecteurLignes::TROP_LONGUE, "LECTEUR_TAILLE_LIGNE_MAX + 1 octets refusee");
+        fermer(paire, l);
+    }
+    {
+        string longue(3000, 'a');
+        LecteurLignes* l = preparer(paire, longue);
+        verifier(l->lireLigne(ligne) == LecteurLignes::TROP_LONGUE, "ligne trop longue sans fin");
+        fermer(paire, l);
+    }
+    {
+        string longue(LECTEUR_TAILLE_LIGNE_MAX + 1, 'a');
+        LecteurLignes* l = preparer(paire, longue);
+        verifier(l->lireLigne(ligne) == LecteurLignes::TROP_LONGUE, "LECTEUR_TAILLE_LIGNE_MAX + 1 octets puis fermeture");
+        fermer(paire, l);
+    }
+    {
+        LecteurLignes* l = preparer(paire, "SEC_MSG_STOP");
+        verifier(l->lireLigne(ligne) == LecteurLignes::LIGNE && ligne == "SEC_MSG_STOP", "derniere ligne sans \\n");
+        fermer(paire, l);
+    }
+
+    if (echecs) cout << echecs << " echec(s)" << endl;
+    else cout << "tout passe" << endl;
+    return echecs != 0;
+}
@@ -11,6 +11,7 @@
 #define CLIENT_CONNECTE_H
 
 #include <string>
+#include <string_view>
 #include <chrono>
 #include <ctime>
 
@@ -23,16 +24,24 @@
 #include <unistd.h>
 #endif
 
+#include "lecteur_lignes.h"
+#include "automate_protocole.h"
+
 class FichierLog;
 class PredectiveIA;
 class ServeurDAO;
 
-class ClientConnecte {
+/**
+ * @brief Session bloquante : lignes du LecteurLignes, protocole de l'AutomateProtocole
+ */
+class ClientConnecte : public ServicesProtocole {
 private:
     int clientSocket;
     std::string ipAddress;
     std::string connectionDateTime;
     int clientType;
+    LecteurLignes lecteur;      //! tampon de reception de la connexion
+    AutomateProtocole automate; //! etat du protocole badge ou mobile
 
 public:
     ClientConnecte(int socket);
@@ -40,18 +49,22 @@ public:
 
     void handleConnection();
 
+    //! ServicesProtocole
+#ifdef TRAITEMENT_MOBILE
+    bool mobile() const override { return true; }
+    std::string analyseIA() override;
+#endif
+    void tracer(std::string_view recu, std::string_view reponse) override;
+
 private:
-    int getClientType();
-    bool traitementClientBadge();
-    bool traitementClientMobile();
+    //! Tout ou rien : false si le client est parti (fin de session)
+    bool envoyer(const std::string& octets);
 
-    std::string recvLine();
     std::string recvLineWithTimeout(int sock, int timeout_sec = 5, int max_attempts = 3);
     
-    std::string trim(const std::string& s);
-    void traceRecv (const std::string& txt, int nb, const std::string& buf);
+    std::string trim(std::string_view s);
+    void traceRecv (const std::string& txt, int nb, std::string_view buf);
     void traceSend (const std::string& txt);
-    int bytesReadRecvLine;
 };
 
 #endif // CLIENT_CONNECTE_H
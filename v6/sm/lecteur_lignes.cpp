@@ -0,0 +1,86 @@
+/**
+ * @file lecteur_lignes.cpp
+ * @brief Code du lecteur de lignes tamponne (voir lecteur_lignes.h).
+ */
+
+#include "lecteur_lignes.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#elif __linux__
+#include <sys/socket.h>
+#include <errno.h>
+#endif
+
+
+LecteurLignes::LecteurLignes(int socket) : socket(socket), debut(0), fin(0), examine(0), lectures(0) {}
+
+LecteurLignes::Resultat LecteurLignes::lireLigne(std::string_view& ligne) {
+    for (;;) {
+        //! 1. Une ligne complete est-elle deja en tampon ?
+        const char* nl = static_cast<const char*>(memchr(tampon + examine, '\n', fin - examine));
+        if (nl) {
+            size_t longueur = nl - (tampon + debut);
+            if (longueur && tampon[debut + longueur - 1] == '\r') longueur--;
+            if (longueur > LECTEUR_TAILLE_LIGNE_MAX) {
+                //! recue d'un bloc avec sa fin : la ligne est sautee
+                debut = examine = nl - tampon + 1;
+                return TROP_LONGUE;
+            }
+            ligne = std::string_view(tampon + debut, longueur);
+            debut = examine = nl - tampon + 1;
+            return LIGNE;
+        }
+        examine = fin;
+
+        if (fin - debut > LECTEUR_TAILLE_LIGNE_MAX + 1) {     //! + 1 : le '\r' d'une ligne a la limite
+            debut = fin = examine = 0;
+            return TROP_LONGUE;
+        }
+
+        //! 2. Place pour la suite : la ligne partielle revient en tete
+        //!    (les vues rendues avant cet appel ne sont plus utilisees)
+        if (debut == fin) {
+            debut = fin = examine = 0;
+        } else if (fin == sizeof(tampon) || debut > sizeof(tampon) / 2) {
+            memmove(tampon, tampon + debut, fin - debut);
+            fin -= debut;
+            examine = fin;
+            debut = 0;
+        }
+
+        //! 3. Tout ce qui est disponible, en un appel
+#ifdef _WIN32
+        int n = recv(socket, tampon + fin, (int)(sizeof(tampon) - fin), 0);
+#elif __linux__
+        ssize_t n = recv(socket, tampon + fin, sizeof(tampon) - fin, 0);
+#endif
+        lectures++;
+        if (n > 0) {
+            fin += n;
+            continue;
+        }
+#ifdef __linux__
+        if (n < 0 && errno == EINTR) continue;
+#endif
+        if (n < 0) return ERREUR;
+
+        //! Fermeture : la ligne sans '\n' est rendue telle quelle
+        if (fin == debut) return FIN;
+        size_t longueur = fin - debut;
+        if (tampon[debut + longueur - 1] == '\r') longueur--;
+        if (longueur > LECTEUR_TAILLE_LIGNE_MAX) {
+            debut = examine = fin;
+            return TROP_LONGUE;
+        }
+        ligne = std::string_view(tampon + debut, longueur);
+        debut = examine = fin;
+        return LIGNE;
+    }
+}
+
+bool LecteurLignes::ligneDisponible() const {
+    return memchr(tampon + examine, '\n', fin - examine) != nullptr;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file lecteur_lignes.h
+ * @brief Lecture de lignes tamponnee sur une socket bloquante.
+ *
+ * Chaque recv() prend tout ce qui est disponible (jusqu'a la place libre du
+ * tampon) ; les lignes sont decoupees sur place et rendues comme des vues
+ * sur le tampon, sans copie. Une ligne partielle attend la lecture suivante.
+ * Fins de ligne "\n" et "\r\n". Une ligne de plus de LECTEUR_TAILLE_LIGNE_MAX
+ * octets est refusee (TROP_LONGUE) : sautee si sa fin est deja recue, sinon
+ * le tampon est vide.
+ *
+ * Une vue rendue par lireLigne() reste valide jusqu'a l'appel suivant.
+ */
+
+#ifndef LECTEUR_LIGNES_H
+#define LECTEUR_LIGNES_H
+
+#include <string_view>
+#include <cstddef>
+
+#define LECTEUR_TAILLE_TAMPON       4096
+#define LECTEUR_TAILLE_LIGNE_MAX    1024
+
+class LecteurLignes {
+public:
+    enum Resultat {
+        LIGNE,          //! ligne complete (ou derniere ligne sans '\n' avant la fermeture)
+        FIN,            //! connexion fermee par le client, plus rien en tampon
+        TROP_LONGUE,    //! LECTEUR_TAILLE_LIGNE_MAX depasse
+        ERREUR          //! echec de recv()
+    };
+
+    explicit LecteurLignes(int socket);
+
+    Resultat lireLigne(std::string_view& ligne);
+
+    //! Octets recus et pas encore rendus
+    size_t enAttente() const { return fin - debut; }
+    //! Une ligne complete est deja en tampon : lireLigne() la rendra sans recv()
+    bool ligneDisponible() const;
+    //! Appels a recv() depuis la creation
+    unsigned long nbLectures() const { return lectures; }
+
+private:
+    int socket;
+    char tampon[LECTEUR_TAILLE_TAMPON];
+    size_t debut;           //! premier octet pas encore rendu
+    size_t fin;             //! fin des octets recus
+    size_t examine;         //! deja cherche '\n' jusqu'ici
+    unsigned long lectures;
+};
+
+#endif // LECTEUR_LIGNES_H
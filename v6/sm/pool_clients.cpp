@@ -0,0 +1,225 @@
+/**
+ * @file pool_clients.cpp
+ * @brief Code du pool d'ouvriers (voir pool_clients.h).
+ */
+
+#include "pool_clients.h"
+
+#include <iostream>
+#include <sstream>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#elif __linux__
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+
+static void fermerSocket(int socket) {
+#ifdef _WIN32
+    closesocket(socket);
+#elif __linux__
+    close(socket);
+#endif
+}
+
+
+PoolClients::PoolClients(int nbOuvriers, size_t capacite, SaturationPool saturation,
+                         std::function<void(int)> traitement)
+    : capacite(capacite ? capacite : 1), saturation(saturation), traitement(traitement), suivant(0),
+      enMarche(false), enFile(0), occupes(0),
+      nbDeposees(0), nbRefusees(0), nbRetardees(0), nbVolees(0), nbServies(0),
+      attenteTotaleUs(0), attenteMaxUs(0) {
+    if (nbOuvriers < 1) nbOuvriers = 1;
+    for (int i = 0; i < nbOuvriers; i++) ouvriers.push_back(new Ouvrier());
+    for (auto& t : tranches) t = 0;
+}
+
+PoolClients::~PoolClients() {
+    arreter();
+    for (Ouvrier* o : ouvriers) delete o;
+}
+
+bool PoolClients::demarrer() {
+    enMarche = true;
+    for (size_t i = 0; i < ouvriers.size(); i++)
+        ouvriers[i]->thread = std::thread(&PoolClients::executer, this, (int)i);
+    std::cout << "Pool clients : " << ouvriers.size() << " ouvrier(s), file bornee a " << capacite
+              << (saturation == SATURATION_REFUSER ? " (refus)" : " (retard)") << std::endl;
+    return true;
+}
+
+/**
+ * @brief Reveille tout le monde ; les sessions en cours sont coupees
+ *        (shutdown) pour que les ouvriers rendent la main
+ */
+void PoolClients::arreter() {
+    {
+        std::lock_guard<std::mutex> l(verrouAttente);
+        if (!enMarche.exchange(false)) return;
+    }
+    travail.notify_all();
+    place.notify_all();
+
+    for (Ouvrier* o : ouvriers) {
+        int s = o->socketEnCours.load();
+#ifdef _WIN32
+        if (s >= 0) shutdown(s, SD_BOTH);
+#elif __linux__
+        if (s >= 0) shutdown(s, SHUT_RDWR);
+#endif
+    }
+    for (Ouvrier* o : ouvriers)
+        if (o->thread.joinable()) o->thread.join();
+
+    for (Ouvrier* o : ouvriers) {
+        for (const Tache& t : o->file) fermerSocket(t.socket);
+        o->file.clear();
+    }
+    enFile = 0;
+}
+
+
+bool PoolClients::deposer(int socket) {
+    if (enFile.load() >= capacite) {
+        if (saturation == SATURATION_REFUSER || !enMarche) {
+            nbRefusees++;
+            static const char message[] = "ERROR: Serveur sature\n";
+#ifdef __linux__
+            send(socket, message, sizeof(message) - 1, MSG_NOSIGNAL);
+#else
+            send(socket, message, sizeof(message) - 1, 0);
+#endif
+            fermerSocket(socket);
+            return false;
+        }
+        nbRetardees++;
+        std::unique_lock<std::mutex> l(verrouAttente);
+        place.wait(l, [this] { return enFile.load() < capacite || !enMarche; });
+        if (!enMarche) {
+            fermerSocket(socket);
+            return false;
+        }
+    }
+
+    //! compte avant le depot : un ouvrier ne peut pas prendre une tache non comptee
+    enFile++;
+    nbDeposees++;
+    Ouvrier* o = ouvriers[suivant++ % ouvriers.size()];
+    {
+        std::lock_guard<std::mutex> l(o->verrou);
+        o->file.push_back({socket, Horloge::now()});
+    }
+
+    //! sous le verrou : pas de reveil perdu entre le test et le wait d'un ouvrier
+    { std::lock_guard<std::mutex> l(verrouAttente); }
+    travail.notify_one();
+    return true;
+}
+
+
+/**
+ * @brief Sa propre file par l'avant, sinon vol par l'arriere chez les autres
+ */
+bool PoolClients::prendre(int index, Tache& tache) {
+    Ouvrier* moi = ouvriers[index];
+    {
+        std::lock_guard<std::mutex> l(moi->verrou);
+        if (!moi->file.empty()) {
+            tache = moi->file.front();
+            moi->file.pop_front();
+            return true;
+        }
+    }
+    for (size_t k = 1; k < ouvriers.size(); k++) {
+        Ouvrier* autre = ouvriers[(index + k) % ouvriers.size()];
+        std::lock_guard<std::mutex> l(autre->verrou);
+        if (!autre->file.empty()) {
+            tache = autre->file.back();
+            autre->file.pop_back();
+            nbVolees++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void PoolClients::executer(int index) {
+    Ouvrier* moi = ouvriers[index];
+    Tache tache;
+    while (enMarche) {
+        if (!prendre(index, tache)) {
+            std::unique_lock<std::mutex> l(verrouAttente);
+            travail.wait(l, [this] { return enFile.load() > 0 || !enMarche; });
+            continue;
+        }
+        enFile--;
+        { std::lock_guard<std::mutex> l(verrouAttente); }
+        place.notify_one();
+        mesurerAttente(tache);
+
+        occupes++;
+        moi->socketEnCours = tache.socket;
+        if (!enMarche) {
+            fermerSocket(tache.socket);     //! arreter() est passe avant nous
+        } else {
+            traitement(tache.socket);
+        }
+        moi->socketEnCours = -1;
+        occupes--;
+        if (++nbServies % POOL_PERIODE_RESUME == 0) std::cout << resume() << std::endl;
+    }
+}
+
+
+void PoolClients::mesurerAttente(const Tache& tache) {
+    uint64_t us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(Horloge::now() - tache.depot).count();
+    attenteTotaleUs += us;
+    uint64_t max = attenteMaxUs.load();
+    while (us > max && !attenteMaxUs.compare_exchange_weak(max, us)) {}
+
+    int i = 0;
+    while (i < POOL_NB_TRANCHES - 1 && (us >> (i + 1))) i++;
+    tranches[i]++;
+}
+
+StatistiquesPool PoolClients::statistiques() const {
+    StatistiquesPool s;
+    s.deposees = nbDeposees;
+    s.refusees = nbRefusees;
+    s.retardees = nbRetardees;
+    s.volees = nbVolees;
+    s.servies = nbServies;
+    s.enFile = enFile;
+    s.occupes = occupes;
+
+    uint64_t prises = 0;
+    for (const auto& t : tranches) prises += t;
+    s.attenteMoyenneMs = prises ? attenteTotaleUs / 1000.0 / prises : 0.0;
+    s.attenteMaxMs = attenteMaxUs / 1000.0;
+
+    s.attenteP99Ms = 0.0;
+    uint64_t cumul = 0;
+    for (int i = 0; prises && i < POOL_NB_TRANCHES; i++) {
+        cumul += tranches[i];
+        if (cumul * 100 >= prises * 99) {
+            s.attenteP99Ms = (double)(2ULL << i) / 1000.0;
+            break;
+        }
+    }
+    return s;
+}
+
+std::string PoolClients::resume() const {
+    StatistiquesPool s = statistiques();
+    std::ostringstream os;
+    os << "Pool clients : " << s.deposees << " deposees, " << s.servies << " servies, "
+       << s.refusees << " refusees, " << s.retardees << " retardees, " << s.volees << " volees"
+       << " | en file " << s.enFile << ", ouvriers occupes " << s.occupes << "/" << ouvriers.size()
+       << " | attente moy " << s.attenteMoyenneMs << " ms, p99 < " << s.attenteP99Ms
+       << " ms, max " << s.attenteMaxMs << " ms";
+    return os.str();
+}
@@ -0,0 +1,117 @@
+/**
+ * @file pool_clients.h
+ * @brief Pool borne de threads ouvriers pour les sessions bloquantes ClientConnecte.
+ *
+ * Les threads d'acceptation de ServeurTcp deposent chaque socket acceptee
+ * dans la file d'un ouvrier (tourniquet). Chaque ouvrier sert sa file par l'avant ;
+ * un ouvrier sans travail vole par l'arriere la file d'un autre ouvrier, ce
+ * qui evite qu'une socket attende derriere une longue session alors qu'un
+ * autre ouvrier est libre.
+ *
+ * Le nombre total de sockets en file est borne (capacite). File pleine :
+ * - SATURATION_REFUSER  : la socket recoit "ERROR: Serveur sature" et est fermee
+ * - SATURATION_RETARDER : le thread d'acceptation attend une place ; les
+ *   connexions suivantes patientent dans la file d'ecoute du noyau
+ * Avec plusieurs accepteurs la borne peut etre depassee d'une socket par
+ * accepteur (test puis depot sans verrou commun).
+ *
+ * Metriques : attente en file (depot -> prise par un ouvrier) moyenne, maxi
+ * et p99 (histogramme en puissances de 2 de microsecondes), vols, refus ;
+ * affichees toutes les POOL_PERIODE_RESUME sessions et a l'arret.
+ */
+
+#ifndef POOL_CLIENTS_H
+#define POOL_CLIENTS_H
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+
+#define POOL_CAPACITE_DEFAUT    256
+#define POOL_NB_TRANCHES        32      //! histogramme d'attente : [2^i, 2^(i+1)[ us
+#define POOL_PERIODE_RESUME     1000    //! resume() affiche toutes les N sessions servies
+
+enum SaturationPool {
+    SATURATION_REFUSER,
+    SATURATION_RETARDER
+};
+
+/**
+ * @brief Instantane des metriques du pool
+ */
+struct StatistiquesPool {
+    uint64_t deposees;          //! sockets acceptees dans une file
+    uint64_t refusees;          //! file pleine en SATURATION_REFUSER
+    uint64_t retardees;         //! depots qui ont attendu une place
+    uint64_t volees;            //! prises dans la file d'un autre ouvrier
+    uint64_t servies;           //! sessions terminees
+    size_t   enFile;
+    int      occupes;           //! ouvriers en session
+    double   attenteMoyenneMs;
+    double   attenteP99Ms;      //! borne haute de la tranche du 99e centile
+    double   attenteMaxMs;
+};
+
+class PoolClients {
+public:
+    //! traitement : session complete d'une socket, fermeture comprise
+    PoolClients(int nbOuvriers, size_t capacite, SaturationPool saturation,
+                std::function<void(int)> traitement);
+    ~PoolClients();
+
+    bool demarrer();
+    void arreter();
+
+    //! Threads d'acceptation ; false : socket refusee (deja fermee)
+    bool deposer(int socket);
+
+    StatistiquesPool statistiques() const;
+    std::string resume() const;
+
+private:
+    using Horloge = std::chrono::steady_clock;
+
+    struct Tache {
+        int socket;
+        Horloge::time_point depot;
+    };
+
+    struct Ouvrier {
+        std::mutex verrou;
+        std::deque<Tache> file;
+        std::thread thread;
+        std::atomic<int> socketEnCours{-1};     //! fermee (shutdown) par arreter()
+    };
+
+    std::vector<Ouvrier*> ouvriers;
+    size_t capacite;
+    SaturationPool saturation;
+    std::function<void(int)> traitement;
+    std::atomic<size_t> suivant;                //! tourniquet des threads d'acceptation
+
+    std::atomic<bool> enMarche;
+    std::atomic<size_t> enFile;
+    std::atomic<int> occupes;
+
+    //! Sommeil des ouvriers (travail) et du thread d'acceptation (place)
+    std::mutex verrouAttente;
+    std::condition_variable travail;
+    std::condition_variable place;
+
+    std::atomic<uint64_t> nbDeposees, nbRefusees, nbRetardees, nbVolees, nbServies;
+    std::atomic<uint64_t> attenteTotaleUs, attenteMaxUs;
+    std::atomic<uint64_t> tranches[POOL_NB_TRANCHES];
+
+    void executer(int index);
+    bool prendre(int index, Tache& tache);
+    void mesurerAttente(const Tache& tache);
+};
+
+#endif // POOL_CLIENTS_H
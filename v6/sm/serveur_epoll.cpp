@@ -0,0 +1,289 @@
+/**
+ * @file serveur_epoll.cpp
+ * @brief Code des boucles epoll (voir serveur_epoll.h).
+ */
+
+#ifdef __linux__
+
+#include "serveur_epoll.h"
+
+#include <iostream>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <errno.h>
+
+using namespace std;
+
+
+BoucleEpoll::BoucleEpoll() : epollFd(-1), reveilFd(-1), enMarche(false), nbActives(0) {}
+
+BoucleEpoll::~BoucleEpoll() {
+    arreter();
+}
+
+bool BoucleEpoll::demarrer() {
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    reveilFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || reveilFd < 0) {
+        perror("epoll_create1/eventfd failed");
+        return false;
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.ptr = nullptr;          //! nullptr : le reveil, pas une connexion
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, reveilFd, &ev);
+
+    enMarche = true;
+    thread = std::thread(&BoucleEpoll::boucle, this);
+    return true;
+}
+
+void BoucleEpoll::arreter() {
+    if (!enMarche.exchange(false)) return;
+    uint64_t un = 1;
+    if (write(reveilFd, &un, sizeof(un)) < 0) perror("eventfd write");
+    if (thread.joinable()) thread.join();
+
+    for (ConnexionEpoll* c : connexions) {
+        close(c->socket);
+        delete c;
+    }
+    connexions.clear();
+    for (ConnexionEpoll* c : fermees) delete c;
+    fermees.clear();
+    for (int socket : nouvelles) close(socket);
+    nouvelles.clear();
+    nbActives = 0;
+    close(epollFd);
+    close(reveilFd);
+    epollFd = reveilFd = -1;
+}
+
+
+/**
+ * @brief false : la socket n'est pas (plus) en file, l'appelant la ferme
+ */
+bool BoucleEpoll::ajouter(int socket) {
+    if (!enMarche) return false;
+    {
+        std::lock_guard<std::mutex> l(verrouNouvelles);
+        nouvelles.push_back(socket);
+    }
+    uint64_t un = 1;
+    ssize_t n;
+    do {
+        n = write(reveilFd, &un, sizeof(un));
+    } while (n < 0 && errno == EINTR);
+    if (n == sizeof(un)) return true;
+
+    //! Reveil impossible : on la retire, sauf si un reveil precedent l'a
+    //! deja fait prendre par la boucle (elle lui appartient alors)
+    std::lock_guard<std::mutex> l(verrouNouvelles);
+    for (size_t i = nouvelles.size(); i-- > 0;) {
+        if (nouvelles[i] == socket) {
+            nouvelles.erase(nouvelles.begin() + i);
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/**
+ * @brief Dans le thread de la boucle : etat initial, enregistrement epoll
+ *        et dans la liste d'inactivite
+ */
+void BoucleEpoll::prendreNouvelles() {
+    uint64_t compteur;
+    if (read(reveilFd, &compteur, sizeof(compteur)) < 0 && errno != EAGAIN) perror("eventfd read");
+
+    std::vector<int> aPrendre;
+    {
+        std::lock_guard<std::mutex> l(verrouNouvelles);
+        aPrendre.swap(nouvelles);
+    }
+
+    time_t maintenant = time(nullptr);
+    for (int socket : aPrendre) {
+        ConnexionEpoll* c = new ConnexionEpoll();
+        c->socket = socket;
+        c->derniereActivite = maintenant;
+
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.ptr = c;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, socket, &ev) < 0) {
+            perror("epoll_ctl ADD failed");
+            close(socket);
+            delete c;
+            continue;
+        }
+        c->index = connexions.size();
+        connexions.push_back(c);
+        nbActives++;
+    }
+}
+
+
+void BoucleEpoll::boucle() {
+    epoll_event evts[EPOLL_NB_EVENEMENTS];
+    time_t dernierBalayage = time(nullptr);
+
+    while (enMarche) {
+        //! 1 s maxi : balayage des connexions inactives
+        int n = epoll_wait(epollFd, evts, EPOLL_NB_EVENEMENTS, 1000);
+        if (n < 0 && errno != EINTR) {
+            perror("epoll_wait failed");
+            break;
+        }
+
+        time_t maintenant = time(nullptr);
+        for (int i = 0; i < n; i++) {
+            ConnexionEpoll* c = static_cast<ConnexionEpoll*>(evts[i].data.ptr);
+            if (!c) { prendreNouvelles(); continue; }   //! reveil : sockets confiees ou arret
+            if (c->socket < 0) continue;                //! fermee plus tot dans ce tour
+            c->derniereActivite = maintenant;
+
+            if (evts[i].events & (EPOLLERR | EPOLLHUP)) { fermer(c); continue; }
+            if (evts[i].events & EPOLLOUT) ecrire(c);
+            if (c->socket >= 0 && !c->automate.termine() && (evts[i].events & (EPOLLIN | EPOLLRDHUP))) lire(c);
+        }
+
+        if (maintenant != dernierBalayage) {
+            fermerInactives(maintenant);
+            dernierBalayage = maintenant;
+        }
+
+        for (ConnexionEpoll* c : fermees) delete c;
+        fermees.clear();
+    }
+}
+
+
+/**
+ * @brief Tout ce qui est disponible passe par l'automate, morceau par morceau ;
+ *        ses reponses partent ensuite en un envoi
+ */
+void BoucleEpoll::lire(ConnexionEpoll* c) {
+    char tampon[4096];
+    bool finFlux = false;
+    while (!c->automate.termine() && c->sortie.size() < EPOLL_SORTIE_MAX) {
+        ssize_t n = recv(c->socket, tampon, sizeof(tampon), 0);
+        if (n > 0) { c->automate.alimenter(tampon, n, c->sortie); continue; }
+        if (n == 0) finFlux = true;
+        else if (errno == EINTR) continue;
+        else if (errno != EAGAIN && errno != EWOULDBLOCK) { fermer(c); return; }
+        break;
+    }
+
+    c->automate.acquitter(c->sortie);       //! session multi : entree videe
+
+    //! Fin de flux : le client peut n'avoir ferme que son sens d'envoi
+    //! (shutdown SHUT_WR) et attendre encore ses reponses. Comme LecteurLignes,
+    //! une derniere ligne sans '\n' est traitee ; la connexion est fermee
+    //! une fois la sortie videe (ecrire)
+    if (finFlux && !c->automate.termine()) {
+        if (c->automate.enAttente()) c->automate.alimenter("\n", 1, c->sortie);
+        c->automate.acquitter(c->sortie);
+        c->automate.terminer();
+    }
+    if (!c->sortie.empty()) ecrire(c);
+    else if (c->automate.termine()) fermer(c);
+}
+
+
+/**
+ * @brief Envoi immediat ; ce que le noyau refuse attend EPOLLOUT
+ */
+void BoucleEpoll::ecrire(ConnexionEpoll* c) {
+    bool enAttente = !c->sortie.empty();
+    while (!c->sortie.empty()) {
+        ssize_t n = send(c->socket, c->sortie.data(), c->sortie.size(), MSG_NOSIGNAL);
+        if (n > 0) { c->sortie.erase(0, n); continue; }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        c->sortie.clear();          //! erreur : le client est parti
+        c->automate.terminer();
+        break;
+    }
+
+    //! EPOLLOUT seulement tant qu'il reste des octets a envoyer ; EPOLLIN
+    //! suspendu tant que les reponses en retard depassent EPOLL_SORTIE_MAX,
+    //! et plus du tout une fois la session terminee (seule la sortie compte)
+    if (enAttente) {
+        epoll_event ev{};
+        if (!c->automate.termine()) {
+            ev.events |= EPOLLRDHUP;
+            if (c->sortie.size() < EPOLL_SORTIE_MAX) ev.events |= EPOLLIN;
+        }
+        if (!c->sortie.empty()) ev.events |= EPOLLOUT;
+        ev.data.ptr = c;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, c->socket, &ev);
+    }
+    if (c->automate.termine() && c->sortie.empty()) fermer(c);
+}
+
+
+void BoucleEpoll::fermer(ConnexionEpoll* c) {
+    if (c->socket < 0) return;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, c->socket, nullptr);
+    close(c->socket);
+    c->socket = -1;
+
+    //! Retrait en O(1) : la derniere connexion prend la place liberee
+    ConnexionEpoll* derniere = connexions.back();
+    connexions[c->index] = derniere;
+    derniere->index = c->index;
+    connexions.pop_back();
+    nbActives--;
+    c->automate.terminer();
+    //! les evenements deja lus de ce tour peuvent encore la designer :
+    //! la memoire est rendue en fin de tour
+    fermees.push_back(c);
+}
+
+void BoucleEpoll::fermerInactives(time_t maintenant) {
+    for (size_t i = connexions.size(); i-- > 0;) {
+        ConnexionEpoll* c = connexions[i];
+        if (maintenant - c->derniereActivite >= DELAI_INACTIVITE_S) fermer(c);
+    }
+}
+
+
+ServeurEpoll::ServeurEpoll(int nbThreads) : suivante(0) {
+    if (nbThreads < 1) nbThreads = 1;
+    for (int i = 0; i < nbThreads; i++) boucles.push_back(new BoucleEpoll());
+}
+
+ServeurEpoll::~ServeurEpoll() {
+    arreter();
+    for (BoucleEpoll* b : boucles) delete b;
+}
+
+bool ServeurEpoll::demarrer() {
+    for (BoucleEpoll* b : boucles)
+        if (!b->demarrer()) return false;
+    std::cout << "Serveur epoll : " << boucles.size() << " thread(s) de service" << std::endl;
+    return true;
+}
+
+void ServeurEpoll::arreter() {
+    for (BoucleEpoll* b : boucles) b->arreter();
+}
+
+//! Appele par les threads d'acceptation : tourniquet sans verrou
+bool ServeurEpoll::confier(int socket) {
+    return boucles[suivante++ % boucles.size()]->ajouter(socket);
+}
+
+int ServeurEpoll::nbConnexions() const {
+    int n = 0;
+    for (const BoucleEpoll* b : boucles) n += b->nbConnexions();
+    return n;
+}
+
+#endif // __linux__
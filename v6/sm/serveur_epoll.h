@@ -0,0 +1,105 @@
+/**
+ * @file serveur_epoll.h
+ * @brief Boucles epoll : toutes les sessions clients servies par un nombre fixe de threads (Linux).
+ *
+ * Les threads d'acceptation de ServeurTcp confient chaque socket acceptee,
+ * deja non bloquante (accept4), a une boucle (tourniquet). Chaque boucle possede son instance epoll et ses
+ * connexions : socket non bloquante, automate du protocole (qui garde la
+ * ligne partielle) et tampon d'emission. Aucune connexion n'est partagee
+ * entre threads, donc pas de verrou sur le chemin des messages.
+ *
+ * Chaque recv() alimente directement l'AutomateProtocole de la connexion
+ * (automate_protocole.h, le meme que ClientConnecte) ; sans ServicesProtocole,
+ * seul le protocole badge est servi. Automate termine : fermeture une fois
+ * les reponses envoyees. Une connexion muette plus de DELAI_INACTIVITE_S
+ * secondes est fermee.
+ */
+
+#ifndef SERVEUR_EPOLL_H
+#define SERVEUR_EPOLL_H
+
+#ifdef __linux__
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <ctime>
+
+#include "automate_protocole.h"
+
+#define EPOLL_NB_EVENEMENTS     64
+#define DELAI_INACTIVITE_S      30
+#define EPOLL_SORTIE_MAX        65536    //! au-dela : plus de lecture tant que le client ne lit pas
+
+/**
+ * @brief Etat d'une connexion servie par une boucle
+ */
+struct ConnexionEpoll {
+    int socket;
+    AutomateProtocole automate;
+    std::string sortie;         //! reponses pas encore acceptees par le noyau
+    time_t derniereActivite;
+    size_t index;               //! place dans BoucleEpoll::connexions (retrait en O(1))
+};
+
+/**
+ * @brief Un thread, une instance epoll, ses connexions
+ */
+class BoucleEpoll {
+public:
+    BoucleEpoll();
+    ~BoucleEpoll();
+
+    bool demarrer();
+    void arreter();
+
+    //! Appelable depuis les threads d'acceptation : la boucle enregistre la socket a son reveil
+    bool ajouter(int socket);
+
+    int nbConnexions() const { return nbActives.load(); }
+
+private:
+    int epollFd;
+    int reveilFd;               //! eventfd : sortie de epoll_wait pour arreter()
+    std::thread thread;
+    std::atomic<bool> enMarche;
+    std::atomic<int> nbActives;
+    std::vector<ConnexionEpoll*> connexions;   //! proprietes du thread de la boucle
+    std::vector<ConnexionEpoll*> fermees;      //! rendues en fin de tour d'epoll_wait
+
+    //! Sockets confiees par les threads d'acceptation, prises en charge au reveil
+    std::mutex verrouNouvelles;
+    std::vector<int> nouvelles;
+
+    void boucle();
+    void prendreNouvelles();
+    void lire(ConnexionEpoll* c);
+    void ecrire(ConnexionEpoll* c);
+    void fermer(ConnexionEpoll* c);
+    void fermerInactives(time_t maintenant);
+};
+
+/**
+ * @brief Les boucles d'un serveur et la repartition des connexions
+ */
+class ServeurEpoll {
+public:
+    explicit ServeurEpoll(int nbThreads);
+    ~ServeurEpoll();
+
+    bool demarrer();
+    void arreter();
+    bool confier(int socket);
+
+    int nbConnexions() const;
+
+private:
+    std::vector<BoucleEpoll*> boucles;
+    std::atomic<size_t> suivante;
+};
+
+#endif // __linux__
+
+#endif // SERVEUR_EPOLL_H
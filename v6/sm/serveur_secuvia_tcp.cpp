@@ -7,19 +7,24 @@
  * - __linux__: Défini sur les systèmes Linux.
  *
  * Commande de compilation (exemple Linux):
- * g++ -o serveur_secuvia serveur_secuvia_tcp.cpp serveur_tcp.cpp client_connecte.cpp fichier_log.cpp predictive_ia.cpp serveur_dao.cpp  -pthread -lmysqlclient
+ * g++ -o serveur_secuvia serveur_secuvia_tcp.cpp serveur_tcp.cpp serveur_epoll.cpp pool_clients.cpp client_connecte.cpp lecteur_lignes.cpp automate_protocole.cpp fichier_log.cpp predictive_ia.cpp serveur_dao.cpp  -pthread -lmysqlclient
  *
  * Commande de compilation (exemple Windows, nécessite configuration du connecteur MySQL C++):
  *
 
- g++ -o serveur_secuvia serveur_secuvia_tcp.cpp serveur_tcp.cpp client_connecte.cpp fichier_log.cpp predictive_ia.cpp serveur_dao.cpp -I"C:\path\to\mysql\connector\include" -L"C:\path\to\mysql\connector\lib" -lmysqlcppconn -lws2_32 -pthread -std=c++14
+ g++ -o serveur_secuvia serveur_secuvia_tcp.cpp serveur_tcp.cpp pool_clients.cpp client_connecte.cpp lecteur_lignes.cpp automate_protocole.cpp fichier_log.cpp predictive_ia.cpp serveur_dao.cpp -I"C:\path\to\mysql\connector\include" -L"C:\path\to\mysql\connector\lib" -lmysqlcppconn -lws2_32 -pthread -std=c++17
 
  !!! sans mysql mais avec serveur_dao vide
- g++ serveur_secuvia_tcp.cpp serveur_tcp.cpp client_connecte.cpp fichier_log.cpp predictive_ia.cpp  serveur_dao.cpp -lws2_32 -pthread        -o serveur_secuvia
+ g++ serveur_secuvia_tcp.cpp serveur_tcp.cpp pool_clients.cpp client_connecte.cpp lecteur_lignes.cpp automate_protocole.cpp fichier_log.cpp predictive_ia.cpp  serveur_dao.cpp -lws2_32 -pthread        -o serveur_secuvia
 
  *
  * Commande d'exécution (Linux et Windows):
- * ./serveur_secuvia
+ * ./serveur_secuvia ip port [threads | epoll [nbThreads] | pool [nbThreads [capacite [refuser|retarder]]]]
+ *   threads : un thread par client (defaut) ; epoll : nbThreads boucles epoll (Linux, defaut 1)
+ *   pool : nbThreads ouvriers (defaut 8), file bornee a capacite sockets (defaut 256),
+ *          file pleine : refuser la connexion ou retarder l'acceptation (defaut)
+ * options apres le modele : accepteurs N (sockets SO_REUSEPORT, Linux), backlog B (listen)
+ *   ex : ./serveur_secuvia 0.0.0.0 8080 epoll 2 accepteurs 2 backlog 4096
  */
 
 #include "serveur_tcp.h"
@@ -42,6 +47,9 @@ int main (int argc, char *argv[]) {
 
         std::cout << "\tex : serveur_secuvia 192.168.43.205 8080" << std::endl;
         std::cout << "\tou : serveur_secuvia 192.168.43.43 8080" << std::endl;
+        std::cout << "\tou : serveur_secuvia 0.0.0.0 8080 epoll 4" << std::endl;
+        std::cout << "\tou : serveur_secuvia 0.0.0.0 8080 pool 8 256 refuser" << std::endl;
+        std::cout << "\tou : serveur_secuvia 0.0.0.0 8080 epoll 2 accepteurs 2 backlog 4096" << std::endl;
         std::cout << "\n\n";
 		return -2;
 	}
@@ -71,6 +79,48 @@ int main (int argc, char *argv[]) {
     std::istringstream istrPort (chaineTempPort);
     istrPort >> port;
 
+    //! modele de service (optionnel) : arguments jusqu'a la premiere option d'acceptation
+    int finModele = 3;
+    while (finModele < argc && std::string(argv[finModele]) != "accepteurs" && std::string(argv[finModele]) != "backlog") finModele++;
+
+    if (finModele >= 4 && std::string(argv[3]) == "epoll") {
+        int nbThreads = 1;
+        if (finModele >= 5) {
+            std::string chaineTempThreads = std::string(argv[4]);
+            std::istringstream istrThreads (chaineTempThreads);
+            istrThreads >> nbThreads;
+        }
+        if (!serveur.setMode(MODE_EPOLL, nbThreads)) return 1;
+    }
+    else if (finModele >= 4 && std::string(argv[3]) == "pool") {
+        int nbThreads = 8;
+        size_t capacite = POOL_CAPACITE_DEFAUT;
+        if (finModele >= 5) {
+            std::string chaineTempThreads = std::string(argv[4]);
+            std::istringstream istrThreads (chaineTempThreads);
+            istrThreads >> nbThreads;
+        }
+        if (finModele >= 6) {
+            std::string chaineTempCapacite = std::string(argv[5]);
+            std::istringstream istrCapacite (chaineTempCapacite);
+            istrCapacite >> capacite;
+        }
+        SaturationPool saturation = (finModele >= 7 && std::string(argv[6]) == "refuser") ? SATURATION_REFUSER : SATURATION_RETARDER;
+        if (!serveur.setMode(MODE_POOL, nbThreads) || !serveur.setFile(capacite, saturation)) return 1;
+    }
+
+    //! acceptation (optionnel, apres le modele) : accepteurs N, backlog B
+    int nbAccepteurs = 1;
+    int backlog = SOMAXCONN;
+    for (int i = finModele; i + 1 < argc; i++) {
+        std::string option = std::string(argv[i]);
+        std::string chaineTempValeur = std::string(argv[i + 1]);
+        std::istringstream istrValeur (chaineTempValeur);
+        if (option == "accepteurs") istrValeur >> nbAccepteurs;
+        else if (option == "backlog") istrValeur >> backlog;
+    }
+    if (!serveur.setAcceptation(nbAccepteurs, backlog)) return 1;
+
 
     if (serveur.start(ip, port)) {
         std::cout << "Serveur démarré avec succès. Appuyez sur une touche pour arrêter..." << std::endl;
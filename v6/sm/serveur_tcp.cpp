@@ -1,5 +1,6 @@
 #include "serveur_tcp.h"
 #include "client_connecte.h"
+#include "serveur_epoll.h"
 #include <iostream>
 #include <thread>
 
@@ -13,17 +14,53 @@ using namespace std::chrono_literals;
 #elif __linux__
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <unistd.h>
 #include <arpa/inet.h>
 #include <errno.h>
 #endif
 
-ServeurTcp::ServeurTcp() : serverSocket(-1), isListening(false) {}
+ServeurTcp::ServeurTcp() : serverSocket(-1), isListening(false),
+    mode(MODE_THREAD_PAR_CLIENT), nbThreads(1), serveurEpoll(nullptr),
+    capaciteFile(POOL_CAPACITE_DEFAUT), saturation(SATURATION_RETARDER), pool(nullptr),
+    nbAccepteurs(1), backlog(SOMAXCONN) {}
 
 ServeurTcp::~ServeurTcp() {
     stop();
 }
 
+bool ServeurTcp::setMode(ModeServeur mode, int nbThreads) {
+#ifndef __linux__
+    if (mode == MODE_EPOLL) {
+        std::cerr << "MODE_EPOLL disponible sous Linux seulement" << std::endl;
+        return false;
+    }
+#endif
+    this->mode = mode;
+    this->nbThreads = (nbThreads < 1) ? 1 : nbThreads;
+    return true;
+}
+
+bool ServeurTcp::setFile(size_t capacite, SaturationPool saturation) {
+    if (capacite == 0) return false;
+    this->capaciteFile = capacite;
+    this->saturation = saturation;
+    return true;
+}
+
+bool ServeurTcp::setAcceptation(int nbAccepteurs, int backlog) {
+#ifndef __linux__
+    if (nbAccepteurs > 1) {
+        std::cerr << "Plusieurs accepteurs (SO_REUSEPORT) : Linux seulement" << std::endl;
+        return false;
+    }
+#endif
+    if (nbAccepteurs < 1 || backlog < 1) return false;
+    this->nbAccepteurs = nbAccepteurs;
+    this->backlog = backlog;
+    return true;
+}
+
 bool ServeurTcp::start (std::string ip, int port) {
     this->ip = ip;
     this->port = port;
@@ -76,6 +113,16 @@ bool ServeurTcp::start (std::string ip, int port) {
    
 
     std::cout << "bind sur [" <<serverAddr.sin_addr.s_addr<<":" << serverAddr.sin_port << "]" << std::endl;
+
+#ifdef __linux__
+    //! Plusieurs accepteurs : chaque socket d'ecoute partage le port
+    int un = 1;
+    if (nbAccepteurs > 1 && setsockopt(serverSocket, SOL_SOCKET, SO_REUSEPORT, &un, sizeof(un)) < 0) {
+        perror("SO_REUSEPORT failed");
+        close(serverSocket);
+        return false;
+    }
+#endif
      
     if (bind(serverSocket, (struct sockaddr*)&serverAddr, sizeof(serverAddr))
 #ifdef _WIN32
@@ -95,7 +142,7 @@ bool ServeurTcp::start (std::string ip, int port) {
         return false;
     }
 
-    if (listen(serverSocket, SOMAXCONN)
+    if (listen(serverSocket, backlog)
 #ifdef _WIN32
         == SOCKET_ERROR
 #elif __linux__
@@ -113,54 +160,38 @@ bool ServeurTcp::start (std::string ip, int port) {
         return false;
     }
 
-    std::cout << "Serveur TCP ["<< ip << ":" << port << "] en ecoute..." << std::endl;
+    std::cout << "Serveur TCP ["<< ip << ":" << port << "] en ecoute (backlog " << backlog << ", "
+              << nbAccepteurs << " accepteur(s))..." << std::endl;
     isListening = true;
 
-    while (isListening) {
-        int clientSocket = acceptClient();
-        if (clientSocket
-#ifdef _WIN32
-            != INVALID_SOCKET
-#elif __linux__
-            >= 0
-#endif
-        ) {
-
-
-          // cg AVEC thread
-#ifdef _WIN32
-            //std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-
-
-            std::thread clientThread(&ServeurTcp::handleClientConnection, this, clientSocket);
-            clientThread.detach(); // Lancer le client dans un thread séparé
-
-            //handleClientConnection (clientSocket);
-#elif __linux__
-            std::thread clientThread(&ServeurTcp::handleClientConnection, this, clientSocket);
-            clientThread.detach(); // Lancer le client dans un thread séparé
+#ifdef __linux__
+    if (mode == MODE_EPOLL) {
+        serveurEpoll = new ServeurEpoll(nbThreads);
+        if (!serveurEpoll->demarrer()) {
+            stop();
+            return false;
+        }
+    }
 #endif
-            
-            // cg sans thread
-            // OK handleClientConnection (clientSocket);
-            
+    if (mode == MODE_POOL) {
+        pool = new PoolClients(nbThreads, capaciteFile, saturation,
+                               [this](int clientSocket) { handleClientConnection(clientSocket); });
+        pool->demarrer();
+    }
 
-#ifdef _WIN32
-            //std::this_thread::sleep_for(std::chrono::milliseconds(x));
-            //std::this_thread::sleep_for(1000);
-#elif __linux__
-            long x = 1000; usleep(x); // delai x
-#endif
-            
-        } else {
-#ifdef _WIN32
-            std::cerr << "accept failed with error: " << WSAGetLastError() << std::endl;
-#elif __linux__
-            perror("accept failed");
-#endif
-            // Peut-être ajouter une pause ou une logique de réessai ici
+#ifdef __linux__
+    for (int i = 1; i < nbAccepteurs; i++) {
+        int socketEcoute = ouvrirEcouteSupplementaire(serverAddr);
+        if (socketEcoute < 0) {
+            stop();
+            return false;
         }
+        ecoutesSupplementaires.push_back(socketEcoute);
+        accepteurs.emplace_back(&ServeurTcp::boucleAcceptation, this, socketEcoute);
     }
+#endif
+
+    boucleAcceptation(serverSocket);
 
 #ifdef _WIN32
     WSACleanup();
@@ -170,6 +201,33 @@ bool ServeurTcp::start (std::string ip, int port) {
 
 bool ServeurTcp::stop() {
     isListening = false;
+
+    //! Plus d'acceptation avant de retirer les boucles et le pool
+#ifdef __linux__
+    for (int socketEcoute : ecoutesSupplementaires) shutdown(socketEcoute, SHUT_RDWR);
+    if (serverSocket >= 0) shutdown(serverSocket, SHUT_RDWR);
+#endif
+    for (std::thread& t : accepteurs)
+        if (t.joinable() && t.get_id() != std::this_thread::get_id()) t.join();
+    accepteurs.clear();
+#ifdef __linux__
+    for (int socketEcoute : ecoutesSupplementaires) close(socketEcoute);
+    ecoutesSupplementaires.clear();
+#endif
+
+#ifdef __linux__
+    if (serveurEpoll) {
+        serveurEpoll->arreter();
+        delete serveurEpoll;
+        serveurEpoll = nullptr;
+    }
+#endif
+    if (pool) {
+        pool->arreter();
+        std::cout << pool->resume() << std::endl;
+        delete pool;
+        pool = nullptr;
+    }
 #ifdef _WIN32
     if (serverSocket != INVALID_SOCKET) {
         closesocket(serverSocket);
@@ -186,15 +244,95 @@ bool ServeurTcp::stop() {
     return true;
 }
 
+/**
+ * @brief Accepte et confie les clients jusqu'a stop() ; un appel par accepteur
+ */
+#ifdef _WIN32
+void ServeurTcp::boucleAcceptation(SOCKET socketEcoute) {
+#elif __linux__
+void ServeurTcp::boucleAcceptation(int socketEcoute) {
+#endif
+    while (isListening) {
+        int clientSocket = acceptClient(socketEcoute);
+        if (clientSocket
+#ifdef _WIN32
+            != INVALID_SOCKET
+#elif __linux__
+            >= 0
+#endif
+        ) {
+            confierClient(clientSocket);
+        } else {
+            if (!isListening) break;
+#ifdef _WIN32
+            std::cerr << "accept failed with error: " << WSAGetLastError() << std::endl;
+#elif __linux__
+            //! Client parti avant l'acceptation : rien a signaler
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            perror("accept failed");
+            //! Plus de descripteurs : laisser les sessions en cours en rendre
+            if (errno == EMFILE || errno == ENFILE) usleep(10000);
+#endif
+        }
+    }
+}
+
+void ServeurTcp::confierClient(int clientSocket) {
+#ifdef __linux__
+    //! Boucles epoll : pas de thread par client
+    if (serveurEpoll) {
+        if (!serveurEpoll->confier(clientSocket)) close(clientSocket);
+        return;
+    }
+#endif
+    //! Pool borne : la file absorbe, refuse ou fait attendre l'acceptation
+    if (pool) {
+        pool->deposer(clientSocket);
+        return;
+    }
+
+    std::thread clientThread(&ServeurTcp::handleClientConnection, this, clientSocket);
+    clientThread.detach(); // Lancer le client dans un thread séparé
+}
+
 #ifdef _WIN32
-SOCKET ServeurTcp::acceptClient() {
-    return accept(serverSocket, nullptr, nullptr);
+SOCKET ServeurTcp::acceptClient(SOCKET socketEcoute) {
+    return accept(socketEcoute, nullptr, nullptr);
 }
 #elif __linux__
-int ServeurTcp::acceptClient() {
+/**
+ * @brief accept4 : CLOEXEC sans appel de plus ; non bloquante d'emblee pour
+ *        les boucles epoll, bloquante pour les sessions ClientConnecte.
+ *        TCP_NODELAY : les reponses sont deja regroupees par envoi, Nagle ne
+ *        ferait que retenir le deuxieme acquit d'une rafale jusqu'a l'ACK retarde
+ */
+int ServeurTcp::acceptClient(int socketEcoute) {
     sockaddr_in clientAddr;
     socklen_t clientAddrLen = sizeof(clientAddr);
-    return accept(serverSocket, (struct sockaddr*)&clientAddr, &clientAddrLen);
+    int drapeaux = SOCK_CLOEXEC | (serveurEpoll ? SOCK_NONBLOCK : 0);
+    int clientSocket = accept4(socketEcoute, (struct sockaddr*)&clientAddr, &clientAddrLen, drapeaux);
+    if (clientSocket >= 0) {
+        int un = 1;
+        setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, &un, sizeof(un));
+    }
+    return clientSocket;
+}
+
+int ServeurTcp::ouvrirEcouteSupplementaire(const sockaddr_in& adresse) {
+    int socketEcoute = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socketEcoute < 0) {
+        perror("socket creation failed");
+        return -1;
+    }
+    int un = 1;
+    if (setsockopt(socketEcoute, SOL_SOCKET, SO_REUSEPORT, &un, sizeof(un)) < 0
+        || bind(socketEcoute, (const struct sockaddr*)&adresse, sizeof(adresse)) < 0
+        || listen(socketEcoute, backlog) < 0) {
+        perror("ecoute SO_REUSEPORT failed");
+        close(socketEcoute);
+        return -1;
+    }
+    return socketEcoute;
 }
 #endif
 
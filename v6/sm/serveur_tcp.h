@@ -8,11 +8,23 @@
  * - _WIN32: Défini sur les systèmes Windows.
  * - __linux__: Défini sur les systèmes Linux.
  *
+ * Modeles de service des clients (setMode) :
+ * - MODE_THREAD_PAR_CLIENT : un thread detache par connexion, ClientConnecte bloquant (defaut)
+ * - MODE_EPOLL (Linux) : nbThreads boucles epoll servent toutes les connexions (serveur_epoll.h)
+ * - MODE_POOL : nbThreads ouvriers servent les ClientConnecte bloquants depuis
+ *   des files bornees avec vol de travail (pool_clients.h, setFile)
+ *
+ * Acceptation (setAcceptation) : file d'ecoute du noyau (backlog de listen)
+ * et nombre de threads d'acceptation. Sous Linux, accept4() rend des sockets
+ * SOCK_CLOEXEC (et SOCK_NONBLOCK pour les boucles epoll) ; avec plusieurs
+ * accepteurs, chacun a sa socket d'ecoute SO_REUSEPORT sur le meme port et
+ * le noyau repartit les connexions entrantes.
+ *
  * Commande de compilation (exemple Linux):
- * g++ -o serveur_secuvia serveur_secuvia_linux.cpp serveur_tcp.cpp client_connecte.cpp fichier_log.cpp predictive_ia.cpp serveur_dao.cpp -lmysqlclient
+ * g++ -o serveur_secuvia serveur_secuvia_linux.cpp serveur_tcp.cpp serveur_epoll.cpp pool_clients.cpp client_connecte.cpp lecteur_lignes.cpp automate_protocole.cpp fichier_log.cpp predictive_ia.cpp serveur_dao.cpp -lmysqlclient
  *
  * Commande de compilation (exemple Windows, nécessite configuration du connecteur MySQL C++):
- * g++ -o serveur_secuvia serveur_secuvia_linux.cpp serveur_tcp.cpp client_connecte.cpp fichier_log.cpp predictive_ia.cpp serveur_dao.cpp -I"C:\path\to\mysql\connector\include" -L"C:\path\to\mysql\connector\lib" -lmysqlcppconn
+ * g++ -o serveur_secuvia serveur_secuvia_linux.cpp serveur_tcp.cpp pool_clients.cpp client_connecte.cpp lecteur_lignes.cpp automate_protocole.cpp fichier_log.cpp predictive_ia.cpp serveur_dao.cpp -I"C:\path\to\mysql\connector\include" -L"C:\path\to\mysql\connector\lib" -lmysqlcppconn
  *
  * Commande d'exécution (Linux et Windows):
  * ./serveur_secuvia
@@ -24,6 +36,10 @@
 #include <string>
 #include <cstring>
 #include <functional>
+#include <atomic>
+#include <vector>
+#include <thread>
+#include "pool_clients.h"
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -37,6 +53,13 @@
 #include <errno.h>
 #endif
 
+class ServeurEpoll;
+
+enum ModeServeur {
+    MODE_THREAD_PAR_CLIENT,
+    MODE_EPOLL,
+    MODE_POOL
+};
 
 class ServeurTcp {
 private:
@@ -45,7 +68,7 @@ private:
 #elif __linux__
     int serverSocket;
 #endif
-    bool isListening;
+    std::atomic<bool> isListening;
 
 public:
     ServeurTcp();
@@ -53,15 +76,36 @@ public:
     bool start (std::string ip, int port);
     bool stop();
 
+    //! A appeler avant start() ; nbThreads : boucles epoll (MODE_EPOLL) ou ouvriers (MODE_POOL)
+    bool setMode(ModeServeur mode, int nbThreads = 1);
+    //! MODE_POOL : sockets en attente d'un ouvrier au plus, et conduite quand la file est pleine
+    bool setFile(size_t capacite, SaturationPool saturation);
+    //! Backlog de listen() et threads d'acceptation (plusieurs : SO_REUSEPORT, Linux)
+    bool setAcceptation(int nbAccepteurs, int backlog = SOMAXCONN);
+
 private:
     std::string ip;
     int port;
+    ModeServeur mode;
+    int nbThreads;
+    ServeurEpoll* serveurEpoll;
+    size_t capaciteFile;
+    SaturationPool saturation;
+    PoolClients* pool;
+    int nbAccepteurs;
+    int backlog;
+    std::vector<int> ecoutesSupplementaires;   //! une par accepteur au-dela du premier
+    std::vector<std::thread> accepteurs;
 
 #ifdef _WIN32
-    SOCKET acceptClient();
+    SOCKET acceptClient(SOCKET socketEcoute);
+    void boucleAcceptation(SOCKET socketEcoute);
 #elif __linux__
-    int acceptClient();
+    int acceptClient(int socketEcoute);
+    void boucleAcceptation(int socketEcoute);
+    int ouvrirEcouteSupplementaire(const sockaddr_in& adresse);
 #endif
+    void confierClient(int clientSocket);
     void handleClientConnection(int clientSocket);
     // Vous pourriez utiliser une std::function pour rendre le traitement du client configurable
     std::function<void(int)> clientHandler;